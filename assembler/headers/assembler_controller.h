@@ -1,5 +1,7 @@
 #ifndef ASSEMBLER_CONTROLLER_H
 #define ASSEMBLER_CONTROLLER_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include "../../structures/headers/workspace.h"
 /* ----------------------------------- Functions Prototypes ------------------------------------*/
 /**
  * Controller function to handle the execution of the assembler program.
@@ -8,9 +10,26 @@
  * It first preprocesses the files to handle macros, and then proceeds with the main processing phases.
  * If any errors occur during processing, appropriate messages are displayed and processing may halt
  * depending on the severity of the error.
+ * With the option '--serve [socket | -]', the process becomes a server that assembles the
+ * requests of clients instead (see `run_server`).
  *
  * @param argc The number of command line arguments.
  * @param argv The array of command line arguments.
  */
 void controller(int argc, char* argv[]);
+
+/**
+ * Assembles the files of a command line in the specified workspace, the same as `controller`,
+ * with the messages printed to the output stream of the workspace. The files are assembled one
+ * after the other - the option '-j' is accepted and ignored, as the printed messages are the same.
+ * A batch of a manifest or a directory ends with its totals, as with `controller`.
+ * The workspace is left reset, for the next command line.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The array of command line arguments - the first one is the program name.
+ * @param workspace The workspace to assemble the files in.
+ * @return FATAL_ERROR if the assembly was stopped by a fatal error, ERROR_IN_FILE if the command
+ *         line is invalid or its batch cannot be read, ERROR_FREE_FILE otherwise.
+ */
+Status assemble_command_line(int argc, char* argv[], AsmWorkspace *workspace);
 #endif /* ASSEMBLER_CONTROLLER_H */
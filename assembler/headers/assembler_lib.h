@@ -0,0 +1,72 @@
+#ifndef ASSEMBLER_LIB_H
+#define ASSEMBLER_LIB_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include <stddef.h>
+#include "../../structures/headers/errors.h"
+#include "../../structures/headers/stats.h"
+#include "../../structures/headers/workspace.h"
+/* ---------------------------------------- Structures ----------------------------------------*/
+/*
+ * AsmBuffer struct
+ * Represents the content of one output of the assembler in memory.
+ * If the matching file would not have been created by the command line assembler,
+ * the data pointer is NULL and the size is 0.
+ */
+typedef struct AsmBuffer {
+    char *data;  /* The content, terminated by '\0' */
+    size_t size; /* The size of the content in bytes, without the terminating '\0' */
+} AsmBuffer;
+
+/*
+ * AsmOutput struct
+ * Holds all the outputs of assembling a single source buffer.
+ */
+typedef struct AsmOutput {
+    AsmBuffer object;      /* The content of the object file (.ob) */
+    AsmBuffer entries;     /* The content of the entry file (.ent) */
+    AsmBuffer externals;   /* The content of the extern file (.ext) */
+    AsmBuffer diagnostics; /* The errors, warnings and summary that the command line prints */
+    Status status;         /* The final status of the assembly process */
+    AsmStats stats;        /* Times and counters of the assembly - bytes_written counts the buffers */
+} AsmOutput;
+
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Assembles a source buffer entirely in memory - the source is read from the buffer, and the
+ * object, entry and extern contents are returned as buffers, together with the diagnostics.
+ * No file is read or written. The outputs are identical to the files and messages that the
+ * command line assembler produces for a file with the same content.
+ *
+ * @param name The base name of the source, used in the diagnostics (as "<name>.as").
+ * @param source The content of the source (.as).
+ * @param size The size of the source in bytes.
+ * @param output Pointer to the structure that receives the outputs. Must be released with
+ *               `free_asm_output`, whatever the returned status is.
+ * @return The final status of the assembly process.
+ */
+Status assemble_buffer(const char *name, const char *source, size_t size, AsmOutput *output);
+
+/**
+ * Assembles a source buffer in memory, the same as `assemble_buffer`, in the specified
+ * workspace. The workspace is reset at the end, so a caller that assembles many sources
+ * keeps its arenas, tables and buffers warm between them.
+ *
+ * @param workspace The workspace to assemble the source in. Its memory size limits the program.
+ * @param name The base name of the source, used in the diagnostics (as "<name>.as").
+ * @param source The content of the source (.as).
+ * @param size The size of the source in bytes.
+ * @param output Pointer to the structure that receives the outputs. Must be released with
+ *               `free_asm_output`, whatever the returned status is.
+ * @return The final status of the assembly process.
+ */
+Status assemble_buffer_in(AsmWorkspace *workspace, const char *name, const char *source, size_t size,
+                          AsmOutput *output);
+
+/**
+ * Frees the buffers of the specified output and resets them to empty buffers.
+ *
+ * @param output Pointer to the output to be freed.
+ */
+void free_asm_output(AsmOutput *output);
+
+#endif /* ASSEMBLER_LIB_H */
@@ -0,0 +1,58 @@
+#ifndef BUILD_CACHE_H
+#define BUILD_CACHE_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include <stddef.h>
+#include "../../structures/headers/context.h"
+#include "../../utils/headers/content_hash.h"
+#include "../../utils/headers/source_file.h"
+/* ----------------------------------------- Defines ------------------------------------------*/
+/* Length of the key of a file in the build cache, including the null-terminator */
+#define CACHE_KEY_LENGTH CONTENT_HASH_LENGTH
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Calculates the key of a file in the build cache - a hash of the content of its source (.as),
+ * its base name (which the messages mention), the options that change its outputs and the
+ * version of the assembler. The key is calculated from the content that is assembled, so the
+ * source is read once for both.
+ *
+ * @param file_name The base name of the file without extension.
+ * @param source The content of the source file, as it is assembled.
+ * @param options The command line options.
+ * @param key Buffer to store the key.
+ * @return TRUE if the key was calculated, FALSE if memory allocation failed.
+ */
+Boolean cache_key(const char *file_name, const SourceFile *source, const AsmOptions *options,
+                  char key[CACHE_KEY_LENGTH]);
+
+/**
+ * Restores the outputs of a file from the build cache, instead of assembling it. The output files
+ * are written, the messages are printed to the output stream of the context, and the status and
+ * counters of the context are set as the assembly would set them.
+ *
+ * @param ctx The context of the file's assembly process.
+ * @param cache_dir The directory of the build cache.
+ * @param key The key of the file.
+ * @param file_name The base name of the file without extension.
+ * @return TRUE if the outputs were restored, FALSE if the cache has no valid entry for the key,
+ *         or an output file cannot be written (nothing is printed then).
+ */
+Boolean restore_cache_entry(AsmContext *ctx, const char *cache_dir, const char *key, const char *file_name);
+
+/**
+ * Keeps the outputs of an assembled file in the build cache - its status and counters, the
+ * printed messages and the content of the specified output files. The entry is written to a
+ * temporary file and renamed, so a reader never sees a partial entry. Failures are ignored,
+ * the file is only assembled again the next time.
+ *
+ * @param ctx The context of the file's assembly process, at the end of the assembly.
+ * @param cache_dir The directory of the build cache, created if it does not exist.
+ * @param key The key of the file.
+ * @param file_name The base name of the file without extension.
+ * @param messages The messages that were printed for the file.
+ * @param size The size of the messages in bytes.
+ * @param extensions The extensions of the output files that the assembly created, terminated by NULL.
+ */
+void store_cache_entry(const AsmContext *ctx, const char *cache_dir, const char *key, const char *file_name,
+                       const char *messages, size_t size, const char *extensions[]);
+
+#endif /* BUILD_CACHE_H */
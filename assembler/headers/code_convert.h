@@ -4,10 +4,21 @@
 #include "../../structures/headers/cmp_data.h"
 #include "../../structures/headers/ast.h"
 /* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Checks if an integer value can be written to the field between the start and end positions
+ * of a word (two's complement).
+ *
+ * @param start The starting bit position.
+ * @param end The ending bit position.
+ * @param value The integer value.
+ * @return TRUE if the value fits the field, FALSE otherwise.
+ */
+Boolean fits_int_code(int start, int end, int value);
+
 /**
  * Sets multiple bits in the memory image based on the given integer value.
- * The Function converts the given integer in base 10 to base 2 and writes the bits
- * in the memory image.
+ * The value is written to the field between the start and end positions with a single
+ * shift and mask.
  *
  * @param start The starting bit position.
  * @param end The ending bit position.
@@ -26,28 +37,32 @@ Boolean set_int_code(int start, int end, int value, MemoryImage *memory_img, Mem
 void set_bit(int i, int value, MemoryImage *memory_img, MemoryImageType image_type);
 
 /**
- * Converts a 15-bit word to an unsigned integer in octal representation.
+ * Converts a 15-bit word to an unsigned integer, for printing in octal representation.
  *
  * @param word The 15-bit word to convert.
- * @return The octal representation of the word as an unsigned integer.
+ * @return The value of the word as an unsigned integer.
  */
-unsigned int convert_to_octal(const char *word);
+unsigned int convert_to_octal(Word word);
+
 /**
- * Encodes an immediate address mode value into the memory image.
+ * Encodes an immediate address mode value into the memory image. The value is checked by the
+ * first phase before it is encoded.
  *
  * @param num The immediate value to encode.
  * @param memory_img Pointer to the memory image structure.
  */
-void code_immediate_addr_mode(int num, MemoryImage *memory_img, ASTNode *node);
+void code_immediate_addr_mode(int num, MemoryImage *memory_img);
 
 /**
  * Encodes a direct address mode value into the memory image.
  *
- * @param label The label to encode.
+ * @param ctx The context of the assembly process.
+ * @param label_id The ID of the label to encode.
  * @param cmp_data Pointer to the compilation data structure.
- * @return TRUE if the label was successfully encoded, FALSE otherwise.
+ * @return NO_ERROR if the label was successfully encoded, UNRECOGNIZED_LABEL if it is not defined,
+ *         or LABEL_ADDRESS_OUT_OF_RANGE if its address does not fit the operand word.
  */
-Boolean code_direct_addr_mode(const char *label, CmpData *cmp_data);
+ErrorCode code_direct_addr_mode(AsmContext *ctx, int label_id, CmpData *cmp_data);
 
 /**
  * Encodes a register address mode value into the memory image.
@@ -58,7 +73,8 @@ Boolean code_direct_addr_mode(const char *label, CmpData *cmp_data);
  */
 void code_register_addr_mode(int reg_num, MemoryImage *memory_img, int position);
 /**
- * Encodes a character into the memory image as its ASCII value.
+ * Encodes a character into the memory image as its ASCII value, and moves the data writing
+ * position to the next word.
  *
  * @param c The character to encode.
  * @param memory_img Pointer to the memory image structure.
@@ -66,47 +82,20 @@ void code_register_addr_mode(int reg_num, MemoryImage *memory_img, int position)
 void set_char_code(char c, MemoryImage *memory_img);
 
 /**
- * Encodes a list of data operands into the memory image.
+ * Encodes a list of data operands into the memory image, from the data writing position on.
+ * The operands are checked by the first phase before they are encoded.
  *
  * @param node The AST node containing the data operands.
  * @param memory_image Pointer to the memory image structure.
  */
-void code_data(ASTNode *node, MemoryImage *memory_image);
+void code_data(const ASTNode *node, MemoryImage *memory_image);
 
 /**
- * Encodes a string operand into the data memory image.
+ * Encodes a string operand into the data memory image, from the data writing position on.
  *
  * @param node The AST node containing the string operand.
  * @param memory_img Pointer to the memory image structure.
  */
-void code_string(ASTNode *node, MemoryImage *memory_img);
-
-/**
- * Marks this word as unresolved by setting the last bit of the word to 1.
- * This mark will indicate to the second phase that this word should be encoded.
- *
- * @param code_img Pointer to the memory image structure.
- */
-void mark_word(MemoryImage *code_img);
-
-/**
- * Unmarks the last bit of the specified word in the memory image.
- * Indicates that the word is encoded.
- *
- * @param code_img Pointer to the memory image structure.
- * @param line The line number to unmark.
- */
-void unmark_word(MemoryImage *code_img, int line);
-
-/**
- * Retrieves the first marked word in the memory image.
- * Going over the memory image with static variable for avoiding multiple
- * unnecessary iteration. The variable is being reset after each file.
- *
- * @param memory_img Pointer to the memory image structure.
- * @param reset Flag indicating if a reset of the static variable should occur.
- * @return The index of the first marked line, or -1 if no marked line is found.
- */
-int get_marked_line(MemoryImage *memory_img, Boolean reset);
+void code_string(const ASTNode *node, MemoryImage *memory_img);
 
 #endif /* CODE_CONVERT_H */
@@ -1,6 +1,10 @@
 #ifndef DEFINES_H
 #define DEFINES_H
 /* -------------------- General macro's --------------------*/
+/* Version of the assembler - must change whenever the output files or messages change,
+ * as it is part of the key of the build cache */
+#define ASSEMBLER_VERSION "1.3"
+
 /* Maximum length of a command line in the source file */
 /* 80 chars + '/r' (if exists) +'/n' (if exists) + '/0' */
 #define MAX_LINE_LENGTH 83
@@ -29,8 +33,8 @@
 
 /* Last bit for a word */
 #define WORD_END_POS 14
-/* Last bit of the struct */
-#define LAST_WORD_BIT 15
+/* Mask of the 15 bits of a word */
+#define WORD_MASK 077777
 
 /* ----------------- Macro's for address modes  ----------------*/
 #define ADDR_MODE_IMMEDIATE 0
@@ -39,10 +43,11 @@
 #define ADDR_DIRECT_REG 3
 
 /* ----------------- Macro's for programs data  ----------------*/
-#define MEMORY_CAPACITY 3996 /* Starting address is 100, therefore 4096-100 */
-#define NUM_OF_BYTES 2
-#define BYTE_SIZE 8
+#define MEMORY_WORDS 4096      /* Default number of words of the machine memory */
+#define MAX_MEMORY_WORDS 100000 /* Largest memory - every address is printed with at most 5 digits */
 #define IC_START 100
+#define MAX_ENCODE_THREADS 64  /* Largest number of threads that encode the lines of a file */
+#define MEMORY_CAPACITY (MEMORY_WORDS - IC_START) /* Default number of words for the program */
 #define REGISTER_BIT_SIZE 3
 #define IMMEDIATE_DIRECTIVE_BIT_SIZE 12
 
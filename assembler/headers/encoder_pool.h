@@ -0,0 +1,56 @@
+#ifndef ENCODER_POOL_H
+#define ENCODER_POOL_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include "../../structures/headers/ast.h"
+#include "../../structures/headers/cmp_data.h"
+/* ---------------------------------------- Structures ----------------------------------------*/
+/* A line that the first phase sized without errors, to be encoded at the addresses it was given */
+typedef struct EncodeJob {
+    const ASTNode *node; /* The parsed line */
+    int code_pos;        /* Address of the line in the code section */
+    int data_pos;        /* Address of the line in the data section */
+} EncodeJob;
+
+/* A pool of threads that encode sized lines - its fields are private to the pool */
+typedef struct EncoderPool EncoderPool;
+
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Starts a pool of threads that encode lines into the specified memory image, with
+ * `first_phase_encoder`. The sections of the image must not move while the pool runs - see
+ * `reserve_image` - but its counters may change.
+ *
+ * @param threads The number of threads.
+ * @param image The memory image that the lines are encoded into.
+ * @return The pool, or NULL if memory allocation failed or a thread could not be started.
+ */
+EncoderPool *start_encoder_pool(int threads, const MemoryImage *image);
+
+/**
+ * Hands the specified lines to the threads of the pool, a contiguous part of the lines to every
+ * thread, and returns at once. The lines and their nodes must not change until `wait_encoder_pool`
+ * returns, and the lines handed before must have been waited for.
+ *
+ * @param pool The pool.
+ * @param jobs The lines to encode.
+ * @param count The number of lines.
+ */
+void encode_jobs(EncoderPool *pool, const EncodeJob *jobs, int count);
+
+/**
+ * Waits until the threads of the pool encoded the lines that were handed to them. The words of
+ * the lines are then visible to the calling thread.
+ *
+ * @param pool The pool.
+ */
+void wait_encoder_pool(EncoderPool *pool);
+
+/**
+ * Stops the threads of the pool and frees it. The lines handed to the pool must have been
+ * waited for.
+ *
+ * @param pool The pool to be stopped.
+ */
+void stop_encoder_pool(EncoderPool *pool);
+
+#endif /* ENCODER_POOL_H */
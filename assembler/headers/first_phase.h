@@ -5,12 +5,35 @@
 /* ----------------------------------- Functions Prototypes ------------------------------------*/
 /**
  * The `first_phase_analyzer` function analyzes a parsed line (ASTNode) during the first phase of assembly.
- * It determines the type of line and processes it accordingly, updating the `CmpData` structure.
+ * It sizes the line with `first_phase_sizer` and writes its words with `first_phase_encoder`.
  *
+ * @param ctx The context of the assembly process.
  * @param node The parsed line represented as an Abstract Syntax Tree (AST) node.
  * @param cmp_data The data structure holding various program-related data during assembly.
- * @return TRUE if the line is processed successfully, FALSE otherwise.
  */
-void first_phase_analyzer(ASTNode *node, CmpData *cmp_data);
+void first_phase_analyzer(AsmContext *ctx, ASTNode *node, CmpData *cmp_data);
+
+/**
+ * The `first_phase_sizer` function conducts the first phase of a parsed line without writing its
+ * words - it checks the line, advances the counters of the memory image by the words of the line,
+ * and updates the label table and the fixups. All the messages of the first phase are printed by it.
+ *
+ * @param ctx The context of the assembly process.
+ * @param node The parsed line represented as an Abstract Syntax Tree (AST) node.
+ * @param cmp_data The data structure holding various program-related data during assembly.
+ */
+void first_phase_sizer(AsmContext *ctx, ASTNode *node, CmpData *cmp_data);
+
+/**
+ * The `first_phase_encoder` function writes the words of a line that was sized without errors, at
+ * the addresses the sizer gave it. The counters of the memory image are not changed, so lines can
+ * be encoded at the same time.
+ *
+ * @param node The parsed line represented as an Abstract Syntax Tree (AST) node.
+ * @param image The memory image that the words are written to.
+ * @param code_pos Address of the line in the code section.
+ * @param data_pos Address of the line in the data section.
+ */
+void first_phase_encoder(const ASTNode *node, const MemoryImage *image, int code_pos, int data_pos);
 
 #endif /* FIRST_PHASE_H */
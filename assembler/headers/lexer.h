@@ -0,0 +1,52 @@
+#ifndef LEXER_H
+#define LEXER_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include <stdlib.h>
+#include "defines.h"
+#include "../../utils/headers/boolean.h"
+/* ------------------------------------------ Defines ------------------------------------------*/
+/* Maximum number of tokens in a line - every token takes at least one character, plus the end */
+#define MAX_TOKENS (MAX_LINE_LENGTH + 1)
+/* ---------------------------------------- Structures ----------------------------------------*/
+/* Enum representing the types of tokens */
+typedef enum {
+    TOKEN_WORD,   /* A run of characters up to a whitespace, a comma or the end of the line */
+    TOKEN_COMMA,  /* The operand separator ',' */
+    TOKEN_END     /* The end of the line - an empty token at the null terminator */
+} TokenType;
+
+/* A token - a span of the line. The characters of the token are not copied */
+typedef struct Token {
+    TokenType type;     /* The type of the token */
+    const char *start;  /* The first character of the token in the line */
+    size_t length;      /* The number of characters in the token */
+} Token;
+
+/*
+ * LineTokens struct
+ * The tokens of a line, produced in a single pass over its characters.
+ * A label is the text from the first non-whitespace character to a colon that comes before
+ * any whitespace; the tokens that follow the label are kept in the tokens array.
+ */
+typedef struct LineTokens {
+    const char *first;         /* The first non-whitespace character of the line */
+    const char *last;          /* The last non-whitespace character of the line */
+    const char *end;           /* The null terminator of the line */
+    Boolean has_label;         /* Flag indicating if the line starts with a label */
+    Token label;               /* The label, without the colon - if the line has a label */
+    Token tokens[MAX_TOKENS];  /* The tokens after the label - the last is TOKEN_END */
+    int count;                 /* The number of tokens, including TOKEN_END */
+} LineTokens;
+
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Splits a line into tokens in a single pass, classifying every character with the character
+ * class table. The tokens are spans of the line - nothing is copied or allocated.
+ *
+ * @param line The line to split.
+ * @param tokens Pointer to the structure that receives the tokens.
+ * @return TRUE if the line was split, FALSE if it has more tokens than MAX_TOKENS.
+ */
+Boolean tokenize_line(const char *line, LineTokens *tokens);
+
+#endif /* LEXER_H */
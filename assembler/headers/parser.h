@@ -3,6 +3,8 @@
 /* ----------------------------------------- Includes -----------------------------------------*/
 # include "../../structures/headers/ast.h"
 #include "../../structures/headers/macro_data.h"
+#include "../../structures/headers/label_data.h"
+#include "../../structures/headers/context.h"
 /* ----------------------------------- Functions Prototypes ------------------------------------*/
 /**
  * Parses a line of assembly image and creates an ASTNode representing the line.
@@ -11,13 +13,16 @@
  * information into an ASTNode structure. It uses several helper functions to
  * handle different parts of the line.
  *
+ * @param ctx The context of the assembly process.
  * @param macr_trie A trie containing macro definitions to check for collisions with labels.
+ * @param label_table The label table - the label operands are interned to their IDs in it.
  * @param file_name The name of the file being parsed, used for error reporting.
  * @param line_num The line number in the file, used for error reporting.
  * @param line The line of assembly image to parse.
  *
  * @return A pointer to the newly created ASTNode representing the parsed line.
  */
-ASTNode *parseLine(const MacroTrie *macr_trie, const char *file_name, int line_num, char *line);
+ASTNode *parseLine(AsmContext *ctx, const MacroTrie *macr_trie, LabelTable *label_table, const char *file_name,
+                   int line_num, const char *line);
 
 #endif /* PARSER_H */
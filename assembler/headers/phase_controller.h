@@ -1,17 +1,68 @@
-#ifndef FIRST_PHASE_H
-#define FIRST_PHASE_H
+#ifndef PHASE_CONTROLLER_H
+#define PHASE_CONTROLLER_H
 /* ----------------------------------------- Includes -----------------------------------------*/
 #include "../../structures/headers/macro_data.h"
+#include "../../structures/headers/context.h"
+#include "../../structures/headers/cmp_data.h"
+#include "../../structures/headers/line_buffer.h"
 /* ----------------------------------- Functions Prototypes ------------------------------------*/
 /**
- * The `phase_controller` function orchestrates the two phases of the assembler on the am file.
- * It conducts the first and second phases of assembly and creates the final object file if both
- * phases were successful.
+ * The `phase_controller` function orchestrates the two phases of the assembler on the preprocessed
+ * lines. It conducts the first and second phases of assembly and creates the final object file
+ * if both phases were successful.
+ * The entry and extern lines are kept in memory during the phases - each of their files is
+ * created only after the object file, and only if it has lines. The memory of the program's data
+ * belongs to the caller - it is reset after the file, for the next one.
  *
+ * @param ctx The context of the assembly process.
  * @param origin_file_name The name of the original source file.
- * @param file_name_am The name of the preprocessed source file (.am).
+ * @param file_name_am The name of the preprocessed source file (.am), used for error reporting.
+ * @param am_lines The preprocessed lines.
  * @param macr_trie The trie structure containing macro definitions.
+ * @param cmp_data The initialized, empty data structure that the encoded program is written to.
+ * @param encode_threads The number of threads that encode the lines of the first phase - 1 encodes
+ *        every line right after it is sized.
  */
-void phase_controller(const char *origin_file_name, const char *file_name_am, MacroTrie *macr_trie);
+void phase_controller(AsmContext *ctx, const char *origin_file_name, const char *file_name_am,
+                      const LineBuffer *am_lines, MacroTrie *macr_trie, CmpData *cmp_data, int encode_threads);
 
-#endif /* FIRST_PHASE_H */
+/**
+ * The `phases_controller` function conducts the first and second phases of the assembler on the
+ * preprocessed lines, and writes the encoded program to the specified data structure.
+ *
+ * @param ctx The context of the assembly process.
+ * @param am_lines The preprocessed lines.
+ * @param file_name_am The name of the preprocessed source file, used for error reporting.
+ * @param macr_trie The trie structure containing macro definitions.
+ * @param cmp_data The initialized data structure that the encoded program is written to.
+ * @param encode_threads The number of threads that encode the lines of the first phase - 1 encodes
+ *        every line right after it is sized.
+ * @return TRUE if both phases completed without errors, FALSE otherwise.
+ */
+Boolean phases_controller(AsmContext *ctx, const LineBuffer *am_lines, const char *file_name_am, MacroTrie *macr_trie,
+                          CmpData *cmp_data, int encode_threads);
+
+/**
+ * The `encoded_phase_controller` function completes the assembly of preprocessed lines whose
+ * first phase was conducted already (see `pipeline_controller`): it conducts the second phase
+ * and creates the output files, if the first phase completed without errors.
+ *
+ * @param ctx The context of the assembly process, with the errors of the first phase.
+ * @param origin_file_name The name of the original source file.
+ * @param am_lines The preprocessed lines.
+ * @param cmp_data The data structure holding the program encoded by the first phase.
+ */
+void encoded_phase_controller(AsmContext *ctx, const char *origin_file_name, const LineBuffer *am_lines,
+                              CmpData *cmp_data);
+
+/**
+ * The `remove_record_files` function removes the entry and extern files of a source file, if
+ * they exist. It is called when the assembly of the file failed, so the files of a previous
+ * assembly are not left next to its source.
+ *
+ * @param ctx The context of the assembly process.
+ * @param origin_file_name The name of the original source file.
+ */
+void remove_record_files(AsmContext *ctx, const char *origin_file_name);
+
+#endif /* PHASE_CONTROLLER_H */
@@ -0,0 +1,34 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include "../../structures/headers/macro_data.h"
+#include "../../structures/headers/context.h"
+#include "../../structures/headers/cmp_data.h"
+#include "../../structures/headers/line_buffer.h"
+#include "../../utils/headers/source_file.h"
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * The `pipeline_controller` function assembles a source file like the preprocessor and the phase
+ * controllers one after the other, with the stages of the first pass running at the same time:
+ * a reader thread splits the source into lines, a preprocessor thread expands the macros, a parser
+ * thread parses the expanded lines and the calling thread encodes them (the first phase).
+ * The stages pass batches of lines through bounded lock-free rings. The messages of the parser
+ * and the encoder are held until the preprocessor is done, so the printed messages and the
+ * output files are exactly those of the sequential assembly.
+ *
+ * @param ctx The context of the assembly process.
+ * @param file_origin The base name of the source file without extension.
+ * @param macro_trie A trie structure containing macro definitions for preprocessing.
+ * @param am_lines The line buffer that receives the processed lines.
+ * @param cmp_data The initialized, empty data structure that the encoded program is written to.
+ * @param emit_am Flag indicating whether to write the processed lines to the ".am" file.
+ * @param source The content of the source file (.as) if it was read already, or NULL to read it.
+ * @param encode_threads The number of threads that encode the lines if the phases are conducted
+ *        again by `phase_controller`.
+ * @return The name of the preprocessed file with the ".am" extension, or NULL if an error occurred
+ *         before the phases.
+ */
+char *pipeline_controller(AsmContext *ctx, const char *file_origin, MacroTrie *macro_trie, LineBuffer *am_lines,
+                          CmpData *cmp_data, Boolean emit_am, const SourceFile *source, int encode_threads);
+
+#endif /* PIPELINE_H */
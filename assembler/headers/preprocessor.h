@@ -1,16 +1,92 @@
 #ifndef PREPROCESSOR_H
 #define PREPROCESSOR_H
 #include "../../structures/headers/macro_data.h"
+#include "../../structures/headers/context.h"
+#include "../../structures/headers/line_buffer.h"
+#include "../../utils/headers/source_file.h"
+
+/* ----------------------------------- Structures ------------------------------------*/
+/* The state of the preprocessor between the lines of a source */
+typedef struct PreprocessorState {
+    Location location;      /* The file and the number of the last line */
+    Boolean inside_macro;   /* Flag indicating if the lines are part of a macro definition */
+    char defined_macro[MAX_LINE_LENGTH]; /* The macro that the last line defined, or empty */
+} PreprocessorState;
+
+/* Function that processes the content of a source into a line buffer, like `preprocess_source` */
+typedef void (*SourceProcessor)(AsmContext *ctx, const char *source, size_t size, LineBuffer *am_lines,
+                                const char *source_name, MacroTrie *macro_trie, void *data);
 
 /* ----------------------------------- Prototypes ------------------------------------*/
 /**
  * The `preprocessor_controller` function handles preprocessing of the source file,
- * applying macro expansions, and writing the processed output to a new file with ".am" extension.
+ * applying macro expansions, and keeping the processed output in the specified line buffer.
+ * The processed output is written to a new file with ".am" extension only if specified so.
+ *
+ * @param ctx The context of the assembly process.
+ * @param file_origin The base name of the source file without extension.
+ * @param macro_trie A trie structure containing macro definitions for preprocessing.
+ * @param am_lines The line buffer that receives the processed lines.
+ * @param emit_am Flag indicating whether to write the processed lines to the ".am" file.
+ * @param source The content of the source file (.as) if it was read already, or NULL to read it.
+ * @return The name of the output file with the ".am" extension, or NULL if an error occurs.
+ */
+char *preprocessor_controller(AsmContext *ctx, const char *file_origin, MacroTrie *macro_trie,
+                              LineBuffer *am_lines, Boolean emit_am, const SourceFile *source);
+
+/**
+ * Preprocesses a source file like `preprocessor_controller`, with the content of the file
+ * processed by the specified function - it has to fill the line buffer as `preprocess_source` does.
  *
+ * @param ctx The context of the assembly process.
  * @param file_origin The base name of the source file without extension.
  * @param macro_trie A trie structure containing macro definitions for preprocessing.
+ * @param am_lines The line buffer that receives the processed lines.
+ * @param emit_am Flag indicating whether to write the processed lines to the ".am" file.
+ * @param source The content of the source file (.as) if it was read already, or NULL to read it.
+ * @param processor The function that processes the content, or NULL for `preprocess_source`.
+ * @param data The data passed to the processor.
  * @return The name of the output file with the ".am" extension, or NULL if an error occurs.
  */
-char *preprocessor_controller(const char *file_origin, MacroTrie *macro_trie);
+char *preprocess_file(AsmContext *ctx, const char *file_origin, MacroTrie *macro_trie, LineBuffer *am_lines,
+                      Boolean emit_am, const SourceFile *source, SourceProcessor processor, void *data);
+
+/**
+ * Preprocesses the content of a source into a line buffer, applying macro expansions.
+ * The lines are processed as spans of the content, which is not modified.
+ *
+ * @param ctx The context of the assembly process.
+ * @param source The content of the source - it does not have to be null-terminated.
+ * @param size The number of characters in the content.
+ * @param am_lines The line buffer that receives the processed lines.
+ * @param source_name The name of the source file, used for error reporting.
+ * @param macro_trie A trie structure containing macro definitions for preprocessing.
+ */
+void preprocess_source(AsmContext *ctx, const char *source, size_t size, LineBuffer *am_lines,
+                       const char *source_name, MacroTrie *macro_trie);
+
+/**
+ * Initializes the state of the preprocessor for the first line of a source.
+ *
+ * @param state Pointer to the state to be initialized.
+ * @param source_name The name of the source file, used for error reporting.
+ */
+void init_preprocessor_state(PreprocessorState *state, const char *source_name);
+
+/**
+ * Processes a single line of a source - a macro definition line is kept in the macro trie,
+ * a macro usage is replaced by the lines of the macro, and any other line is added to the
+ * line buffer as is (without its comment and leading spaces). The lines of a source have to
+ * be processed in order, with the same state.
+ *
+ * @param ctx The context of the assembly process.
+ * @param state The state of the preprocessor, updated by the function.
+ * @param span The line - a span of the source, including its '\n' if exists.
+ * @param length The number of characters in the span.
+ * @param am_lines The line buffer that receives the processed lines.
+ * @param macro_trie A trie structure containing macro definitions for preprocessing.
+ */
+void preprocess_line(AsmContext *ctx, PreprocessorState *state, const char *span, size_t length,
+                     LineBuffer *am_lines, MacroTrie *macro_trie);
 
 #endif /* PREPROCESSOR_H */
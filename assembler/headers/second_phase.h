@@ -3,15 +3,17 @@
 /* ----------------------------------------- Includes -----------------------------------------*/
 #include "../../structures/headers/ast.h"
 #include "../../structures/headers/cmp_data.h"
+#include "../../structures/headers/line_buffer.h"
 /* ----------------------------------- Functions Prototypes ------------------------------------*/
 /**
- * The `second_phase_analyzer` function processes an unresolved line during the second phase of assembly.
- * It handles encoding of label operand's in instruction lines and entry directives.
+ * The `second_phase_analyzer` function resolves the fixups recorded during the first phase.
+ * It encodes the label operands of the instruction lines and handles the entry directives,
+ * in the order of the source lines.
  *
- * @param node The parsed line represented as an ASTNode containing an instruction or directive.
+ * @param ctx The context of the assembly process.
+ * @param am_lines The preprocessed lines, used for error reporting.
  * @param cmp_data The data structure holding various program-related data during assembly.
- * @return TRUE if the line is processed successfully, FALSE otherwise.
  */
-void second_phase_analyzer(ASTNode *node, CmpData *cmp_data);
+void second_phase_analyzer(AsmContext *ctx, const LineBuffer *am_lines, CmpData *cmp_data);
 
-#endif /* SECOND_PHASE_H */
+#endif /* SECOND_PHASE_H */
\ No newline at end of file
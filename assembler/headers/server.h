@@ -0,0 +1,45 @@
+#ifndef SERVER_H
+#define SERVER_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include "../../structures/headers/errors.h"
+#include "../../structures/headers/context.h"
+/* ----------------------------------------- Defines ------------------------------------------*/
+/* The socket of the server when no path is given - the client reads ASSEMBLER_SOCKET first */
+#define DEFAULT_SOCKET_PATH "/tmp/assembler.sock"
+/* The environment variable that overrides the socket of the client */
+#define SOCKET_PATH_VARIABLE "ASSEMBLER_SOCKET"
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Runs the assembler as a server - one process that stays alive and assembles the requests
+ * of its clients in a single workspace, so the arenas, tables and buffers stay warm between
+ * requests. The requests are read from a Unix domain socket, one connection at a time, or from
+ * the standard input when the path is "-" (with the replies written to the standard output).
+ *
+ * Requests and replies are sequences of frames (see `write_frame`), ended by an "END" frame.
+ * A request either carries a command line, assembled as `assembler_exe` does:
+ *     CWD  - the working directory of the file names (optional)
+ *     ARG  - one argument of the command line, repeated for every argument
+ * with the reply "OUTPUT" (the printed messages) and "STATUS"; or carries the source inline:
+ *     NAME - the base name of the source (optional), SOURCE - the content of the source
+ * with the reply "OBJECT", "ENTRIES" and "EXTERNALS" (only the contents that exist),
+ * "DIAGNOSTICS" and "STATUS". The status is "ok", "error" or "fatal". A request that cannot be
+ * served is answered with an "ERROR" frame instead - after an invalid request the connection
+ * is closed.
+ * The server stops at the end of the standard input, or when it gets SIGINT or SIGTERM.
+ *
+ * @param ctx The context for reporting errors of the server itself.
+ * @param path The path of the socket, or "-" for the standard input and output.
+ * @return FATAL_ERROR if memory allocation failed, ERROR_IN_FILE if the socket cannot be created,
+ *         ERROR_FREE_FILE otherwise.
+ */
+Status run_server(AsmContext *ctx, const char *path);
+
+/**
+ * Connects to the server listening on the specified socket.
+ *
+ * @param path The path of the socket.
+ * @return The descriptor of the connection, or -1 if no server is listening on the socket.
+ */
+int connect_server(const char *path);
+
+#endif /* SERVER_H */
@@ -0,0 +1,35 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include "../../structures/headers/errors.h"
+#include "../../structures/headers/context.h"
+#include "../../structures/headers/workspace.h"
+/* ---------------------------------------- Structures ----------------------------------------*/
+/* Function that assembles a single file and returns the final status of the process */
+typedef Status (*JobFunction)(const char *file_name, const AsmOptions *options, AsmWorkspace *workspace);
+
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Runs the specified job on every file name with a pool of worker processes.
+ *
+ * Each file is assembled in its own child process, at most `options->jobs` at a time. The files
+ * are scheduled from the largest source file (.as) to the smallest, so that one big file
+ * will not be left running alone at the end. The standard output of every job is captured
+ * and printed in the original order of the file names, so the printed messages are
+ * identical to a sequential run and never interleave between files.
+ * If a job ends with a fatal error, no more jobs are started - as in a sequential run. The jobs
+ * that were already running finish their files, and their messages are printed after those of
+ * the failed file, so every output file that was written comes with its messages.
+ *
+ * @param ctx The context for reporting errors of the pool itself.
+ * @param file_names The base names of the files to assemble.
+ * @param count The number of file names.
+ * @param options The command line options, passed to every job.
+ * @param workspace The workspace the jobs assemble their files in - every worker has its own copy.
+ * @param job The function that assembles a single file.
+ * @return FATAL_ERROR if one of the jobs ended with a fatal error, ERROR_FREE_FILE otherwise.
+ */
+Status run_worker_pool(AsmContext *ctx, char *file_names[], int count, const AsmOptions *options,
+                       AsmWorkspace *workspace, JobFunction job);
+
+#endif /* WORKER_POOL_H */
@@ -1,10 +1,34 @@
 /* ---------------------------------------------------------------------------------------
  *                                          Includes
  * --------------------------------------------------------------------------------------- */
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include "../headers/build_cache.h"
 #include "../headers/phase_controller.h"
+#include "../headers/pipeline.h"
 #include "../headers/preprocessor.h"
+#include "../headers/worker_pool.h"
+#include "../headers/server.h"
+#include "../headers/assembler_controller.h"
+#include "../../utils/headers/file_list.h"
+#include "../../utils/headers/utils.h"
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static int read_command_line(AsmContext *ctx, int argc, char* argv[], AsmOptions *options);
+static int parse_options(int argc, char* argv[], AsmOptions *options);
+static Boolean collect_batch(AsmContext *ctx, int argc, char* argv[], int first, const AsmOptions *options,
+                             FileList *batch);
+static Boolean parse_jobs(const char *str, int *jobs);
+static Boolean parse_memory_words(const char *str, int *memory_words);
+static Status assemble_file(const char *file_name, const AsmOptions *options, AsmWorkspace *workspace);
+static void assemble_source(const char *file_name, const AsmOptions *options, AsmWorkspace *workspace,
+                            const SourceFile *source);
+static void assemble_to_cache(const char *file_name, const AsmOptions *options, AsmWorkspace *workspace,
+                              const char *key, const SourceFile *source);
+static Boolean read_source_file(const char *file_name, SourceFile *source);
 /* ---------------------------------------------------------------------------------------
  *                                         Functions
  * --------------------------------------------------------------------------------------- */
@@ -15,51 +39,443 @@
  * It first preprocesses the files to handle macros, and then proceeds with the main processing phases.
  * If any errors occur during processing, appropriate messages are displayed and processing may halt
  * depending on the severity of the error.
+ * With the option '-j N', the files are assembled by a pool of N worker processes.
+ * With the option '--emit-am', the preprocessed source of every file is written to a .am file.
+ * With the option '--memory-words N', the machine memory has N words instead of MEMORY_WORDS.
+ * With the option '--stats', the times and counters of every file are printed as a JSON object.
+ * With the option '--cache DIR', the outputs of unchanged sources are restored from a build cache.
+ * With the options '--manifest FILE' and '--dir PATH', the files of a manifest and of a directory
+ * tree are added to the files of the command line. Such a batch is assembled from the largest
+ * source to the smallest, and ends with the totals of all its files.
+ * With the option '--pipeline', the first pass of every file runs as a pipeline of threads
+ * (see `pipeline_controller`).
+ * With the option '--encode-threads N', the lines of the first phase of a large file are encoded
+ * by N threads, while the next lines are sized (see `first_phase_controller`).
+ * All the files are assembled in one workspace, which is reset after every file.
+ * With the option '--serve [socket | -]', the process becomes a server that assembles the
+ * requests of clients in one workspace (see `run_server`).
  *
  * @param argc The number of command line arguments.
  * @param argv The array of command line arguments.
  */
 void controller(int argc, char* argv[]) {
-    int i = 1;            /* Index for iterating through loop */
-    char* file_am = NULL; /* File name with .am extension */
-    MacroTrie macro_trie; /* Macro trie to save macro's data */
+    int i;                /* Index for iterating through loop */
+    AsmOptions options;   /* The command line options */
+    AsmContext ctx;       /* Context for reporting command line errors */
+    AsmWorkspace workspace; /* The workspace the files are assembled in */
+    FileList batch;       /* The files of a manifest or a directory, with those of the command line */
+    char **file_names;    /* The files to assemble */
+    int count;            /* Number of files to assemble */
 
-    /* no arguments were passed */
-    if (argc < 2 ) {
-        /* print error message */
-        set_general_error(NO_ARGUMENTS);
-        exit(0); /* return */
+    init_context(&ctx, stdout);
+
+    /* server mode - the only option of the command line */
+    if (argc >= 2 && strcmp(argv[1], "--serve") == 0) {
+        if (argc > 3) {
+            set_general_error(&ctx, INVALID_OPTION);
+            exit(0);
+        }
+        if (run_server(&ctx, argc == 3 ? argv[2] : DEFAULT_SOCKET_PATH) == FATAL_ERROR) exit(0);
+        return;
+    }
+
+    /* read command line options */
+    if ((i = read_command_line(&ctx, argc, argv, &options)) == -1) exit(0);
+
+    /* collect the files of a batch */
+    init_file_list(&batch);
+    file_names = argv + i;
+    count = argc - i;
+    if (options.manifest || options.source_dir) {
+        if (collect_batch(&ctx, argc, argv, i, &options, &batch) == FALSE) exit(0);
+        file_names = batch.names;
+        count = batch.count;
+    }
+
+    if (init_workspace(&workspace, stdout, options.memory_words) == FALSE) {
+        set_general_error(&ctx, MEMORY_ALLOCATION_ERROR);
+        exit(0);
+    }
+
+    if (options.jobs > 1 && count > 1) {
+        /* assemble the files with a pool of workers */
+        if (run_worker_pool(&ctx, file_names, count, &options, &workspace, assemble_file) == FATAL_ERROR) {
+            exit(0);
+        }
+    } else {
+        /* read inputted files */
+        for (i = 0; i < count; i++) {
+            /* Check for fatal error */
+            if (assemble_file(file_names[i], &options, &workspace) == FATAL_ERROR) exit(0);
+        }
+    }
+
+    if (options.manifest || options.source_dir) print_batch_summary(stdout, &workspace.batch);
+    free_file_list(&batch);
+    free_workspace(&workspace);
+}
+
+/**
+ * Assembles the files of a command line in the specified workspace, the same as `controller`,
+ * with the messages printed to the output stream of the workspace. The files are assembled one
+ * after the other - the option '-j' is accepted and ignored, as the printed messages are the same.
+ * The workspace is left reset, for the next command line.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The array of command line arguments - the first one is the program name.
+ * @param workspace The workspace to assemble the files in.
+ * @return FATAL_ERROR if the assembly was stopped by a fatal error, ERROR_IN_FILE if the command
+ *         line is invalid, ERROR_FREE_FILE otherwise.
+ */
+Status assemble_command_line(int argc, char* argv[], AsmWorkspace *workspace) {
+    int i;                /* Index for iterating through loop */
+    AsmOptions options;   /* The command line options */
+    AsmContext ctx;       /* Context for reporting command line errors */
+    FileList batch;       /* The files of a manifest or a directory, with those of the command line */
+    Status status = ERROR_FREE_FILE;
+
+    init_context(&ctx, workspace->ctx.output);
+    init_file_list(&batch);
+    if ((i = read_command_line(&ctx, argc, argv, &options)) != -1 && (options.manifest || options.source_dir) &&
+        collect_batch(&ctx, argc, argv, i, &options, &batch) == FALSE) {
+        i = -1;
+    }
+    /* An invalid command line, or a batch that cannot be collected */
+    if (i == -1) status = get_status(&ctx) == FATAL_ERROR ? FATAL_ERROR : ERROR_IN_FILE;
+    free_context(&ctx);
+    if (i == -1) return status;
+
+    /* The memory image grows with use - only its limit changes */
+    set_memory_words(&workspace->cmp_data, options.memory_words);
+    clear_batch_summary(&workspace->batch);
+
+    if (options.manifest || options.source_dir) {
+        for (i = 0; i < batch.count && status != FATAL_ERROR; i++) {
+            if (assemble_file(batch.names[i], &options, workspace) == FATAL_ERROR) status = FATAL_ERROR;
+        }
+        if (status != FATAL_ERROR) print_batch_summary(workspace->ctx.output, &workspace->batch);
+    } else {
+        for (; i < argc && status != FATAL_ERROR; i++) {
+            if (assemble_file(argv[i], &options, workspace) == FATAL_ERROR) status = FATAL_ERROR;
+        }
+    }
+    free_file_list(&batch);
+    return status;
+}
+
+/**
+ * Assembles a single file - preprocesses the file, conducts the assembler phases and
+ * prints the process summery, followed by the statistics of the file if requested.
+ * With a build cache, the outputs of a source that was assembled before are restored instead,
+ * and the outputs of a new source are kept in the cache. The source is read once - its key is
+ * calculated from the same content that is assembled, so the outputs of a source that changes
+ * during the assembly are never kept under the key of another content.
+ *
+ * @param file_name The base name of the file without extension.
+ * @param options The command line options.
+ * @param workspace The workspace to assemble the file in - reset at the end, for the next file.
+ * @return The status of the file at the end of the process.
+ */
+static Status assemble_file(const char *file_name, const AsmOptions *options, AsmWorkspace *workspace) {
+    Status status;                     /* The status of the file at the end of the process */
+    AsmContext *ctx = &workspace->ctx; /* The context of the file's assembly process */
+    char key[CACHE_KEY_LENGTH];        /* The key of the file in the build cache */
+    SourceFile source;                 /* The content of the source, read once for the cache */
+    double start = stats_clock();      /* Start time of the cache lookup */
+
+    if (options->cache_dir && read_source_file(file_name, &source) == TRUE) {
+        if (cache_key(file_name, &source, options, key) == FALSE) {
+            assemble_source(file_name, options, workspace, &source);
+        } else if (restore_cache_entry(ctx, options->cache_dir, key, file_name) == TRUE) {
+            /* A hit - the outputs were restored */
+            add_stage_time(&ctx->stats, STAGE_OUTPUT, start);
+            ctx->stats.cache_hits++;
+        } else {
+            /* A miss - reading and hashing the source count as preprocessing */
+            add_stage_time(&ctx->stats, STAGE_PREPROCESSOR, start);
+            ctx->stats.cache_misses++;
+            assemble_to_cache(file_name, options, workspace, key, &source);
+        }
+        close_source_file(&source);
+    } else {
+        /* The source is read by the preprocessor - it reports a source that cannot be read */
+        assemble_source(file_name, options, workspace, NULL);
     }
 
-    /* read inputted files */
-    while (argc > 1) {
-        /* Initialize the macro data structure */
-        init_macr_trie(&macro_trie);
+    status = get_status(ctx);
+    if (options->stats == TRUE) print_stats(ctx->output, file_name, status, &ctx->stats);
+    add_to_batch_summary(&workspace->batch, &ctx->program_status);
+
+    /* Reset the workspace before proceeding to the next file */
+    reset_workspace(workspace);
+    return status;
+}
 
+/**
+ * Assembles the source of a file - preprocesses the file, conducts the assembler phases and
+ * prints the process summery. The workspace is left as the assembly ended.
+ *
+ * @param file_name The base name of the file without extension.
+ * @param options The command line options.
+ * @param workspace The workspace to assemble the file in.
+ * @param source The content of the source file if it was read already, or NULL to read it.
+ */
+static void assemble_source(const char *file_name, const AsmOptions *options, AsmWorkspace *workspace,
+                            const SourceFile *source) {
+    char* file_am = NULL;              /* File name with .am extension */
+    AsmContext *ctx = &workspace->ctx; /* The context of the file's assembly process */
+    double start = stats_clock();      /* Start time of the preprocessor */
+
+    if (options->pipeline == TRUE) {
+        /* Preprocess file and conduct the phases, with the first pass as a pipeline */
+        file_am = pipeline_controller(ctx, file_name, &workspace->macro_trie, &workspace->am_lines,
+                                      &workspace->cmp_data, options->emit_am, source,
+                                      options->encode_threads);
+    } else {
         /* Preprocess file */
-        file_am = preprocessor_controller(argv[i], &macro_trie);
+        file_am = preprocessor_controller(ctx, file_name, &workspace->macro_trie, &workspace->am_lines,
+                                          options->emit_am, source);
+        add_stage_time(&ctx->stats, STAGE_PREPROCESSOR, start);
 
         /* Continue processing only if no error occurred */
-        if (get_status() == ERROR_FREE_FILE) {
-            phase_controller(argv[i], file_am, &macro_trie);
+        if (get_status(ctx) == ERROR_FREE_FILE) {
+            phase_controller(ctx, file_name, file_am, &workspace->am_lines, &workspace->macro_trie,
+                             &workspace->cmp_data, options->encode_threads);
+        }
+    }
+
+    /* A failed file keeps no entry or extern file of a previous assembly */
+    if (get_status(ctx) != ERROR_FREE_FILE) remove_record_files(ctx, file_name);
+
+    /* Print process summery */
+    print_error_summery(ctx, file_name);
+    if (file_am) free(file_am);
+}
+
+/**
+ * Assembles the source of a file with its messages captured, prints them, and keeps the outputs
+ * in the build cache. Only outputs that depend on the source alone are kept - not those of an
+ * assembly that failed to read or write a file, or ended with a fatal error.
+ *
+ * @param file_name The base name of the file without extension.
+ * @param options The command line options.
+ * @param workspace The workspace to assemble the file in.
+ * @param key The key of the file in the build cache.
+ * @param source The content of the source file that the key was calculated from.
+ */
+static void assemble_to_cache(const char *file_name, const AsmOptions *options, AsmWorkspace *workspace,
+                              const char *key, const SourceFile *source) {
+    AsmContext *ctx = &workspace->ctx; /* The context of the file's assembly process */
+    FILE *output = ctx->output;        /* The stream that the messages are printed to */
+    char *messages = NULL;             /* The captured messages */
+    size_t size = 0;                   /* The size of the messages */
+    const char *extensions[5];         /* The extensions of the created output files */
+    int count = 0;                     /* Number of created output files */
+
+    /* Without a capture stream the file is assembled without the cache */
+    if (!(ctx->output = open_memstream(&messages, &size))) {
+        ctx->output = output;
+        assemble_source(file_name, options, workspace, source);
+        return;
+    }
+    assemble_source(file_name, options, workspace, source);
+    fclose(ctx->output);
+    ctx->output = output;
+    fwrite(messages, 1, size, output);
+
+    if (get_status(ctx) != FATAL_ERROR && ctx->program_status.file_error == FALSE) {
+        /* The .am file is written whenever the source was read, the others only without errors */
+        if (options->emit_am == TRUE) extensions[count++] = ".am";
+        if (get_status(ctx) == ERROR_FREE_FILE) {
+            extensions[count++] = ".ob";
+            if (workspace->cmp_data.entries.size > 0) extensions[count++] = ".ent";
+            if (workspace->cmp_data.externals.size > 0) extensions[count++] = ".ext";
         }
+        extensions[count] = NULL;
+        store_cache_entry(ctx, options->cache_dir, key, file_name, messages, size, extensions);
+    }
+    free(messages);
+}
+
+/**
+ * Reads the whole content of the source file (.as) of the specified base name.
+ *
+ * @param file_name The base name of the file without extension.
+ * @param source Pointer to the structure that receives the content.
+ * @return TRUE if the source was read, FALSE otherwise (nothing is printed).
+ */
+static Boolean read_source_file(const char *file_name, SourceFile *source) {
+    char *source_name = NULL; /* The name of the source file */
+    ErrorCode result;
 
-        /* Print process summery */
-        print_error_summery(argv[i]);
+    if (!create_new_file_name(file_name, &source_name, ".as")) return FALSE;
+    result = open_source_file(source_name, source);
+    free(source_name);
+    return (result == NO_ERROR) ? TRUE : FALSE;
+}
+
+/**
+ * Reads the command line options, and prints an error if the command line is invalid - without
+ * arguments, with an invalid option or without file names (and without a manifest or a directory).
+ *
+ * @param ctx The context for reporting command line errors.
+ * @param argc The number of command line arguments.
+ * @param argv The array of command line arguments.
+ * @param options Pointer to store the options.
+ * @return The index of the first file name, or -1 if the command line is invalid.
+ */
+static int read_command_line(AsmContext *ctx, int argc, char* argv[], AsmOptions *options) {
+    int i; /* Index of the first file name */
+
+    options->jobs = 1;
+    options->emit_am = FALSE;
+    options->memory_words = MEMORY_WORDS;
+    options->stats = FALSE;
+    options->cache_dir = NULL;
+    options->manifest = NULL;
+    options->source_dir = NULL;
+    options->pipeline = FALSE;
+    options->encode_threads = 1;
+
+    /* no arguments were passed */
+    if (argc < 2) {
+        set_general_error(ctx, NO_ARGUMENTS);
+        return -1;
+    }
+
+    /* read command line options */
+    if ((i = parse_options(argc, argv, options)) == -1) {
+        set_general_error(ctx, INVALID_OPTION);
+        return -1;
+    }
+
+    /* no file names were passed */
+    if (i >= argc && !options->manifest && !options->source_dir) {
+        set_general_error(ctx, NO_ARGUMENTS);
+        return -1;
+    }
+    return i;
+}
 
-        /* Check for fatal error */
-        if (get_status() == FATAL_ERROR) exit(0);
+/**
+ * Reads the options at the start of the command line.
+ * Supported options:
+ * '-j N' or '-jN' - the number of files to assemble at the same time.
+ * '--emit-am'     - write the preprocessed source of every file to a .am file.
+ * '--memory-words N' - the number of words of the machine memory (default MEMORY_WORDS).
+ * '--stats'       - print the times and counters of every file as a JSON object.
+ * '--cache DIR'   - restore the outputs of unchanged sources from the build cache in DIR.
+ * '--manifest FILE' - assemble the files of FILE as well, one base name per line.
+ * '--dir PATH'    - assemble every source file (.as) under PATH as well.
+ * '--pipeline'    - run the first pass of every file as a pipeline of threads.
+ * '--encode-threads N' - the number of threads that encode the lines of the first phase
+ *                   (at most MAX_ENCODE_THREADS).
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The array of command line arguments.
+ * @param options Pointer to store the options.
+ * @return The index of the first file name, or -1 if an option is invalid.
+ */
+static int parse_options(int argc, char* argv[], AsmOptions *options) {
+    int i = 1; /* Index for iterating through the arguments */
 
-        /* updated variables */
+    while (i < argc && argv[i][0] == '-') {
+        if (strcmp(argv[i], "--emit-am") == 0) {
+            options->emit_am = TRUE;
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            options->stats = TRUE;
+        } else if (strcmp(argv[i], "--pipeline") == 0) {
+            options->pipeline = TRUE;
+        } else if (strcmp(argv[i], "--cache") == 0) {
+            if (i + 1 >= argc || argv[i + 1][0] == '\0') return -1;
+            options->cache_dir = argv[++i];
+        } else if (strcmp(argv[i], "--manifest") == 0) {
+            if (options->manifest || i + 1 >= argc || argv[i + 1][0] == '\0') return -1;
+            options->manifest = argv[++i];
+        } else if (strcmp(argv[i], "--dir") == 0) {
+            if (options->source_dir || i + 1 >= argc || argv[i + 1][0] == '\0') return -1;
+            options->source_dir = argv[++i];
+        } else if (strcmp(argv[i], "--encode-threads") == 0) {
+            if (i + 1 >= argc || parse_jobs(argv[i + 1], &options->encode_threads) == FALSE ||
+                options->encode_threads > MAX_ENCODE_THREADS) {
+                return -1;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--memory-words") == 0) {
+            if (i + 1 >= argc || parse_memory_words(argv[i + 1], &options->memory_words) == FALSE) return -1;
+            i++;
+        } else if (strncmp(argv[i], "-j", 2) != 0) {
+            return -1; /* Unknown option */
+        } else if (argv[i][2] != '\0') { /* '-jN' */
+            if (parse_jobs(argv[i] + 2, &options->jobs) == FALSE) return -1;
+        } else { /* '-j N' */
+            if (i + 1 >= argc || parse_jobs(argv[i + 1], &options->jobs) == FALSE) return -1;
+            i++;
+        }
         i++;
-        argc--;
+    }
+    return i;
+}
 
-        /* Cleanup resources before proceeding to the next file */
-        if (file_am) free(file_am);
-        free_macr_trie(&macro_trie);
+/**
+ * Collects the files of a batch - the file names of the command line, the names of the manifest
+ * and the sources under the directory - and sorts them from the largest source to the smallest,
+ * so one big file is not left alone at the end of the batch.
+ *
+ * @param ctx The context for reporting errors.
+ * @param argc The number of command line arguments.
+ * @param argv The array of command line arguments.
+ * @param first The index of the first file name of the command line.
+ * @param options The command line options.
+ * @param batch Pointer to the list that receives the files.
+ * @return TRUE if the files were collected, FALSE if the manifest or the directory cannot be read
+ *         (an error is printed).
+ */
+static Boolean collect_batch(AsmContext *ctx, int argc, char* argv[], int first, const AsmOptions *options,
+                             FileList *batch) {
+    ErrorCode result = NO_ERROR;
+    int i;
 
-        /* Clear error status for next files */
-        clear_error();
-        clear_status();
+    for (i = first; i < argc && result == NO_ERROR; i++) {
+        if (add_file_name(batch, argv[i], strlen(argv[i])) == FALSE) result = MEMORY_ALLOCATION_ERROR;
+    }
+    if (result == NO_ERROR && options->manifest) result = read_manifest(batch, options->manifest);
+    if (result == NO_ERROR && options->source_dir) result = scan_directory(batch, options->source_dir);
+    if (result == NO_ERROR && sort_by_size(batch) == FALSE) result = MEMORY_ALLOCATION_ERROR;
+
+    if (result != NO_ERROR) {
+        set_general_error(ctx, result);
+        free_file_list(batch);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/**
+ * Reads the number of jobs from the specified string.
+ *
+ * @param str The string to read.
+ * @param jobs Pointer to store the number of jobs.
+ * @return TRUE if the string is a positive integer, FALSE otherwise.
+ */
+static Boolean parse_jobs(const char *str, int *jobs) {
+    if (is_valid_integer(str) == FALSE || my_atoi(str) < 1) return FALSE;
+    *jobs = my_atoi(str);
+    return TRUE;
+}
+
+/**
+ * Reads the number of memory words from the specified string.
+ * The memory must have room for the IC_START offset and at least one word of the program.
+ *
+ * @param str The string to read.
+ * @param memory_words Pointer to store the number of memory words.
+ * @return TRUE if the string is an integer between IC_START + 1 and MAX_MEMORY_WORDS, FALSE otherwise.
+ */
+static Boolean parse_memory_words(const char *str, int *memory_words) {
+    if (is_valid_integer(str) == FALSE || my_atoi(str) <= IC_START || my_atoi(str) > MAX_MEMORY_WORDS) {
+        return FALSE;
     }
-}
\ No newline at end of file
+    *memory_words = my_atoi(str);
+    return TRUE;
+}
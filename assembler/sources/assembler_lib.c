@@ -0,0 +1,266 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include "../headers/assembler_lib.h"
+#include "../headers/phase_controller.h"
+#include "../headers/preprocessor.h"
+#include "../../structures/headers/context.h"
+#include "../../utils/headers/output_files.h"
+#include "../../utils/headers/utils.h"
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static void clear_output(AsmOutput *output);
+static void preprocess_buffer(AsmContext *ctx, const char *name, const char *source, size_t size,
+                              MacroTrie *macro_trie, LineBuffer *am_lines);
+static void assemble_am(AsmContext *ctx, const char *name, const LineBuffer *am_lines, MacroTrie *macro_trie,
+                        CmpData *cmp_data, AsmOutput *output);
+static Boolean encode_program(AsmContext *ctx, const LineBuffer *am_lines, const char *am_name,
+                              MacroTrie *macro_trie, CmpData *cmp_data, AsmOutput *output);
+static FILE *open_buffer(AsmBuffer *buffer);
+static void discard_buffer(AsmBuffer *buffer);
+static void take_records(AsmBuffer *buffer, RecordBuffer *records);
+/* ---------------------------------------------------------------------------------------
+ *                                   Head Function Of Library
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Assembles a source buffer entirely in memory - the source is read from the buffer, and the
+ * object, entry and extern contents are returned as buffers, together with the diagnostics.
+ * The source is assembled in a workspace of its own, released at the end.
+ *
+ * @param name The base name of the source, used in the diagnostics (as "<name>.as").
+ * @param source The content of the source (.as).
+ * @param size The size of the source in bytes.
+ * @param output Pointer to the structure that receives the outputs.
+ * @return The final status of the assembly process.
+ */
+Status assemble_buffer(const char *name, const char *source, size_t size, AsmOutput *output) {
+    AsmWorkspace workspace;     /* The workspace the source is assembled in */
+    AsmContext ctx;             /* Context for reporting a failure to create the workspace */
+    FILE *diagnostics = NULL;   /* Stream for the messages of the process */
+
+    if (init_workspace(&workspace, NULL, MEMORY_WORDS) == TRUE) {
+        assemble_buffer_in(&workspace, name, source, size, output);
+        free_workspace(&workspace);
+        return output->status;
+    }
+
+    /* Report the memory allocation failure as the assembly process would */
+    clear_output(output);
+    if (!(diagnostics = open_buffer(&output->diagnostics))) return FATAL_ERROR;
+    init_context(&ctx, diagnostics);
+    set_general_error(&ctx, MEMORY_ALLOCATION_ERROR);
+    print_error_summery(&ctx, name);
+    output->status = get_status(&ctx);
+    free_context(&ctx);
+    fclose(diagnostics);
+    return output->status;
+}
+
+/**
+ * Assembles a source buffer in memory, the same as `assemble_buffer`, in the specified
+ * workspace. The workspace is reset at the end, so a caller that assembles many sources
+ * keeps its arenas, tables and buffers warm between them.
+ *
+ * @param workspace The workspace to assemble the source in. Its memory size limits the program.
+ * @param name The base name of the source, used in the diagnostics (as "<name>.as").
+ * @param source The content of the source (.as).
+ * @param size The size of the source in bytes.
+ * @param output Pointer to the structure that receives the outputs.
+ * @return The final status of the assembly process.
+ */
+Status assemble_buffer_in(AsmWorkspace *workspace, const char *name, const char *source, size_t size,
+                          AsmOutput *output) {
+    AsmContext *ctx = &workspace->ctx;  /* The context of the assembly process */
+    FILE *diagnostics = NULL;           /* Stream for the messages of the process */
+    double start;                       /* Start time of the preprocessor */
+
+    clear_output(output);
+
+    /* Without a diagnostics stream there is no way to report errors */
+    if (!(diagnostics = open_buffer(&output->diagnostics))) return FATAL_ERROR;
+    ctx->output = diagnostics;
+
+    /* --------------------------------- Preprocess source --------------------------------- */
+    start = stats_clock();
+    preprocess_buffer(ctx, name, source, size, &workspace->macro_trie, &workspace->am_lines);
+    add_stage_time(&ctx->stats, STAGE_PREPROCESSOR, start);
+
+    /* ------------------- Continue processing only if no error occurred ------------------- */
+    if (get_status(ctx) == ERROR_FREE_FILE) {
+        assemble_am(ctx, name, &workspace->am_lines, &workspace->macro_trie, &workspace->cmp_data, output);
+    }
+
+    /* Print process summery */
+    print_error_summery(ctx, name);
+    output->status = get_status(ctx);
+    output->stats = ctx->stats;
+
+    /* Reset the workspace for the next source */
+    reset_workspace(workspace);
+    ctx->output = NULL;
+    fclose(diagnostics);
+    return output->status;
+}
+
+/**
+ * Frees the buffers of the specified output and resets them to empty buffers.
+ *
+ * @param output Pointer to the output to be freed.
+ */
+void free_asm_output(AsmOutput *output) {
+    discard_buffer(&output->object);
+    discard_buffer(&output->entries);
+    discard_buffer(&output->externals);
+    discard_buffer(&output->diagnostics);
+}
+
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Resets all the outputs to empty buffers, with a fatal status.
+ *
+ * @param output Pointer to the output to be reset.
+ */
+static void clear_output(AsmOutput *output) {
+    output->object.data = output->entries.data = output->externals.data = NULL;
+    output->object.size = output->entries.size = output->externals.size = 0;
+    output->diagnostics.data = NULL;
+    output->diagnostics.size = 0;
+    output->status = FATAL_ERROR;
+    reset_stats(&output->stats);
+}
+
+/**
+ * Preprocesses the source buffer into the specified line buffer.
+ *
+ * @param ctx The context of the assembly process.
+ * @param name The base name of the source.
+ * @param source The content of the source (.as).
+ * @param size The size of the source in bytes.
+ * @param macro_trie A trie structure containing macro definitions for preprocessing.
+ * @param am_lines The line buffer that receives the preprocessed source.
+ */
+static void preprocess_buffer(AsmContext *ctx, const char *name, const char *source, size_t size,
+                              MacroTrie *macro_trie, LineBuffer *am_lines) {
+    char *source_name = NULL; /* The source name, for error reporting */
+
+    if (!create_new_file_name(name, &source_name, ".as")) {
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+        return;
+    }
+
+    /* The lines are read as spans of the buffer - the source is never modified */
+    preprocess_source(ctx, source, size, am_lines, source_name, macro_trie);
+    free(source_name);
+}
+
+/**
+ * Conducts the assembler phases on the preprocessed lines, and writes the object, entry and extern
+ * contents to the output. The entry and extern contents are kept only if the phases succeeded
+ * and they have lines - the same as the files of the command line assembler.
+ *
+ * @param ctx The context of the assembly process.
+ * @param name The base name of the source.
+ * @param am_lines The preprocessed source.
+ * @param macro_trie The trie structure containing macro definitions.
+ * @param cmp_data The empty data structure that the encoded program is written to.
+ * @param output Pointer to the structure that receives the outputs.
+ */
+static void assemble_am(AsmContext *ctx, const char *name, const LineBuffer *am_lines, MacroTrie *macro_trie,
+                        CmpData *cmp_data, AsmOutput *output) {
+    char *am_name = NULL;           /* The am name, for error reporting */
+
+    if (!create_new_file_name(name, &am_name, ".am")) {
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+        return;
+    }
+
+    if (encode_program(ctx, am_lines, am_name, macro_trie, cmp_data, output) == TRUE) {
+        ctx->stats.bytes_written += (long)(cmp_data->entries.size + cmp_data->externals.size);
+        take_records(&output->entries, &cmp_data->entries);
+        take_records(&output->externals, &cmp_data->externals);
+    }
+
+    free(am_name);
+}
+
+/**
+ * Conducts the assembler phases on the preprocessed lines, and prints the memory images to the object
+ * buffer if both phases were successful.
+ *
+ * @param ctx The context of the assembly process.
+ * @param am_lines The preprocessed source.
+ * @param am_name The name of the am source, used for error reporting.
+ * @param macro_trie The trie structure containing macro definitions.
+ * @param cmp_data The initialized data structure that the encoded program is written to.
+ * @param output Pointer to the structure that receives the outputs.
+ * @return TRUE if the object content was created, FALSE otherwise.
+ */
+static Boolean encode_program(AsmContext *ctx, const LineBuffer *am_lines, const char *am_name,
+                              MacroTrie *macro_trie, CmpData *cmp_data, AsmOutput *output) {
+    FILE *object_file = NULL; /* Stream writing the object buffer */
+    double start;             /* Start time of the output stage */
+    Boolean printed;          /* Flag indicating if the memory images were printed */
+
+    if (phases_controller(ctx, am_lines, am_name, macro_trie, cmp_data, 1) == FALSE) return FALSE;
+
+    start = stats_clock();
+    if (!(object_file = open_buffer(&output->object))) {
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+        return FALSE;
+    }
+    printed = print_memory_images(object_file, cmp_data);
+    fclose(object_file);
+    add_stage_time(&ctx->stats, STAGE_OUTPUT, start);
+
+    if (printed == FALSE) {
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+        return FALSE;
+    }
+    ctx->stats.bytes_written += (long)output->object.size;
+    return TRUE;
+}
+
+/**
+ * Opens a stream that writes to the specified buffer. The content of the buffer is available
+ * after the stream is flushed or closed.
+ *
+ * @param buffer Pointer to the buffer to write to.
+ * @return The opened stream, or NULL if memory allocation failed.
+ */
+static FILE *open_buffer(AsmBuffer *buffer) {
+    return open_memstream(&buffer->data, &buffer->size);
+}
+
+/**
+ * Frees the content of the specified buffer and resets it to an empty buffer.
+ *
+ * @param buffer Pointer to the buffer to be freed.
+ */
+static void discard_buffer(AsmBuffer *buffer) {
+    free(buffer->data);
+    buffer->data = NULL;
+    buffer->size = 0;
+}
+
+/**
+ * Moves the entry or extern lines to the specified buffer, if there are any - the lines are
+ * already terminated by '\0', so they are handed over without a copy.
+ *
+ * @param buffer Pointer to the buffer that receives the lines.
+ * @param records The lines, left empty and without memory.
+ */
+static void take_records(AsmBuffer *buffer, RecordBuffer *records) {
+    if (records->size == 0) return;
+
+    buffer->data = records->text;
+    buffer->size = records->size;
+    records->text = NULL;
+    records->size = 0;
+    records->capacity = 0;
+}
@@ -0,0 +1,295 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../headers/build_cache.h"
+#include "../../utils/headers/frames.h"
+#include "../../utils/headers/output_files.h"
+#include "../../utils/headers/source_file.h"
+#include "../../utils/headers/utils.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Length of the fields of a key other than the file name - the version, options and source hash */
+#define KEY_FIELDS_LENGTH (64 + CONTENT_HASH_LENGTH)
+/* Largest frame of an entry */
+#define MAX_ENTRY_FRAME_SIZE (256UL * 1024 * 1024)
+/* Number of frames of an entry - status, counts, messages, up to 4 output files and the end */
+#define MAX_ENTRY_FRAMES 8
+/* Number of frames of an entry before the output files */
+#define ENTRY_HEADER_FRAMES 3
+/* Length of the counts frame and of the suffix of a temporary entry */
+#define SHORT_FIELD_LENGTH 32
+/* ---------------------------------------------------------------------------------------
+ *                                         Structures
+ * --------------------------------------------------------------------------------------- */
+/* Structure representing one frame of an entry */
+typedef struct {
+    char tag[FRAME_TAG_LENGTH]; /* The tag - the kind of the frame, or the extension of an output file */
+    char *data;                 /* The data of the frame */
+    size_t size;                /* The size of the data in bytes */
+} EntryFrame;
+/* ---------------------------------------------------------------------------------------
+ *                                         Variables
+ * --------------------------------------------------------------------------------------- */
+/* The extensions of the output files that an entry may hold */
+static const char *output_extensions[] = {".am", ".ob", ".ent", ".ext", NULL};
+/* The extensions of the output files that the assembly removes when it does not create them */
+static const char *record_extensions[] = {".ent", ".ext", NULL};
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static Boolean restore_frames(AsmContext *ctx, const EntryFrame *frames, int count, const char *file_name);
+static Boolean is_output_extension(const char *tag);
+static Boolean has_frame(const EntryFrame *frames, int count, const char *tag);
+static Boolean write_output_frame(FILE *entry, const char *file_name, const char *extension);
+static char *entry_path(const char *cache_dir, const char *key, const char *suffix);
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Calculates the key of a file in the build cache. The source is hashed first, and its hash is
+ * hashed again with the version, the options and the base name - so the key of a file costs a
+ * single pass over its source.
+ *
+ * @param file_name The base name of the file without extension.
+ * @param source The content of the source file, as it is assembled.
+ * @param options The command line options.
+ * @param key Buffer to store the key.
+ * @return TRUE if the key was calculated, FALSE if memory allocation failed.
+ */
+Boolean cache_key(const char *file_name, const SourceFile *source, const AsmOptions *options,
+                  char key[CACHE_KEY_LENGTH]) {
+    char digest[CONTENT_HASH_LENGTH]; /* The hash of the source */
+    char *fields = NULL;              /* The fields that the key is the hash of */
+
+    hash_content(source->text, source->size, 0, digest);
+
+    if (!(fields = (char *)malloc(strlen(file_name) + KEY_FIELDS_LENGTH))) return FALSE;
+    sprintf(fields, "%s\n%d\n%d\n%s\n%s", ASSEMBLER_VERSION, options->memory_words, (int)options->emit_am,
+            digest, file_name);
+    hash_content(fields, strlen(fields), 0, key);
+    free(fields);
+    return TRUE;
+}
+
+/**
+ * Restores the outputs of a file from the build cache. The entry is read whole before any
+ * file is written, so an invalid entry changes nothing.
+ *
+ * @param ctx The context of the file's assembly process.
+ * @param cache_dir The directory of the build cache.
+ * @param key The key of the file.
+ * @param file_name The base name of the file without extension.
+ * @return TRUE if the outputs were restored, FALSE otherwise.
+ */
+Boolean restore_cache_entry(AsmContext *ctx, const char *cache_dir, const char *key, const char *file_name) {
+    EntryFrame frames[MAX_ENTRY_FRAMES]; /* The frames of the entry */
+    int count = 0;                       /* Number of frames read */
+    Boolean restored = FALSE;            /* Flag indicating if the outputs were restored */
+    FILE *entry;                         /* The entry file */
+    char *path;                          /* The path of the entry */
+    int i;
+
+    if (!(path = entry_path(cache_dir, key, ""))) return FALSE;
+    entry = fopen(path, "rb");
+    free(path);
+    if (!entry) return FALSE;
+
+    /* The entry is complete only if it ends with its end frame */
+    while (count < MAX_ENTRY_FRAMES &&
+           read_frame(entry, frames[count].tag, &frames[count].data, &frames[count].size,
+                      MAX_ENTRY_FRAME_SIZE) == TRUE) {
+        if (strcmp(frames[count++].tag, "END") == 0) {
+            restored = restore_frames(ctx, frames, count, file_name);
+            break;
+        }
+    }
+    fclose(entry);
+
+    for (i = 0; i < count; i++) free(frames[i].data);
+    return restored;
+}
+
+/**
+ * Keeps the outputs of an assembled file in the build cache, as a single entry file of frames:
+ * the status, the error and warning counts, the messages, a frame for every output file
+ * (tagged with its extension) and an end frame.
+ *
+ * @param ctx The context of the file's assembly process, at the end of the assembly.
+ * @param cache_dir The directory of the build cache, created if it does not exist.
+ * @param key The key of the file.
+ * @param file_name The base name of the file without extension.
+ * @param messages The messages that were printed for the file.
+ * @param size The size of the messages in bytes.
+ * @param extensions The extensions of the output files that the assembly created, terminated by NULL.
+ */
+void store_cache_entry(const AsmContext *ctx, const char *cache_dir, const char *key, const char *file_name,
+                       const char *messages, size_t size, const char *extensions[]) {
+    const char *status = status_name(ctx->program_status.status); /* The status of the file */
+    char field[SHORT_FIELD_LENGTH];  /* The counts frame, then the suffix of the temporary entry */
+    char *path = NULL, *temp = NULL; /* The paths of the entry and of the temporary entry */
+    FILE *entry = NULL;              /* The temporary entry */
+    Boolean written;                 /* Flag indicating if the entry was written */
+    int i;
+
+    mkdir(cache_dir, 0777); /* The directory usually exists already */
+
+    sprintf(field, ".tmp%ld", (long)getpid());
+    if (!(path = entry_path(cache_dir, key, "")) || !(temp = entry_path(cache_dir, key, field)) ||
+        !(entry = fopen(temp, "wb"))) {
+        free(path);
+        free(temp);
+        return;
+    }
+
+    sprintf(field, "%d %d", ctx->program_status.error_counter, ctx->program_status.warning_counter);
+    written = (write_frame(entry, "STATUS", status, strlen(status)) == TRUE &&
+               write_frame(entry, "COUNTS", field, strlen(field)) == TRUE &&
+               write_frame(entry, "DIAGNOSTICS", messages, size) == TRUE) ? TRUE : FALSE;
+    for (i = 0; extensions[i] && written == TRUE; i++) {
+        written = write_output_frame(entry, file_name, extensions[i]);
+    }
+    if (written == TRUE) written = write_frame(entry, "END", NULL, 0);
+    if (fclose(entry) != 0) written = FALSE;
+
+    /* The entry appears whole, or not at all */
+    if (written == FALSE || rename(temp, path) != 0) remove(temp);
+    free(path);
+    free(temp);
+}
+
+/**
+ * Static function - validates the frames of an entry and restores them: writes the output files,
+ * prints the messages and sets the status and counters of the context. An entry or extern file
+ * that the entry does not hold is removed, as the assembly of the file removes it.
+ *
+ * @param ctx The context of the file's assembly process.
+ * @param frames The frames of the entry, ending with the end frame.
+ * @param count The number of frames.
+ * @param file_name The base name of the file without extension.
+ * @return TRUE if the entry is valid and its files were written, FALSE otherwise.
+ */
+static Boolean restore_frames(AsmContext *ctx, const EntryFrame *frames, int count, const char *file_name) {
+    Status status;           /* The status of the file */
+    int errors, warnings;    /* The counts of the file */
+    char *output_name;       /* The name of an output file */
+    ErrorCode write_status;  /* The result of writing or removing an output file */
+    long bytes = 0;          /* Number of bytes of the output files */
+    int i;
+
+    if (count < ENTRY_HEADER_FRAMES + 1 || strcmp(frames[0].tag, "STATUS") != 0 ||
+        strcmp(frames[1].tag, "COUNTS") != 0 || strcmp(frames[2].tag, "DIAGNOSTICS") != 0 ||
+        sscanf(frames[1].data, "%d %d", &errors, &warnings) != 2) {
+        return FALSE;
+    }
+    if (strcmp(frames[0].data, status_name(ERROR_FREE_FILE)) == 0) status = ERROR_FREE_FILE;
+    else if (strcmp(frames[0].data, status_name(ERROR_IN_FILE)) == 0) status = ERROR_IN_FILE;
+    else return FALSE;
+
+    for (i = ENTRY_HEADER_FRAMES; i < count - 1; i++) {
+        if (is_output_extension(frames[i].tag) == FALSE) return FALSE;
+    }
+
+    /* ------------------------------- Write the output files ------------------------------- */
+    for (i = ENTRY_HEADER_FRAMES; i < count - 1; i++) {
+        if (!create_new_file_name(file_name, &output_name, frames[i].tag)) return FALSE;
+        write_status = write_content(output_name, frames[i].data, frames[i].size);
+        free(output_name);
+        if (write_status != NO_ERROR) return FALSE;
+        bytes += (long)frames[i].size;
+    }
+    for (i = 0; record_extensions[i]; i++) {
+        if (has_frame(frames, count, record_extensions[i]) == TRUE) continue;
+        if (!create_new_file_name(file_name, &output_name, record_extensions[i])) return FALSE;
+        write_status = remove_output_file(output_name);
+        free(output_name);
+        if (write_status != NO_ERROR) return FALSE;
+    }
+
+    /* ------------------------ Print the messages and set the status ------------------------ */
+    fwrite(frames[2].data, 1, frames[2].size, ctx->output);
+    ctx->program_status.status = status;
+    ctx->program_status.error_counter = errors;
+    ctx->program_status.warning_counter = warnings;
+    ctx->stats.bytes_written += bytes;
+    return TRUE;
+}
+
+/**
+ * Static function - checks if a tag is the extension of an output file.
+ *
+ * @param tag The tag of a frame.
+ * @return TRUE if the tag is one of the output extensions, FALSE otherwise.
+ */
+static Boolean is_output_extension(const char *tag) {
+    int i;
+
+    for (i = 0; output_extensions[i]; i++) {
+        if (strcmp(tag, output_extensions[i]) == 0) return TRUE;
+    }
+    return FALSE;
+}
+
+/**
+ * Static function - checks if the frames of an entry hold the output file of an extension.
+ *
+ * @param frames The frames of the entry.
+ * @param count The number of frames.
+ * @param tag The extension of the output file.
+ * @return TRUE if one of the frames has the tag, FALSE otherwise.
+ */
+static Boolean has_frame(const EntryFrame *frames, int count, const char *tag) {
+    int i;
+
+    for (i = ENTRY_HEADER_FRAMES; i < count; i++) {
+        if (strcmp(frames[i].tag, tag) == 0) return TRUE;
+    }
+    return FALSE;
+}
+
+/**
+ * Static function - writes the content of an output file as a frame of an entry.
+ *
+ * @param entry The entry file.
+ * @param file_name The base name of the file without extension.
+ * @param extension The extension of the output file.
+ * @return TRUE if the frame was written, FALSE if the file cannot be read or the frame written.
+ */
+static Boolean write_output_frame(FILE *entry, const char *file_name, const char *extension) {
+    char *output_name = NULL; /* The name of the output file */
+    SourceFile output;        /* The content of the output file */
+    Boolean written;          /* Flag indicating if the frame was written */
+
+    if (!create_new_file_name(file_name, &output_name, extension)) return FALSE;
+    if (open_source_file(output_name, &output) != NO_ERROR) {
+        free(output_name);
+        return FALSE;
+    }
+    free(output_name);
+
+    written = write_frame(entry, extension, output.text, output.size);
+    close_source_file(&output);
+    return written;
+}
+
+/**
+ * Static function - creates the path of an entry in the build cache.
+ *
+ * @param cache_dir The directory of the build cache.
+ * @param key The key of the entry.
+ * @param suffix A suffix of the path - empty for the entry itself.
+ * @return The path (should be freed), or NULL if memory allocation failed.
+ */
+static char *entry_path(const char *cache_dir, const char *key, const char *suffix) {
+    char *path = (char *)malloc(strlen(cache_dir) + strlen(key) + strlen(suffix) + 2);
+
+    if (path) sprintf(path, "%s/%s%s", cache_dir, key, suffix);
+    return path;
+}
@@ -0,0 +1,112 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include "../headers/assembler_controller.h"
+#include "../headers/server.h"
+#include "../../utils/headers/frames.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Largest working directory that is sent to the server */
+#define MAX_CWD_LENGTH 4096
+/* Largest frame of a reply */
+#define MAX_REPLY_SIZE (256UL * 1024 * 1024)
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static Boolean assemble_remote(int fd, int argc, char* argv[]);
+static Boolean send_request(FILE *out, int argc, char* argv[]);
+/* ---------------------------------------------------------------------------------------
+ *                              Main Method To Launch The Client
+ * --------------------------------------------------------------------------------------- */
+/**
+ * A drop-in client of the assembler server - takes the same command line as `assembler_exe`
+ * and prints the same messages, but the files are assembled by the server listening on the
+ * socket named by the ASSEMBLER_SOCKET environment variable (DEFAULT_SOCKET_PATH by default),
+ * in the working directory of the client. When no server is listening, or the server fails
+ * before replying, the files are assembled by the client itself.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The array of command line arguments.
+ * @return 0, the same as `assembler_exe`.
+ */
+int main(int argc, char* argv[]) {
+    const char *path = getenv(SOCKET_PATH_VARIABLE); /* The socket of the server */
+    int fd = -1;                                     /* The connection to the server */
+
+    if (!path || *path == '\0') path = DEFAULT_SOCKET_PATH;
+    signal(SIGPIPE, SIG_IGN);
+
+    /* A server is never started through another server */
+    if ((argc < 2 || strcmp(argv[1], "--serve") != 0) && (fd = connect_server(path)) != -1 &&
+        assemble_remote(fd, argc, argv) == TRUE) {
+        return 0;
+    }
+
+    controller(argc, argv);
+    return 0;
+}
+
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Sends the command line to the server and prints the messages of the reply.
+ * The connection is closed at the end.
+ *
+ * @param fd The connection to the server.
+ * @param argc The number of command line arguments.
+ * @param argv The array of command line arguments.
+ * @return TRUE if the messages were printed, FALSE if nothing was received from the server.
+ */
+static Boolean assemble_remote(int fd, int argc, char* argv[]) {
+    char tag[FRAME_TAG_LENGTH];  /* The tag of the current frame */
+    char *data;                  /* The data of the current frame */
+    size_t size;                 /* The size of the data */
+    FILE *in, *out;              /* Streams of the connection */
+    Boolean printed = FALSE;     /* Flag indicating if the messages were printed */
+
+    in = fdopen(fd, "r");
+    out = in ? fdopen(dup(fd), "w") : NULL;
+
+    if (in && out && send_request(out, argc, argv) == TRUE) {
+        while (read_frame(in, tag, &data, &size, MAX_REPLY_SIZE) == TRUE && strcmp(tag, "END") != 0) {
+            if (strcmp(tag, "OUTPUT") == 0) {
+                fwrite(data, 1, size, stdout);
+                printed = TRUE;
+            }
+            free(data);
+        }
+        free(data);
+    }
+
+    if (out) fclose(out);
+    if (in) fclose(in);
+    else close(fd);
+    return printed;
+}
+
+/**
+ * Sends the command line to the server, with the working directory of the client.
+ *
+ * @param out The stream of the connection.
+ * @param argc The number of command line arguments.
+ * @param argv The array of command line arguments.
+ * @return TRUE if the request was sent, FALSE otherwise.
+ */
+static Boolean send_request(FILE *out, int argc, char* argv[]) {
+    char cwd[MAX_CWD_LENGTH]; /* The working directory of the client */
+    int i;                    /* Index for iterating through the arguments */
+
+    if (!getcwd(cwd, sizeof(cwd)) || write_frame(out, "CWD", cwd, strlen(cwd)) == FALSE) return FALSE;
+    for (i = 1; i < argc; i++) {
+        if (write_frame(out, "ARG", argv[i], strlen(argv[i])) == FALSE) return FALSE;
+    }
+    return (write_frame(out, "END", NULL, 0) == TRUE && fflush(out) == 0) ? TRUE : FALSE;
+}
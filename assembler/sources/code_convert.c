@@ -3,14 +3,41 @@
  * --------------------------------------------------------------------------------------- */
 #include "../headers/code_convert.h"
 #include "../../utils/headers/utils.h"
-#include "../../utils/headers/output_files.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Shift of a field that ends at the specified bit position of a word */
+#define FIELD_SHIFT(end) (WORD_END_POS - (end))
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static Word *current_word(MemoryImage *memory_img, MemoryImageType image_type);
 /* ---------------------------------------------------------------------------------------
  *                                         Functions
  * --------------------------------------------------------------------------------------- */
+/**
+ * Checks if an integer value can be written to the field between the start and end positions
+ * of a word - negative values are written in two's complement.
+ *
+ * @param start The starting bit position.
+ * @param end The ending bit position.
+ * @param value The integer value.
+ * @return TRUE if the value fits the field, FALSE otherwise.
+ */
+Boolean fits_int_code(int start, int end, int value) {
+    int width = end - start + 1; /* Length of the field in bits */
+
+    /* Ensure the range is within a single word's limit */
+    if (width > WORD_END_POS + 1) return FALSE;
+
+    /* Check if the value can be represented in the field (two's complement) */
+    return (value < -(1 << width) || value >= (1 << width)) ? FALSE : TRUE;
+}
+
 /**
  * Sets multiple bits in the specified section of the memory image based on the given integer
- * value. The Function converts the given integer in base 10 to base 2 and writes the bits
- * in the memory image.
+ * value. The value is written to the field between the start and end positions with a single
+ * shift and mask - negative values are written in two's complement.
  *
  * @param start The starting bit position.
  * @param end The ending bit position.
@@ -20,20 +47,15 @@
  *                  or the code part.
  */
 Boolean set_int_code(int start, int end, int value, MemoryImage *memory_img, MemoryImageType image_type) {
-    int i;                              /* Variable to iterate trough loop */
-    int bit_per_line = NUM_OF_BYTES * BYTE_SIZE; /* Length of word in bits */
-
-    /* Ensure the range is within a single line's limit */
-    if ((end - start + 1) > bit_per_line) return FALSE;
+    int width = end - start + 1; /* Length of the field in bits */
+    Word *word;                 /* The word to write to */
 
-    /* Check if the value can be represented in 15 bits (two's complement) */
-    if (value < -(1 << (end-start+1)) || value >= (1 << (end-start+1))) return FALSE;
+    /* The value must fit the field */
+    if (fits_int_code(start, end, value) == FALSE) return FALSE;
 
-    /* Encode the bits */
-    for (i = start; i <= end; i++) {
-        if (value & (1 << (end - i))) {
-            set_bit(i, 1, memory_img, image_type);
-        }
+    /* Encode the field */
+    if ((word = current_word(memory_img, image_type)) != NULL) {
+        *word |= (Word)((value & ((1 << width) - 1)) << FIELD_SHIFT(end));
     }
     return TRUE;
 }
@@ -48,95 +70,94 @@ Boolean set_int_code(int start, int end, int value, MemoryImage *memory_img, Mem
  *                  or the code part.
  */
 void set_bit(int i, int value, MemoryImage *memory_img, MemoryImageType image_type) {
-    int byteIndex = i / BYTE_SIZE;                       /* Calculate the byte index */
-    int bitOffset = i % BYTE_SIZE;        /* Calculate the bit index within the byte */
-    char mask = (char)(1 << (BYTE_SIZE - 1 - bitOffset)); /* Create mask accordingly */
-    int pos;                             /* Writing position within the memory image */
+    Word mask = (Word)(1 << FIELD_SHIFT(i)); /* Mask of the bit */
+    Word *word = current_word(memory_img, image_type);
+
+    if (!word) return;
 
-    switch (image_type) { /* Determine the writing position */
-        case CODE_IMAGE: pos = memory_img->code_pos;
-        break;
-        case DATA_IMAGE: pos = memory_img->data_pos;
-        break;
+    if (value) {
+        *word |= mask;          /* Set bit to 1 */
+    } else {
+        *word &= (Word)~mask;   /* Clear bit to 0 */
     }
+}
 
-    /* If memory image is not ran out of storage */
-    if (memory_img->code_count < MEMORY_CAPACITY) {
-        if (value) {
-            memory_img->lines[pos][byteIndex] |= mask;  /* Set bit to 1 */
-        } else {
-            memory_img->lines[pos][byteIndex] &= ~mask; /* Clear bit to 0 */
-        }
+/**
+ * Static function - retrieves the word at the writing position of the specified section.
+ *
+ * @param memory_img Pointer to the memory image structure.
+ * @param image_type The image type, indicating the section: the data part or the code part.
+ * @return Pointer to the word, or NULL if the memory image ran out of storage.
+ */
+static Word *current_word(MemoryImage *memory_img, MemoryImageType image_type) {
+    if (image_type == CODE_IMAGE) {
+        /* Memory image ran out of storage */
+        return (memory_img->code_pos < memory_img->code_size) ? &memory_img->code[memory_img->code_pos] : NULL;
     }
+    return (memory_img->data_pos < memory_img->data_size) ? &memory_img->data[memory_img->data_pos] : NULL;
 }
 
 /**
- * Converts a 15-bit word to an unsigned integer in octal representation.
+ * Converts a 15-bit word to an unsigned integer, for printing in octal representation.
  *
  * @param word The 15-bit word to convert.
- * @return The octal representation of the word as an unsigned integer.
+ * @return The value of the word as an unsigned integer.
  */
-unsigned int convert_to_octal(const char *word) {
-    unsigned int value = 0; /* The octal representation */
-    int i;           /* Variable to iterate trough loop */
-
-    for (i = 0; i < LAST_WORD_BIT; i++) {
-        int byteIndex = i / BYTE_SIZE; /* Calculate the byte index */
-        int bitOffset = i % BYTE_SIZE; /* Calculate the bit index within the byte */
-        value = (value << 1) | ((word[byteIndex] >> (BYTE_SIZE - 1 - bitOffset)) & 1);
-    }
-    return value;
+unsigned int convert_to_octal(Word word) {
+    return (unsigned int)(word & WORD_MASK);
 }
 
 /**
- * Encodes an immediate address mode value into the code memory image.
+ * Encodes an immediate address mode value into the code memory image. The value is checked by
+ * the first phase before it is encoded.
  *
  * @param num The immediate value to encode.
  * @param memory_img Pointer to the memory image structure.
- * @param node Pointer to ASTNode for error printing.
  */
-void code_immediate_addr_mode(int num, MemoryImage *memory_img, ASTNode *node) {
-    int end = IMMEDIATE_DIRECTIVE_BIT_SIZE - 1;
-
-    if (set_int_code(0, end, num, memory_img, CODE_IMAGE) == FALSE) {
-        /* Integer is out of range */
-        set_error(INTEGER_OUT_OF_RANGE, node->location);
-    }
+void code_immediate_addr_mode(int num, MemoryImage *memory_img) {
+    set_int_code(0, IMMEDIATE_DIRECTIVE_BIT_SIZE - 1, num, memory_img, CODE_IMAGE);
     set_bit(A, 1, memory_img, CODE_IMAGE);
 }
 
 /**
  * Encodes a direct address mode value into the memory image.
+ * The label is resolved by its ID - a single access to the label table.
  *
- * @param label The label to encode.
+ * @param ctx The context of the assembly process.
+ * @param label_id The ID of the label to encode.
  * @param cmp_data Pointer to the CmpData structure containing the memory
- *                 image and the label trie.
- * @return TRUE if the label was successfully encoded, FALSE otherwise.
+ *                 image and the label table.
+ * @return NO_ERROR if the label was successfully encoded, UNRECOGNIZED_LABEL if it is not defined,
+ *         or LABEL_ADDRESS_OUT_OF_RANGE if its address does not fit the operand word (a memory
+ *         larger than the field addresses).
  */
-Boolean code_direct_addr_mode(const char *label, CmpData *cmp_data) {
+ErrorCode code_direct_addr_mode(AsmContext *ctx, int label_id, CmpData *cmp_data) {
     /* Get the label type and address from the label table */
-    LabelType label_type = get_label_type(&cmp_data->label_table, label);
-    int address = get_label_addr(&cmp_data->label_table, label);
+    const LabelData *label = &cmp_data->label_table.labels[label_id];
     int end = IMMEDIATE_DIRECTIVE_BIT_SIZE - 1;
 
-    /* Label is not found */
-    if (address == -1) return FALSE;
+    /* Label is not defined */
+    if (label->label_type == UNDEFINED) return UNRECOGNIZED_LABEL;
 
     /* Encode the label address into the memory image */
-    set_int_code(0, end, address, &cmp_data->image, CODE_IMAGE);
+    if (set_int_code(0, end, resolve_label_address(cmp_data, label_id), &cmp_data->image, CODE_IMAGE) == FALSE) {
+        return LABEL_ADDRESS_OUT_OF_RANGE;
+    }
 
-    if (label_type == EXTERNAL) {
-        /* Set the external bit and write the label to the extern file */
+    if (label->label_type == EXTERNAL) {
+        /* Set the external bit and add the label to the lines of the extern file */
         set_bit(E, 1, &cmp_data->image, CODE_IMAGE);
-        write_label(label, cmp_data->image.code_pos + IC_START, cmp_data->extern_file.file);
-        cmp_data->extern_file.delete = FALSE;  /* Set flag to false - non-empty file should not be deleted */
+        if (add_label_record(&cmp_data->externals, label_name(&cmp_data->label_table, label_id),
+                             cmp_data->image.code_pos + IC_START) == FALSE) {
+            set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+        }
     } else {
         /* Set the relocatable bit */
         set_bit(R, 1, &cmp_data->image, CODE_IMAGE);
     }
 
     /* Process executed successfully */
-    return TRUE;
+    return NO_ERROR;
 }
 
 /**
@@ -153,7 +174,8 @@ void code_register_addr_mode(int reg_num, MemoryImage *memory_img, int position)
 }
 
 /**
- * Encodes a character into the data place in the memory image as its ASCII value.
+ * Encodes a character into the data place in the memory image as its ASCII value, and moves the
+ * data writing position to the next word.
  *
  * @param c The character to encode.
  * @param memory_img Pointer to the memory image structure.
@@ -166,46 +188,37 @@ void set_char_code(char c, MemoryImage *memory_img) {
 
     /* Set the binary image of the ASCII value using set_int_code */
     set_int_code(0, WORD_END_POS, ascii_value, memory_img, DATA_IMAGE);
-    updt_data_counter(memory_img);
+    memory_img->data_pos++;
 }
 
 /**
- * Encodes a list of data operands into the memory image at the data memory section.
+ * Encodes a list of data operands into the memory image at the data memory section, from the
+ * data writing position on. The operands are checked by the first phase before they are encoded.
  *
  * @param node The AST node containing the data operands.
  * @param memory_image Pointer to the memory image structure.
  */
-void code_data(ASTNode *node, MemoryImage *memory_image) {
-    DirNode *current = node->specific.directive.operands;
+void code_data(const ASTNode *node, MemoryImage *memory_image) {
+    const DirNode *current = node->specific.directive.operands;
 
     while (current) {
-        /* Validate operand */
-        if (is_valid_integer(current->operand)) {
-            /* Code integer */
-            if (set_int_code(0, WORD_END_POS, my_atoi(current->operand),
-                             memory_image, DATA_IMAGE) == FALSE) {
-                /* Integer is out of range */
-                set_error(INTEGER_OUT_OF_RANGE, node->location);
-            }
-            updt_data_counter(memory_image); /* Update counter */
-        } else {
-            /* Not an integer */
-            set_error(NOT_INTEGER, node->location);
-        }
-        current = (DirNode *) current->next;
+        /* Code integer */
+        set_int_code(0, WORD_END_POS, my_atoi(current->operand), memory_image, DATA_IMAGE);
+        memory_image->data_pos++;
+        current = (const DirNode *) current->next;
     }
 }
 
 /**
- * Encodes a string operand into the data memory image.
+ * Encodes a string operand into the data memory image, from the data writing position on.
  *
  * @param node The AST node containing the string operand.
  * @param memory_img Pointer to the memory image structure.
  */
-void code_string(ASTNode *node, MemoryImage *memory_img) {
-    char *str;  /* Variable to hold the string */
+void code_string(const ASTNode *node, MemoryImage *memory_img) {
+    const char *str;  /* Variable to hold the string */
     size_t str_length;      /* String's length */
-    int i; /* Variable to iterate through loop */
+    size_t i; /* Variable to iterate through loop */
 
     /* Get the string */
     str = node->specific.directive.operands->operand;
@@ -213,62 +226,8 @@ void code_string(ASTNode *node, MemoryImage *memory_img) {
     /* Get the string's length */
     str_length = strlen(str);
 
-    /* Code each char of the string */
+    /* Code each char of the string, with the null-terminator */
     for (i = 0; i <= str_length; i++) {
         set_char_code(str[i], memory_img);
     }
 }
-
-/**
- * Marks this word as unresolved by setting the last bit of the word to 1.
- * This mark will indicate to the second phase that this word should be encoded.
- *
- * @param code_img Pointer to the memory image structure.
- */
-void mark_word(MemoryImage *code_img) {
-    set_bit(LAST_WORD_BIT, 1, code_img, CODE_IMAGE);
-}
-
-/**
- * Unmarks the last bit of the specified word in the memory image.
- * Indicates that the word is encoded.
- *
- * @param code_img Pointer to the memory image structure.
- * @param line The line number to unmark.
- */
-void unmark_word(MemoryImage *code_img, int line) {
-    code_img->code_pos = line; /* Set writer to line */
-    set_bit(LAST_WORD_BIT, 0, code_img, CODE_IMAGE);
-}
-
-/**
- * Retrieves the first marked word in the memory image.
- * Going over the memory image with static variable for avoiding multiple
- * unnecessary iteration. The variable is being reset after each file.
- *
- * @param memory_img Pointer to the memory image structure.
- * @param reset Flag indicating if a reset of the static variable should occur.
- * @return The index of the first marked line, or -1 if no marked line is found.
- */
-int get_marked_line(MemoryImage *memory_img, Boolean reset) {
-    static int i = 0;                  /* Variable to iterate through loop */
-    int byteIndex = LAST_WORD_BIT / BYTE_SIZE; /* Calculate the byte index */
-    int bitOffset = LAST_WORD_BIT % BYTE_SIZE;  /* Calculate the bit index */
-
-    /* Create the relevant mask */
-    char mask = (char)(1 << (BYTE_SIZE - 1 - bitOffset));
-
-    /* Reset the static value if specified */
-    if (reset == TRUE) {
-        i = 0;
-        return -1;
-    }
-
-    /* Go through the memory image and fine the first unresolved word */
-    while (i < memory_img->code_count) {
-        if ((memory_img->lines[i][byteIndex] & mask) != 0) return i;
-        i++;
-    }
-
-    return -1; /* No marked word found */
-}
\ No newline at end of file
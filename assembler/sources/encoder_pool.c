@@ -0,0 +1,201 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <pthread.h>
+#include "../headers/encoder_pool.h"
+#include "../headers/first_phase.h"
+/* ---------------------------------------------------------------------------------------
+ *                                         Structures
+ * --------------------------------------------------------------------------------------- */
+/* A thread of the pool */
+typedef struct {
+    pthread_t thread;    /* The thread */
+    EncoderPool *pool;   /* The pool of the thread */
+    int index;           /* Index of the thread - selects its part of the handed lines */
+} EncodeWorker;
+
+/*
+ * The lines are handed once per window, so the threads wait for them on a condition variable
+ * instead of spinning - an idle thread takes no processor time.
+ */
+struct EncoderPool {
+    MemoryImage image;       /* A copy of the memory image - its counters change while the threads run */
+    EncodeWorker *workers;   /* The threads */
+    int count;               /* Number of started threads */
+    pthread_mutex_t lock;    /* Guards the fields below */
+    pthread_cond_t handed;   /* Signalled when lines are handed, or when the threads should end */
+    pthread_cond_t encoded;  /* Signalled when the last thread encoded its part */
+    const EncodeJob *jobs;   /* The handed lines */
+    int jobs_count;          /* Number of handed lines */
+    unsigned long round;     /* Number of times lines were handed */
+    int pending;             /* Number of threads that did not encode their part of the lines yet */
+    Boolean stop;            /* Flag indicating if the threads should end */
+};
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static void *encode_worker(void *data);
+static void free_encoder_pool(EncoderPool *pool);
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Starts a pool of threads that encode lines into the specified memory image, with
+ * `first_phase_encoder`. The threads write the sections through a copy of the image, taken when
+ * the pool starts, so the calling thread may go on changing the counters of the image.
+ * If a thread cannot be started, the threads started before it are stopped - the lines are then
+ * encoded by the calling thread.
+ *
+ * @param threads The number of threads.
+ * @param image The memory image that the lines are encoded into.
+ * @return The pool, or NULL if memory allocation failed or a thread could not be started.
+ */
+EncoderPool *start_encoder_pool(int threads, const MemoryImage *image) {
+    EncoderPool *pool;
+    EncodeWorker *worker;
+
+    if (!(pool = (EncoderPool *)malloc(sizeof(EncoderPool)))) return NULL;
+    if (!(pool->workers = (EncodeWorker *)malloc((size_t)threads * sizeof(EncodeWorker)))) {
+        free(pool);
+        return NULL;
+    }
+    if (pthread_mutex_init(&pool->lock, NULL) != 0) {
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+    if (pthread_cond_init(&pool->handed, NULL) != 0) {
+        pthread_mutex_destroy(&pool->lock);
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+    if (pthread_cond_init(&pool->encoded, NULL) != 0) {
+        pthread_cond_destroy(&pool->handed);
+        pthread_mutex_destroy(&pool->lock);
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+    pool->image = *image;
+    pool->count = 0;
+    pool->jobs = NULL;
+    pool->jobs_count = 0;
+    pool->round = 0;
+    pool->pending = 0;
+    pool->stop = FALSE;
+
+    while (pool->count < threads) {
+        worker = &pool->workers[pool->count];
+        worker->pool = pool;
+        worker->index = pool->count;
+        if (pthread_create(&worker->thread, NULL, encode_worker, worker) != 0) break;
+        pool->count++;
+    }
+
+    if (pool->count < threads) {
+        free_encoder_pool(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+/**
+ * Hands the specified lines to the threads of the pool, a contiguous part of the lines to every
+ * thread, and returns at once. The parts have about the same number of lines.
+ *
+ * @param pool The pool.
+ * @param jobs The lines to encode.
+ * @param count The number of lines.
+ */
+void encode_jobs(EncoderPool *pool, const EncodeJob *jobs, int count) {
+    pthread_mutex_lock(&pool->lock);
+    pool->jobs = jobs;
+    pool->jobs_count = count;
+    pool->pending = pool->count;
+    pool->round++;
+    pthread_cond_broadcast(&pool->handed);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * Waits until the threads of the pool encoded the lines that were handed to them. The lock of
+ * the pool orders the words written by the threads before the return.
+ *
+ * @param pool The pool.
+ */
+void wait_encoder_pool(EncoderPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0) pthread_cond_wait(&pool->encoded, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * Stops the threads of the pool and frees it. The lines handed to the pool must have been
+ * waited for.
+ *
+ * @param pool The pool to be stopped.
+ */
+void stop_encoder_pool(EncoderPool *pool) {
+    free_encoder_pool(pool);
+}
+
+/**
+ * Static function - the loop of a thread of the pool. Waits for lines to be handed, encodes its
+ * part of them, and tells the calling thread when it is the last thread to be done.
+ *
+ * @param data The thread (EncodeWorker).
+ * @return NULL.
+ */
+static void *encode_worker(void *data) {
+    EncodeWorker *worker = (EncodeWorker *)data;
+    EncoderPool *pool = worker->pool;
+    unsigned long round = 0; /* The last round of lines that the thread encoded */
+    const EncodeJob *jobs;   /* The part of the lines of the thread */
+    int first;               /* Index of the first line of the part */
+    int count;               /* Number of lines of the part */
+    int i;
+
+    pthread_mutex_lock(&pool->lock);
+    while (TRUE) {
+        while (pool->stop == FALSE && pool->round == round) pthread_cond_wait(&pool->handed, &pool->lock);
+        if (pool->stop == TRUE) break;
+        round = pool->round;
+        first = (int)((long)pool->jobs_count * worker->index / pool->count);
+        count = (int)((long)pool->jobs_count * (worker->index + 1) / pool->count) - first;
+        jobs = pool->jobs + first;
+        pthread_mutex_unlock(&pool->lock);
+
+        for (i = 0; i < count; i++) {
+            first_phase_encoder(jobs[i].node, &pool->image, jobs[i].code_pos, jobs[i].data_pos);
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) pthread_cond_signal(&pool->encoded);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * Static function - ends the started threads of the pool and frees it.
+ *
+ * @param pool The pool to be freed.
+ */
+static void free_encoder_pool(EncoderPool *pool) {
+    int i;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = TRUE;
+    pthread_cond_broadcast(&pool->handed);
+    pthread_mutex_unlock(&pool->lock);
+    for (i = 0; i < pool->count; i++) pthread_join(pool->workers[i].thread, NULL);
+
+    pthread_cond_destroy(&pool->encoded);
+    pthread_cond_destroy(&pool->handed);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
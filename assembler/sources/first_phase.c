@@ -4,160 +4,178 @@
 #include "../../structures/headers/ast.h"
 #include "../../structures/headers/cmp_data.h"
 #include "../headers/code_convert.h"
+#include "../headers/first_phase.h"
+#include "../../utils/headers/utils.h"
 /* ---------------------------------------------------------------------------------------
  *                               Static Functions Prototypes
  * --------------------------------------------------------------------------------------- */
-static void handle_instruction(ASTNode *node, CmpData *cmp_data);
-static Boolean first_word(ASTNode *node, int command_index, MemoryImage *image);
-static Boolean code_first_word_addr(int command_index, MemoryImage *code_img, int addr_mode, int offset, int param);
-static void code_operands(ASTNode *node, CmpData *cmp_data);
-static void handle_directive(ASTNode *node, CmpData *cmp_data);
-static void handle_extern(ASTNode* node, CmpData* cmp_data);
-static void add_label(ASTNode *node, int address, CmpData *cmp_data);
+static void handle_instruction(AsmContext *ctx, ASTNode *node, CmpData *cmp_data);
+static Boolean valid_first_word(const ASTNode *node, int command_index);
+static void size_operands(AsmContext *ctx, ASTNode *node, CmpData *cmp_data);
+static void handle_directive(AsmContext *ctx, ASTNode *node, CmpData *cmp_data);
+static void size_data(AsmContext *ctx, ASTNode *node, MemoryImage *image);
+static void size_string(AsmContext *ctx, ASTNode *node, MemoryImage *image);
+static void handle_extern(AsmContext *ctx, ASTNode* node, CmpData* cmp_data);
+static Boolean add_entry_fixups(ASTNode *node, CmpData *cmp_data);
+static void add_label(AsmContext *ctx, ASTNode *node, int offset, CmpData *cmp_data);
+static void encode_instruction(const ASTNode *node, MemoryImage *image);
+static void encode_first_word(const ASTNode *node, int command_index, MemoryImage *image);
 
 /* ---------------------------------------------------------------------------------------
- *                              Head Function of First Phase
+ *                              Head Functions of First Phase
  * --------------------------------------------------------------------------------------- */
 /**
  * The `first_phase_analyzer` function analyzes a parsed line (ASTNode) during the first phase of assembly.
- * It determines the type of line and processes it accordingly with the helper functions.
+ * The line is sized with `first_phase_sizer` - which checks it and advances the counters - and
+ * its words are then written at the addresses it was given with `first_phase_encoder`.
+ * A line that the sizer found errors in is not encoded - no output is created for its file - nor
+ * is a line once the memory image is full.
  *
+ * @param ctx The context of the assembly process.
  * @param node The parsed line represented as an Abstract Syntax Tree (AST) node.
  * @param cmp_data The data structure holding various program-related data during assembly.
- * @return TRUE if the line is processed successfully, FALSE otherwise.
  */
-void first_phase_analyzer(ASTNode *node, CmpData *cmp_data) {
+void first_phase_analyzer(AsmContext *ctx, ASTNode *node, CmpData *cmp_data) {
+    int code_pos = cmp_data->image.code_count;                /* Address of the line in the code section */
+    int data_pos = cmp_data->image.data_count;                /* Address of the line in the data section */
+    int error_counter = ctx->program_status.error_counter;    /* Number of errors before the line */
+
+    first_phase_sizer(ctx, node, cmp_data);
+    if (ctx->program_status.error_counter == error_counter && cmp_data->image.full == FALSE) {
+        first_phase_encoder(node, &cmp_data->image, code_pos, data_pos);
+    }
+}
+
+/**
+ * The `first_phase_sizer` function conducts the first phase of a parsed line without writing its
+ * words: it checks the line, advances the counters of the memory image by the number of words the
+ * line takes, defines its label and records its label references, extern and entry declarations.
+ * All the errors and warnings of the first phase are reported by the sizer.
+ * The number of words of an instruction follows from its operation and the addressing modes of its
+ * operands - two register operands share a word - and that of a directive from its operands.
+ *
+ * @param ctx The context of the assembly process.
+ * @param node The parsed line represented as an Abstract Syntax Tree (AST) node.
+ * @param cmp_data The data structure holding various program-related data during assembly.
+ */
+void first_phase_sizer(AsmContext *ctx, ASTNode *node, CmpData *cmp_data) {
     /* Check if line is empty or comment */
     if (node->lineType == LINE_EMPTY || node->lineType == LINE_COMMENT) {
         return;
     }
     /* Handle operation line */
     if (node->lineType == LINE_INSTRUCTION) {
-        handle_instruction(node, cmp_data);
+        handle_instruction(ctx, node, cmp_data);
     } else { /* Handle directive line */
-        handle_directive(node, cmp_data);
+        handle_directive(ctx, node, cmp_data);
+    }
+}
+
+/**
+ * The `first_phase_encoder` function writes the words of a line that was sized without errors,
+ * from the addresses that the sizer gave it in the code and data sections. Only the words of the
+ * line are written - the counters of the memory image are not changed, so lines can be encoded in
+ * any order, and at the same time, once they are sized.
+ * The label operands are encoded by the second phase.
+ *
+ * @param node The parsed line represented as an Abstract Syntax Tree (AST) node.
+ * @param image The memory image that the words are written to.
+ * @param code_pos Address of the line in the code section.
+ * @param data_pos Address of the line in the data section.
+ */
+void first_phase_encoder(const ASTNode *node, const MemoryImage *image, int code_pos, int data_pos) {
+    MemoryImage view = *image; /* The memory image, with the writing positions of the line */
+
+    view.code_pos = code_pos;
+    view.data_pos = data_pos;
+    if (node->lineType == LINE_INSTRUCTION) {
+        encode_instruction(node, &view);
+    } else if (node->lineType == LINE_DIRECTIVE) {
+        if (node->specific.directive.operation == DATA) code_data(node, &view);
+        else if (node->specific.directive.operation == STRING) code_string(node, &view);
     }
 }
 
 /* ---------------------------------------------------------------------------------------
- *                                       Functions
+ *                                    Sizing Functions
  * --------------------------------------------------------------------------------------- */
 /**
- * Processes an instruction line during the first phase of assembly.
- * It validates the number of parameters, encodes the instruction, and updates the `CmpData` structure.
- * The instructions is coded in the image image, stored in the `CmpData` structure.
+ * Sizes an instruction line during the first phase of assembly.
+ * It validates the number of parameters and the addressing modes, and advances the code counter
+ * by the words of the instruction.
  *
+ * @param ctx The context of the assembly process.
  * @param node The parsed line represented as an ASTNode.
  * @param cmp_data The data structure holding various program-related data during assembly.
- * @return TRUE if the instruction is processed successfully, FALSE otherwise.
  */
-static void handle_instruction(ASTNode *node, CmpData *cmp_data) {
+static void handle_instruction(AsmContext *ctx, ASTNode *node, CmpData *cmp_data) {
     int ic_start = cmp_data->image.code_count; /* remember starting address */
     short command_index = node->specific.instruction.operation;
+    Boolean valid_addr; /* Flag indicating if the address modes are valid */
 
     /* Validate number of parameters */
     if (get_num_param(command_index) != node->specific.instruction.num_operands) {
-        set_error(INVALID_PARAM_NUMBER, node->location);
+        set_error(ctx, INVALID_PARAM_NUMBER, node->location);
     }
 
-    /* Code first word if the number of parameters is valid */
-    else if (first_word(node, command_index, &cmp_data->image) == FALSE) {
-        set_error(INVALID_PARAM_TYPE, node->location);
+    /* Count the first word if the number of parameters is valid */
+    else {
+        valid_addr = valid_first_word(node, command_index);
+        updt_code_counter(ctx, &cmp_data->image);
+        if (valid_addr == FALSE) set_error(ctx, INVALID_PARAM_TYPE, node->location);
     }
 
-    /* Code the second/third word */
-    code_operands(node, cmp_data);
+    /* Count the second/third word */
+    size_operands(ctx, node, cmp_data);
 
     /* Insert label if exists */
     if (node->label[0] != '\0' ){
-        /* Insert the address with the 100 offset (IC_START) */
-        add_label(node, ic_start+IC_START, cmp_data);
+        /* Insert the offset in the code section - the address is resolved when it is read */
+        add_label(ctx, node, ic_start, cmp_data);
     }
 }
 
 /**
- * Encodes the first word of an instruction into the image memory image.
- * It sets the operation image, addressing modes, and updates the memory image counter.
+ * Checks the addressing modes of the operands of an instruction, which are written to its first word.
  *
  * @param node The parsed line represented as an ASTNode.
  * @param command_index The index of the command in the operation table.
- * @param image The memory image where the encoded instruction will be stored.
- * @return TRUE if the first word is encoded successfully, FALSE otherwise.
+ * @return TRUE if the addressing modes are valid for the operation, FALSE otherwise.
  */
-static Boolean first_word(ASTNode *node, int command_index, MemoryImage *image) {
-    int opr_addr_dest;              /* Address mode of the destination operand */
-    int opr_addr_src;                    /* Address mode of the source operand */
-    Boolean valid_addr = TRUE; /* Flag indicating if the address mode is valid */
-                                            /* number of operands in this node */
-    int num_operands = node->specific.instruction.num_operands;
-
-    /* Code the operation name */
-    set_int_code(0, 3, command_index, image, CODE_IMAGE);
-
-    /* ARE default first word's field */
-    set_bit(A, 1, image, CODE_IMAGE);
+static Boolean valid_first_word(const ASTNode *node, int command_index) {
+    int num_operands = node->specific.instruction.num_operands; /* number of operands in this node */
 
-    /* Check if there is operands to code */
     if (num_operands == 1) {
-        opr_addr_dest = node->specific.instruction.operand1.adr_mode;
-        valid_addr = code_first_word_addr(command_index, image, opr_addr_dest, DEST_OFFSET, 1);
+        return valid_addr_mode(command_index, node->specific.instruction.operand1.adr_mode, 1);
     }
-    else if (num_operands == 2) {
-        opr_addr_dest = node->specific.instruction.operand2.adr_mode;
-        opr_addr_src = node->specific.instruction.operand1.adr_mode;
-        valid_addr = code_first_word_addr(command_index, image, opr_addr_dest, DEST_OFFSET, 2) &&
-                     code_first_word_addr(command_index, image, opr_addr_src, SRC_OFFSET, 1);
+    if (num_operands == 2) {
+        return (valid_addr_mode(command_index, node->specific.instruction.operand2.adr_mode, 2) &&
+                valid_addr_mode(command_index, node->specific.instruction.operand1.adr_mode, 1)) ? TRUE : FALSE;
     }
-
-    /* Update the code image counter */
-    updt_code_counter(image);
-    return valid_addr; /* Return if the first word is valid */
-}
-
-/**
- * Encodes the addressing mode of an operand into the first word
- * of the instruction.
- *
- * @param command_index The index of the command in the operation table.
- * @param code_img The memory image where the encoded instruction will be stored.
- * @param addr_mode The addressing mode of the operand.
- * @param offset The bit offset for the operand in the encoded word.
- * @param param The param order from the read line.
- * @return TRUE if the addressing mode is valid and encoded successfully, FALSE otherwise.
- */
-static Boolean code_first_word_addr(int command_index, MemoryImage *code_img, int addr_mode, int offset, int param) {
-    /* Encode only if the address mode of the operand is valid for the operation */
-    if (valid_addr_mode(command_index, addr_mode, param) == TRUE) {
-        set_bit(offset - addr_mode, 1, code_img, CODE_IMAGE);
-        return TRUE;
-    } else return FALSE;
+    return TRUE;
 }
 
 /**
  * Adds a label to the label table in the `CmpData` structure.
- * The label's address and type (INSTRUCTION or DIRECTIVE) are also specified.
+ * The label's offset in its section and type (INSTRUCTION or DIRECTIVE) are also specified.
+ * A label that is already defined is rejected by the insertion itself, without a lookup before it.
  *
+ * @param ctx The context of the assembly process.
  * @param node The parsed line represented as an ASTNode.
- * @param address The address of the label.
+ * @param offset The offset of the label in its section.
  * @param cmp_data The data structure holding various program-related data during assembly.
  * @return TRUE if the label is added successfully, FALSE otherwise.
  */
-static void add_label(ASTNode *node, int address, CmpData *cmp_data) {
+static void add_label(AsmContext *ctx, ASTNode *node, int offset, CmpData *cmp_data) {
     ErrorCode insert_status;
 
-    /* Check if label already defined */
-    if ((get_label_addr(&cmp_data->label_table,node->label) >= 0)) {
-        set_error(LABEL_DUPLICATE, node->location);
-        return;
-    }
-
     /* Add label to the label table according to it's type */
     switch (node->lineType) {
         case LINE_INSTRUCTION:
-            insert_status = insert_label(&cmp_data->label_table, node->label, address, INSTRUCTION);
+            insert_status = insert_label(&cmp_data->label_table, node->label, offset, INSTRUCTION);
             break;
         case LINE_DIRECTIVE:
-            insert_status = insert_label(&cmp_data->label_table, node->label, address, DIRECTIVE);
+            insert_status = insert_label(&cmp_data->label_table, node->label, offset, DIRECTIVE);
             break;
         default: /* Invalid line type */
             return;
@@ -166,26 +184,28 @@ static void add_label(ASTNode *node, int address, CmpData *cmp_data) {
     /* Check for errors */
     switch (insert_status) {
         case MEMORY_ALLOCATION_ERROR:
-            set_general_error(MEMORY_ALLOCATION_ERROR);
+            set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
             break;
         case INVALID_CHAR:
-            set_error(INVALID_CHAR_LABEL, node->location);
+            set_error(ctx, INVALID_CHAR_LABEL, node->location);
             break;
         case DUPLICATE:
-            set_error(LABEL_DUPLICATE, node->location);
+            set_error(ctx, LABEL_DUPLICATE, node->location);
         default:
             break;
     }
 }
 
 /**
- * Encodes the operands of an instruction into the memory image.
+ * Sizes the operands of an instruction - advances the code counter by their words, checks the
+ * immediate values and records the label operands for the second phase.
  *
+ * @param ctx The context of the assembly process.
  * @param node The parsed line represented as an ASTNode containing an instruction.
  * @param cmp_data The data structure holding various program-related data during assembly.
  */
-static void code_operands(ASTNode *node, CmpData *cmp_data) {
-    Boolean reg = FALSE; /* Flag indicating that operand of register type have been encoded */
+static void size_operands(AsmContext *ctx, ASTNode *node, CmpData *cmp_data) {
+    Boolean reg = FALSE; /* Flag indicating that operand of register type have been counted */
     InstructionOperand *current_opr;         /* Variable to store current ASTNode's operand */
     int current_addr;                      /* Value to store current operand's address mode */
     short i;                       /* Variable for iterating through the ASTNode's operands */
@@ -195,20 +215,24 @@ static void code_operands(ASTNode *node, CmpData *cmp_data) {
         current_opr = get_operand(node, i); /* Get current operand */
         current_addr = current_opr->adr_mode;    /* Get current operand's address mode */
 
-        /* Encode accordingly to the operand's address mode */
+        /* Count accordingly to the operand's address mode */
         switch (current_addr) {
             /* ------------------------ Immediate address mode ------------------------ */
             case ADDR_MODE_IMMEDIATE:
-                code_immediate_addr_mode(current_opr->value.int_val, &cmp_data->image, node);
+                if (fits_int_code(0, IMMEDIATE_DIRECTIVE_BIT_SIZE - 1, current_opr->value.int_val) == FALSE) {
+                    /* Integer is out of range */
+                    set_error(ctx, INTEGER_OUT_OF_RANGE, node->location);
+                }
                 break;
             /* -------------------------- Direct address mode -------------------------- */
             case ADDR_MODE_DIRECT:
-                /* Don't code labels in the first pass - mark them for the second phase */
-                mark_word(&cmp_data->image);
-                if (add_unresolved_line(cmp_data, node->location.line) == FALSE) {
-                    set_general_error(MEMORY_ALLOCATION_ERROR);
+                /* Don't code labels in the first pass - record the word for the second phase */
+                if (add_fixup(cmp_data, FIXUP_OPERAND, cmp_data->image.code_pos,
+                              current_opr->value.label_id, node->location) == FALSE) {
+                    set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
                     return;
                 }
+                ctx->stats.unresolved_operands++;
                 break;
             /* ----------------- Direct/Indirect register address mode ---------------- */
             case ADDR_INDIRECT_REG:
@@ -216,50 +240,47 @@ static void code_operands(ASTNode *node, CmpData *cmp_data) {
                 /* If there is only one register operand - it is the target register */
                 if (node->specific.instruction.num_operands == 1) i++;
 
-                /* Two register operands can be written in a single word */
+                /* Two register operands are written in a single word */
                 else if (reg == TRUE) {
-                    /* write on the previous word */
+                    /* count the previous word again */
                     seek_back(&cmp_data->image);
                 }
-
-                /* Code register operand */
-                code_register_addr_mode(current_opr->value.int_val, &cmp_data->image,
-                                        REGISTER_POS + (SECOND_REG_POSITION * (i - 1)));
-                reg = TRUE; /* Set flag to indicate that the encoded operand was a register */
+                reg = TRUE; /* Set flag to indicate that the counted operand was a register */
                 break;
 
             default: break;
         }
-        /* Update the memory image counter after each written operand  */
-        updt_code_counter(&cmp_data->image);
+        /* Update the memory image counter after each counted operand  */
+        updt_code_counter(ctx, &cmp_data->image);
     }
 }
 
 /**
  * Processes a directive line during the first phase of assembly.
- * It encodes the directive data into the data memory image and updates the `CmpData` structure.
+ * It advances the data counter by the words of the directive and updates the `CmpData` structure.
  *
+ * @param ctx The context of the assembly process.
  * @param node The parsed line represented as an ASTNode containing a directive.
  * @param cmp_data The data structure holding various program-related data during assembly.
  * @return TRUE if the directive is processed successfully, FALSE otherwise.
  */
-static void handle_directive(ASTNode *node, CmpData *cmp_data) {
+static void handle_directive(AsmContext *ctx, ASTNode *node, CmpData *cmp_data) {
     int id_start = cmp_data->image.data_count; /* remember starting address */
 
     switch (node->specific.directive.operation) {
         case DATA: /* Data directive */
-            code_data(node, &cmp_data->image);
+            size_data(ctx, node, &cmp_data->image);
             break;
         case STRING: /* String directive */
-            code_string(node, &cmp_data->image);
+            size_string(ctx, node, &cmp_data->image);
             break;
         case ENTRY: /* Entry directive will be handled in the second phase */
-            if (add_unresolved_line(cmp_data, node->location.line) == FALSE) {
-                set_general_error(MEMORY_ALLOCATION_ERROR);
+            if (add_entry_fixups(node, cmp_data) == FALSE) {
+                set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
                 return;
             } break;
         case EXTERN: /* Extern directive */
-            handle_extern(node, cmp_data);
+            handle_extern(ctx, node, cmp_data);
             break;
     }
 
@@ -268,12 +289,56 @@ static void handle_directive(ASTNode *node, CmpData *cmp_data) {
         /* Label before extern/entry directive is useless */
         if (node->specific.directive.operation == EXTERN){
             /* Print warning - label ignored */
-            print_warning(LABEL_EXTERN, &node->location);
+            print_warning(ctx, LABEL_EXTERN, &node->location);
         }
         else if (node->specific.directive.operation == ENTRY) {
             /* Print warning - label ignored */
-            print_warning(LABEL_ENTRY, &node->location);
-        } else {add_label(node, id_start, cmp_data);}
+            print_warning(ctx, LABEL_ENTRY, &node->location);
+        } else {add_label(ctx, node, id_start, cmp_data);}
+    }
+}
+
+/**
+ * Sizes a data directive - checks its operands and advances the data counter by a word for every
+ * integer operand.
+ *
+ * @param ctx The context of the assembly process.
+ * @param node The parsed line represented as an ASTNode containing a data directive.
+ * @param image The memory image.
+ */
+static void size_data(AsmContext *ctx, ASTNode *node, MemoryImage *image) {
+    DirNode *current = node->specific.directive.operands;
+
+    while (current) {
+        /* Validate operand */
+        if (is_valid_integer(current->operand)) {
+            if (fits_int_code(0, WORD_END_POS, my_atoi(current->operand)) == FALSE) {
+                /* Integer is out of range */
+                set_error(ctx, INTEGER_OUT_OF_RANGE, node->location);
+            }
+            updt_data_counter(ctx, image); /* Update counter */
+        } else {
+            /* Not an integer */
+            set_error(ctx, NOT_INTEGER, node->location);
+        }
+        current = (DirNode *) current->next;
+    }
+}
+
+/**
+ * Sizes a string directive - advances the data counter by a word for every character of the
+ * string and its null-terminator.
+ *
+ * @param ctx The context of the assembly process.
+ * @param node The parsed line represented as an ASTNode containing a string directive.
+ * @param image The memory image.
+ */
+static void size_string(AsmContext *ctx, ASTNode *node, MemoryImage *image) {
+    size_t str_length = strlen(node->specific.directive.operands->operand); /* String's length */
+    size_t i;
+
+    for (i = 0; i <= str_length; i++) {
+        updt_data_counter(ctx, image);
     }
 }
 
@@ -281,34 +346,37 @@ static void handle_directive(ASTNode *node, CmpData *cmp_data) {
  * Processes an EXTERN directive during the first phase of assembly.
  * It adds the external label to the label table in the `CmpData` structure.
  *
+ * @param ctx The context of the assembly process.
  * @param node The parsed line represented as an ASTNode containing an EXTERN directive.
  * @param cmp_data The data structure holding various program-related data during assembly.
  * @return TRUE if the EXTERN directive is processed successfully, FALSE otherwise.
  */
-static void handle_extern(ASTNode* node, CmpData* cmp_data) {
+static void handle_extern(AsmContext *ctx, ASTNode* node, CmpData* cmp_data) {
     /* DirNode variable to iterate through the parameters list */
     DirNode *current = node->specific.directive.operands;
+    int label_id; /* The ID of a label that is already defined */
 
     while (current) {
         /* Try adding the label to the label table */
         switch (insert_label(&cmp_data->label_table, current->operand, 0, EXTERNAL)) {
             /* Check for errors */
             case MEMORY_ALLOCATION_ERROR:
-                set_general_error(MEMORY_ALLOCATION_ERROR);
+                set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
                 break;
 
             case INVALID_CHAR:
-                set_error(INVALID_CHAR_LABEL, node->location);
+                set_error(ctx, INVALID_CHAR_LABEL, node->location);
                 break;
 
             case DUPLICATE:
                 /* The same label has been declared 'extern' twice */
-                if (get_label_type(&cmp_data->label_table,current->operand) == EXTERNAL) {
+                label_id = find_label_id(&cmp_data->label_table, current->operand);
+                if (cmp_data->label_table.labels[label_id].label_type == EXTERNAL) {
                     /* Print warning and ignore this label */
-                    print_warning(EXTERN_DUPLICATE, &node->location);
+                    print_warning(ctx, EXTERN_DUPLICATE, &node->location);
                 } else {
                     /* Duplicate label definition */
-                    set_error(LABEL_DUPLICATE, node->location);
+                    set_error(ctx, LABEL_DUPLICATE, node->location);
                 }
                 break;
 
@@ -317,4 +385,101 @@ static void handle_extern(ASTNode* node, CmpData* cmp_data) {
         }
         current = (DirNode *) current->next;
     }
-}
\ No newline at end of file
+}
+
+/**
+ * Records every label of an ENTRY directive in the fixup table, so it will be written to the
+ * entry file after the first phase - once the addresses of all the labels are known.
+ * The labels are interned in the label table, and the fixups hold their IDs.
+ *
+ * @param node The parsed line represented as an ASTNode containing an ENTRY directive.
+ * @param cmp_data The data structure holding various program-related data during assembly.
+ * @return TRUE if all the labels were recorded, FALSE if memory allocation failed.
+ */
+static Boolean add_entry_fixups(ASTNode *node, CmpData *cmp_data) {
+    /* DirNode variable to iterate through the parameters list */
+    DirNode *current = node->specific.directive.operands;
+    int label_id; /* The ID of the current label */
+
+    while (current) {
+        label_id = intern_label(&cmp_data->label_table, current->operand, strlen(current->operand));
+        if (label_id == -1 || add_fixup(cmp_data, FIXUP_ENTRY, 0, label_id, node->location) == FALSE) {
+            return FALSE;
+        }
+        current = (DirNode *) current->next;
+    }
+    return TRUE;
+}
+/* ---------------------------------------------------------------------------------------
+ *                                   Encoding Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Encodes an instruction into the code section of the memory image, from its writing position on:
+ * the first word, followed by the words of the operands that are not labels.
+ *
+ * @param node The parsed line represented as an ASTNode containing an instruction.
+ * @param image The memory image, with the writing position of the instruction.
+ */
+static void encode_instruction(const ASTNode *node, MemoryImage *image) {
+    Boolean reg = FALSE; /* Flag indicating that operand of register type have been encoded */
+    const InstructionOperand *current_opr;   /* Variable to store current ASTNode's operand */
+    short i;                       /* Variable for iterating through the ASTNode's operands */
+
+    encode_first_word(node, node->specific.instruction.operation, image);
+    image->code_pos++;
+
+    /* Iterate through node's operands */
+    for (i = 1; i <= node->specific.instruction.num_operands; i++) {
+        current_opr = (i == 1) ? &node->specific.instruction.operand1 : &node->specific.instruction.operand2;
+
+        /* Encode accordingly to the operand's address mode */
+        switch (current_opr->adr_mode) {
+            case ADDR_MODE_IMMEDIATE:
+                code_immediate_addr_mode(current_opr->value.int_val, image);
+                break;
+            case ADDR_INDIRECT_REG:
+            case ADDR_DIRECT_REG:
+                /* If there is only one register operand - it is the target register */
+                if (node->specific.instruction.num_operands == 1) i++;
+
+                /* Two register operands are written in a single word - write on the previous word */
+                else if (reg == TRUE) image->code_pos--;
+
+                /* Code register operand */
+                code_register_addr_mode(current_opr->value.int_val, image,
+                                        REGISTER_POS + (SECOND_REG_POSITION * (i - 1)));
+                reg = TRUE; /* Set flag to indicate that the encoded operand was a register */
+                break;
+
+            default: break; /* Label operands are encoded by the second phase */
+        }
+        image->code_pos++; /* The next operand is written to the next word */
+    }
+}
+
+/**
+ * Encodes the first word of an instruction - the operation, the addressing modes of its operands
+ * and the ARE field.
+ *
+ * @param node The parsed line represented as an ASTNode.
+ * @param command_index The index of the command in the operation table.
+ * @param image The memory image, with the writing position of the instruction.
+ */
+static void encode_first_word(const ASTNode *node, int command_index, MemoryImage *image) {
+    int num_operands = node->specific.instruction.num_operands; /* number of operands in this node */
+
+    /* Code the operation name */
+    set_int_code(0, 3, command_index, image, CODE_IMAGE);
+
+    /* ARE default first word's field */
+    set_bit(A, 1, image, CODE_IMAGE);
+
+    /* Code the address modes of the operands */
+    if (num_operands == 1) {
+        set_bit(DEST_OFFSET - node->specific.instruction.operand1.adr_mode, 1, image, CODE_IMAGE);
+    }
+    else if (num_operands == 2) {
+        set_bit(DEST_OFFSET - node->specific.instruction.operand2.adr_mode, 1, image, CODE_IMAGE);
+        set_bit(SRC_OFFSET - node->specific.instruction.operand1.adr_mode, 1, image, CODE_IMAGE);
+    }
+}
@@ -0,0 +1,86 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include "../headers/lexer.h"
+#include "../../utils/headers/char_class.h"
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static void add_token(LineTokens *tokens, TokenType type, const char *start, size_t length);
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Splits a line into tokens in a single pass, classifying every character with the character
+ * class table. The tokens are spans of the line - nothing is copied or allocated.
+ *
+ * @param line The line to split.
+ * @param tokens Pointer to the structure that receives the tokens.
+ * @return TRUE if the line was split, FALSE if it has more tokens than MAX_TOKENS.
+ */
+Boolean tokenize_line(const char *line, LineTokens *tokens) {
+    const char *ptr = line;   /* The current character */
+    const char *start;        /* The first character of the current word */
+    Boolean head = TRUE;      /* Flag indicating that no whitespace was passed - a colon ends a label */
+    unsigned char class;      /* The classes of the current character */
+
+    /* Skip leading whitespace */
+    while (IS_CHAR(*ptr, CHAR_SPACE)) ptr++;
+    tokens->first = ptr;
+    tokens->last = ptr - 1;
+    tokens->has_label = FALSE;
+    tokens->count = 0;
+
+    while (!((class = CHAR_CLASS(*ptr)) & CHAR_END)) {
+        if (class & CHAR_SPACE) { /* Whitespace separates tokens */
+            head = FALSE;
+            ptr++;
+            continue;
+        }
+
+        /* Keep room for the end token */
+        if (tokens->count == MAX_TOKENS - 1) return FALSE;
+        tokens->last = ptr;
+
+        if (class & CHAR_COMMA) {
+            add_token(tokens, TOKEN_COMMA, ptr++, 1);
+        } else if (head == TRUE && (class & CHAR_COLON)) {
+            /* Label found - the tokens before the colon are part of it */
+            tokens->has_label = TRUE;
+            tokens->label.type = TOKEN_WORD;
+            tokens->label.start = tokens->first;
+            tokens->label.length = (size_t)(ptr - tokens->first);
+            tokens->count = 0;
+            head = FALSE;
+            ptr++;
+        } else {
+            /* A word - up to a whitespace, a comma, the end of the line or a label colon */
+            start = ptr;
+            while (!IS_CHAR(*ptr, CHAR_SPACE | CHAR_COMMA | CHAR_END) &&
+                   !(head == TRUE && IS_CHAR(*ptr, CHAR_COLON))) {
+                ptr++;
+            }
+            tokens->last = ptr - 1;
+            add_token(tokens, TOKEN_WORD, start, (size_t)(ptr - start));
+        }
+    }
+
+    tokens->end = ptr;
+    add_token(tokens, TOKEN_END, ptr, 0);
+    return TRUE;
+}
+
+/**
+ * Static function - adds a token to the end of the tokens array.
+ *
+ * @param tokens Pointer to the tokens of the line.
+ * @param type The type of the token.
+ * @param start The first character of the token.
+ * @param length The number of characters in the token.
+ */
+static void add_token(LineTokens *tokens, TokenType type, const char *start, size_t length) {
+    Token *token = &tokens->tokens[tokens->count++];
+    token->type = type;
+    token->start = start;
+    token->length = length;
+}
@@ -3,81 +3,93 @@
  * --------------------------------------------------------------------------------------- */
 #include <stdio.h>
 #include <string.h>
-#include <ctype.h>
 #include <stdlib.h>
 #include "../../structures/headers/macro_data.h"
 #include "../../structures/headers/ast.h"
 #include "../../utils/headers/utils.h"
+#include "../../utils/headers/char_class.h"
 #include "../../structures/headers/mappings.h"
+#include "../headers/lexer.h"
 #include "../headers/parser.h"
 /* ---------------------------------------------------------------------------------------
  *                               Static Functions Prototypes
  * --------------------------------------------------------------------------------------- */
-static Boolean check_empty_line (const char** line, ASTNode* node);
-static Boolean is_label(const char **line, ASTNode *node, const MacroTrie *macr_trie);
-static Boolean validate_label(const char *label, ASTNode *node, const MacroTrie *macr_trie);
-static Boolean parse_operation(const char **line, ASTNode *node);
-static Boolean validate_operation(const char *operation, ASTNode* node);
-static Boolean parse_operands(const char **line, ASTNode *node, const MacroTrie *macr_trie);
-static Boolean parse_string(const char **line, ASTNode *node);
-static void parse_instruct_operand(ASTNode *node, const char *operand, const MacroTrie *macr_trie);
-static void parse_int(ASTNode* node, const char *operand);
-static void parse_reg(ASTNode* node, const char *operand, short addr_mode);
-static void parse_label(ASTNode *node, const char *operand, const MacroTrie *macr_trie);
+static Boolean check_empty_line (const LineTokens *tokens, ASTNode* node);
+static Boolean is_label(AsmContext *ctx, const LineTokens *tokens, ASTNode *node, const MacroTrie *macr_trie);
+static Boolean validate_label(AsmContext *ctx, const char *label, size_t length, ASTNode *node, const MacroTrie *macr_trie);
+static Boolean parse_operation(AsmContext *ctx, const Token **token, ASTNode *node);
+static Boolean validate_operation(AsmContext *ctx, const char *operation, size_t length, ASTNode* node);
+static Boolean parse_operands(AsmContext *ctx, const Token *token, const LineTokens *tokens, ASTNode *node, const MacroTrie *macr_trie, LabelTable *label_table);
+static Boolean parse_string(AsmContext *ctx, const Token *token, const LineTokens *tokens, ASTNode *node);
+static void parse_instruct_operand(AsmContext *ctx, ASTNode *node, const Token *operand, const MacroTrie *macr_trie, LabelTable *label_table);
+static void parse_int(AsmContext *ctx, ASTNode* node, const char *operand, size_t length);
+static void parse_reg(AsmContext *ctx, ASTNode* node, const char *operand, size_t length, short addr_mode);
+static void parse_label(AsmContext *ctx, ASTNode *node, const char *operand, size_t length, const MacroTrie *macr_trie, LabelTable *label_table);
 /* ---------------------------------------------------------------------------------------
  *                                   Head Function Of Parser
  * --------------------------------------------------------------------------------------- */
 /**
  * Parses a line of assembly image and creates an ASTNode representing the line.
- * This function processes a single line of assembly image, determining its type
- * (empty/comment, label, directive, or instruction) and extracting the relevant
- * information into an ASTNode structure. It uses several helper functions to
- * handle different parts of the line.
+ * This function splits the line into tokens in a single pass, determines its type
+ * (empty/comment, label, directive, or instruction) and extracts the relevant
+ * information from the tokens into an ASTNode structure. It uses several helper
+ * functions to handle different parts of the line.
  *
+ * @param ctx The context of the assembly process.
  * @param macr_trie A trie containing macro definitions to check for collisions with labels.
+ * @param label_table The label table - the label operands are interned to their IDs in it.
  * @param file_name The name of the file being parsed, used for error reporting.
  * @param line_num The line number in the file, used for error reporting.
  * @param line The line of assembly image to parse.
  *
  * @return A pointer to the newly created ASTNode representing the parsed line.
  */
-ASTNode *parseLine(const MacroTrie *macr_trie, const char *file_name, int line_num, char *line) {
+ASTNode *parseLine(AsmContext *ctx, const MacroTrie *macr_trie, LabelTable *label_table, const char *file_name,
+                   int line_num, const char *line) {
     ASTNode *node = NULL;
-    const char *line_ptr = line;
-
-    /* Skip leading whitespace */
-    trim_leading_spaces(&line_ptr);
+    LineTokens tokens;   /* The tokens of the line - spans of the line */
+    const Token *token;  /* The next token to parse */
 
     /* Create empty ASTNode */
-    node = create_empty_ASTnode(file_name, line_num, line);
+    node = create_empty_ASTnode(&ctx->line_arena, file_name, line_num, line);
+    if (!node) { /* Memory allocation failure */
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+        return NULL;
+    }
+
+    /* Split the line into tokens */
+    if (tokenize_line(line, &tokens) == FALSE) {
+        set_error(ctx, LINE_TOO_LONG, node->location);
+        return node;
+    }
 
     /* ------------------- 1. Check if line is empty or a comment ------------------- */
-    if (check_empty_line(&line_ptr, node) == TRUE) {
+    if (check_empty_line(&tokens, node) == TRUE) {
         return node;
     }
 
     /* ----------------------------- 2. Check for label ----------------------------- */
-    if (is_label(&line_ptr, node, macr_trie) == FALSE) {
-        return node; /* Memory allocation failed */
+    if (is_label(ctx, &tokens, node, macr_trie) == FALSE) {
+        return node; /* Invalid label */
     }
 
     /* ------------------------- 3. Read the operation name ------------------------- */
+    token = tokens.tokens;
 
-    if (*line_ptr == '.') {
+    if (token->type == TOKEN_WORD && *token->start == '.') {
         /* Directive line */
         set_ast_type(node, LINE_DIRECTIVE);
-        line_ptr++; /* Skip dot */
     } else { /* Instruction line */
         set_ast_type(node, LINE_INSTRUCTION);
     }
 
     /* get operation name */
-    if (parse_operation(&line_ptr, node) == FALSE) {
+    if (parse_operation(ctx, &token, node) == FALSE) {
         return node;
     }
 
     /* get operands */
-    if (parse_operands(&line_ptr, node, macr_trie) == FALSE) {
+    if (parse_operands(ctx, token, &tokens, node, macr_trie, label_table) == FALSE) {
         return node;
     }
 
@@ -91,12 +103,12 @@ ASTNode *parseLine(const MacroTrie *macr_trie, const char *file_name, int line_n
 * This function determines if a given line of text is empty or a comment
 * and updates the ASTNode accordingly.
 *
-* @param line Pointer to the line of text.
+* @param tokens The tokens of the line.
 * @param node The ASTNode to update.
 * @return TRUE if the line is empty or a comment, FALSE otherwise.
 */
-static Boolean check_empty_line(const char** line, ASTNode* node) {
-    const char* ptr = *line;
+static Boolean check_empty_line(const LineTokens *tokens, ASTNode* node) {
+    const char* ptr = tokens->first;
     if (*ptr == '\0') { /* Empty line */
         set_ast_type(node, LINE_EMPTY);
         return TRUE;
@@ -110,40 +122,23 @@ static Boolean check_empty_line(const char** line, ASTNode* node) {
 }
 
 /**
- * Static Function - identifies a label in the line, validates it, and updates the ASTNode.
+ * Static Function - validates the label the lexer found in the line, and updates the ASTNode.
  *
- * @param line Pointer to the line of text.
+ * @param ctx The context of the assembly process.
+ * @param tokens The tokens of the line.
  * @param node The ASTNode to update.
  * @param macr_trie Trie structure for macro definitions.
  * @return TRUE if the label was processed successfully, FALSE otherwise.
  */
-static Boolean is_label(const char **line, ASTNode *node, const MacroTrie *macr_trie) {
-    const char *start = *line;    /* Start of the label if found */
-    const char *line_ptr = start; /* Pointer to iterate through the string */
-    char *label;
-
-    while (*line_ptr && *line_ptr != ':' && !isspace(*line_ptr)) line_ptr++;
+static Boolean is_label(AsmContext *ctx, const LineTokens *tokens, ASTNode *node, const MacroTrie *macr_trie) {
     /* Label found */
-    if (*line_ptr == ':') {
-        /* Save label string */
-        label = my_strndup(start, line_ptr - start);
-
-        line_ptr++;  /* Skip the colon */
-        trim_leading_spaces(&line_ptr); /* Skip any whitespace after the label */
-        *line = line_ptr;
-
-        if (!label) {
-            set_general_error(MEMORY_ALLOCATION_ERROR);
-            return FALSE; /* Memory allocation failure */
-        }
+    if (tokens->has_label == TRUE) {
         /* Validate label name */
-        if (validate_label(label, node, macr_trie) == FALSE) {
-            free(label);
+        if (validate_label(ctx, tokens->label.start, tokens->label.length, node, macr_trie) == FALSE) {
             return FALSE; /* Invalid name */
         }
 
-        set_ast_label(node, label); /* Save label in AST node */
-        free(label); /* Free duplicated label */
+        set_ast_label(node, tokens->label.start, tokens->label.length); /* Save label in AST node */
 
     }
     return TRUE; /* Function proceeded successfully */
@@ -153,33 +148,35 @@ static Boolean is_label(const char **line, ASTNode *node, const MacroTrie *macr_
  * Static function - checks if the label is valid, ensuring it meets the naming rules
  * and does not collide with reserved words or macros.
  *
- * @param label The label to validate.
+ * @param ctx The context of the assembly process.
+ * @param label The label to validate - a span of the line.
+ * @param length The number of characters in the label.
  * @param node The ASTNode to update the error status if needed.
  * @param macr_trie Trie structure for macro names.
  * @return TRUE if the label is valid, FALSE otherwise.
  */
-static Boolean validate_label(const char *label, ASTNode *node, const MacroTrie *macr_trie) {
-    /* Check if the label is NULL or does not start with an alphabetic character */
-    if (!label || !isalpha(label[0])) {
-        set_error(INVALID_LABEL_NAME, node->location);
+static Boolean validate_label(AsmContext *ctx, const char *label, size_t length, ASTNode *node, const MacroTrie *macr_trie) {
+    /* Check if the label is empty or does not start with an alphabetic character */
+    if (length == 0 || !IS_CHAR(label[0], CHAR_ALPHA)) {
+        set_error(ctx, INVALID_LABEL_NAME, node->location);
         return FALSE; /* Return FALSE if the label is invalid */
     }
 
     /* Check if the label exceeds the maximum allowed length */
-    if (strlen(label) > MAX_LABEL_LENGTH-1) {
-        set_error(INVALID_LABEL_LENGTH, node->location);
+    if (length > MAX_LABEL_LENGTH-1) {
+        set_error(ctx, INVALID_LABEL_LENGTH, node->location);
         return FALSE; /* Return FALSE if the label is too long */
     }
 
     /* Check if the label collides with reserved words */
-    if (reserved_word(label) == TRUE) {
-        set_error(LABEL_RESERVED_WORD, node->location);
+    if (find_keyword(label, length).type != KEYWORD_NONE) {
+        set_error(ctx, LABEL_RESERVED_WORD, node->location);
         return FALSE;
     }
 
     /* Check if the label collides with macro name */
-    if (find_macro(macr_trie, label)) {
-        set_error(LABEL_MACR_COLLIDES, node->location);
+    if (find_macro(macr_trie, label, length)) {
+        set_error(ctx, LABEL_MACR_COLLIDES, node->location);
         return FALSE;
     }
 
@@ -187,48 +184,31 @@ static Boolean validate_label(const char *label, ASTNode *node, const MacroTrie
 }
 
 /**
- * Static function - parses the operation from the line.
- * This function extracts the operation name from the line, validates it,
- * and updates the ASTNode.
+ * Static function - parses the operation from the tokens.
+ * The operation is the first token after the label, without the dot of a directive - it is
+ * empty if that token is not a word. This function validates it and updates the ASTNode.
  *
- * @param line Pointer to the line of text.
+ * @param ctx The context of the assembly process.
+ * @param token Pointer to the current token - moved past the operation.
  * @param node The ASTNode to update.
  * @return TRUE if the operation was parsed successfully, FALSE otherwise.
  */
-static Boolean parse_operation(const char **line, ASTNode *node) {
-    const char* start = *line;    /* Pointer to the start of the line */
-    const char* line_ptr = start; /* Pointer to move through the line */
-    char* operation = NULL;   /* Variable to store the operation name */
-    Boolean result; /* The status of the operation validation methods */
+static Boolean parse_operation(AsmContext *ctx, const Token **token, ASTNode *node) {
+    const char *operation = (*token)->start; /* The operation name */
+    size_t length = 0;                       /* The number of characters in the operation name */
 
+    if ((*token)->type == TOKEN_WORD) {
+        length = (*token)->length;
+        (*token)++; /* Move to the operands */
 
-    /* Position the pointer to the last char before the comme - if exists */
-    while (*line_ptr && !is_space(*line_ptr) && *line_ptr != ',') {
-        if (*line_ptr == ',') {
-            set_error(ILLEGAL_COMMA_ERROR, node->location);
-            return FALSE;
+        if (node->lineType == LINE_DIRECTIVE) { /* Skip dot */
+            operation++;
+            length--;
         }
-        line_ptr++;
-    }
-
-    /* Get the first word of the command */
-    operation = my_strndup(start, line_ptr - start);
-
-    if (!operation) { /* Memory allocation failure */
-        set_error(MEMORY_ALLOCATION_ERROR, node->location);
-        return FALSE;
     }
 
-    /* Skip any whitespace after the operation */
-    trim_leading_spaces(&line_ptr);
-
-    /* Update the line to point the next char after this word */
-    *line = line_ptr;
-
-    /* Save and validate the founded operation name */
-    result = validate_operation(operation, node);
-    free(operation);
-    return result;
+    /* Validate the founded operation name */
+    return validate_operation(ctx, operation, length, node);
 }
 
 /**
@@ -236,71 +216,66 @@ static Boolean parse_operation(const char **line, ASTNode *node) {
  * This function checks if the operation is valid and updates the ASTNode
  * with the corresponding instruction or directive.
  *
- * @param operation The operation to validate.
+ * @param ctx The context of the assembly process.
+ * @param operation The operation to validate - a span of the line.
+ * @param length The number of characters in the operation.
  * @param node The ASTNode to update.
  * @return TRUE if the operation is valid, FALSE otherwise.
  */
-static Boolean validate_operation(const char *operation, ASTNode* node) {
-    short command_index; /* Index of the command in the command mapping */
+static Boolean validate_operation(AsmContext *ctx, const char *operation, size_t length, ASTNode* node) {
+    Keyword keyword = find_keyword(operation, length); /* The class of the operation name */
 
     /* If this is an instruction line */
-    if (node->lineType == LINE_INSTRUCTION) {
-        /* find the corresponding instruction to the given name */
-        command_index = get_instruct_index(operation);
-        if (command_index != -1 ) {
-            /* Found the corresponding instruction */
-            set_operation_for_instruction(node, command_index);
-            return TRUE;
-        }
+    if (node->lineType == LINE_INSTRUCTION && keyword.type == KEYWORD_INSTRUCTION) {
+        /* Found the corresponding instruction */
+        set_operation_for_instruction(node, keyword.index);
+        return TRUE;
     }
 
     /* If this is directive line */
-    if (node->lineType == LINE_DIRECTIVE) {
-        /* find the corresponding directive command to the given name */
-        command_index = get_dir_index(operation);
-        if (command_index != -1) {
-            /* Found the corresponding directive */
-            set_operation_for_directive(node, get_dir_command(command_index) );
-            return TRUE;
-        }
+    if (node->lineType == LINE_DIRECTIVE && keyword.type == KEYWORD_DIRECTIVE) {
+        /* Found the corresponding directive */
+        set_operation_for_directive(node, get_dir_command(keyword.index));
+        return TRUE;
     }
 
     /* Given command name is invalid */
-    set_error(INSTRUCTION_NAME_ERROR, node->location);
+    set_error(ctx, INSTRUCTION_NAME_ERROR, node->location);
     return FALSE;
 }
 
 /**
- * Static function - parses the operands from the line.
- * This function extracts the operands from the line, validates them,
+ * Static function - parses the operands from the tokens.
+ * This function checks the comma separation of the operand tokens, validates them,
  * and updates the ASTNode.
  *
- * @param line Pointer to the line of text.
+ * @param ctx The context of the assembly process.
+ * @param token The first token after the operation.
+ * @param tokens The tokens of the line.
  * @param node The ASTNode to update.
+ * @param macr_trie Trie structure for macro names.
+ * @param label_table The label table that label operands are interned in.
  * @return TRUE if the operands were parsed successfully, FALSE otherwise.
  */
-static Boolean parse_operands(const char **line, ASTNode *node, const MacroTrie *macr_trie) {
-    const char *start = *line;                      /* Pointer to the start of the word */
-    const char *line_ptr = start;                   /* Pointer to move through the line */
+static Boolean parse_operands(AsmContext *ctx, const Token *token, const LineTokens *tokens, ASTNode *node, const MacroTrie *macr_trie, LabelTable *label_table) {
     Boolean first_op = TRUE; /* Flag indicating if the first operand was already parsed */
-    char* operand = NULL;                         /* Variable to store the operand text */
-    int operand_counter = 0;                        /* Counts number of operands parsed */
+    char* operand = NULL;    /* Copy of a directive operand, kept by the ASTNode */
 
     /* If this is a string directive - parse the string */
     if (node->lineType == LINE_DIRECTIVE) {
         if (node->specific.directive.operation == STRING) {
-            return parse_string(line, node);
+            return parse_string(ctx, token, tokens, node);
         }
     }
 
     /* Iterate until the end of the line is reached */
-    while (*line_ptr) {
+    while (token->type != TOKEN_END) {
 
         /* Check condition for the first operand in the line */
         if (first_op == TRUE) {
             /* First operand shouldn't start with comma */
-            if (*line_ptr == ',') {
-                set_error(ILLEGAL_COMMA_ERROR, node->location);
+            if (token->type == TOKEN_COMMA) {
+                set_error(ctx, ILLEGAL_COMMA_ERROR, node->location);
                 return FALSE;
             }
         }
@@ -308,51 +283,34 @@ static Boolean parse_operands(const char **line, ASTNode *node, const MacroTrie
         /* Check conditions for the rest of the operands */
         if (first_op == FALSE) {
             /* All arguments should be seperated by comma */
-            if (*line_ptr != ',') {
-                set_error(MISSING_COMMA_ERROR, node->location);
-                return FALSE;
-            }
-            line_ptr++; /* Skip comma */
-            trim_leading_spaces(&line_ptr); /* Skip spaces */
-            if (*line_ptr == ',') { /* Consecutive comma error */
-                set_error(CONSECUTIVE_COMMA_ERROR, node->location);
+            if (token->type != TOKEN_COMMA) {
+                set_error(ctx, MISSING_COMMA_ERROR, node->location);
                 return FALSE;
             }
-        }
-
-        /* Position the pointer to get the word */
-        start = line_ptr;
-
-        /* Move the pointer to the end of the word */
-        while (*line_ptr && *line_ptr != ',' && !isspace(*line_ptr)) {
-            if (is_space(*line_ptr)) { /* New operand without comma separation */
-                set_error(MISSING_COMMA_ERROR, node->location);
+            token++; /* Skip comma */
+            if (token->type == TOKEN_COMMA) { /* Consecutive comma error */
+                set_error(ctx, CONSECUTIVE_COMMA_ERROR, node->location);
                 return FALSE;
             }
-            line_ptr++;
         }
 
         /* If word is not empty */
-        if (line_ptr > start) {
-            /* Save the text */
-            operand = my_strndup(start, line_ptr - start);
-            if (!operand) { /* Memory allocation failed */
-                set_general_error(MEMORY_ALLOCATION_ERROR);
-                return FALSE;
-            }
-
+        if (token->type == TOKEN_WORD) {
             /* Parse directive operands */
             if (node->lineType == LINE_DIRECTIVE) {
-                add_directive_operand(&node->specific.directive, operand);
+                /* Save the text */
+                operand = arena_strndup(&ctx->line_arena, token->start, token->length);
+                if (add_directive_operand(&ctx->line_arena, &node->specific.directive, operand) == FALSE) {
+                    set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+                    return FALSE;
+                }
             } else { /* Parse instruction type operands */
-                parse_instruct_operand(node, operand, macr_trie);
-                operand_counter++;
-                free(operand);
+                parse_instruct_operand(ctx, node, token, macr_trie, label_table);
             }
             first_op = FALSE; /* Processed first operand already */
-            trim_leading_spaces(&line_ptr);
+            token++;
         } else {
-            set_error(EXTRA_TXT, node->location);
+            set_error(ctx, EXTRA_TXT, node->location);
             return FALSE;
         }
     }
@@ -361,29 +319,38 @@ static Boolean parse_operands(const char **line, ASTNode *node, const MacroTrie
 
 /**
  * Static function - parses a string operand.
- * This function extracts a quoted string from the provided line. The string
+ * This function extracts a quoted string from the rest of the line. The string
  * consists of all characters placed between the first and last quotes. If the string
  * is invalid, an error is printed, and the function returns FALSE.
  *
- * @param line Pointer to the line of text.
+ * @param ctx The context of the assembly process.
+ * @param token The first token after the operation - the start of the string.
+ * @param tokens The tokens of the line.
  * @param node The ASTNode to update.
  * @return TRUE if the string was parsed successfully, FALSE otherwise.
  */
-static Boolean parse_string(const char **line, ASTNode *node) {
-    const char *start = *line;  /* Pointer to the start of the string */
-    const char *end = start;      /* Pointer to the end of the string */
+static Boolean parse_string(AsmContext *ctx, const Token *token, const LineTokens *tokens, ASTNode *node) {
+    const char *start = token->start;  /* Pointer to the start of the string */
+    const char *end = tokens->last;    /* Pointer to the end of the string */
 
     if (*start == '"') {  /* Start of a quoted string */
         start++;
-        end = last_nonspace_char(end);
         if (*end != '"') { /* String does not end in with quotes */
-            set_error(INVALID_END_STRING, node->location);
+            set_error(ctx, INVALID_END_STRING, node->location);
             return FALSE;
         }
-        /* Add string to ASTNode and return this process status */
-        return add_directive_operand(&node->specific.directive, my_strndup(start, end - start));
+        /* A single quote - the string is the rest of the line */
+        if (end < start) end = tokens->end;
+
+        /* Add string to ASTNode */
+        if (add_directive_operand(&ctx->line_arena, &node->specific.directive,
+                                  arena_strndup(&ctx->line_arena, start, end - start)) == FALSE) {
+            set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+            return FALSE;
+        }
+        return TRUE;
     } else {/* String does not start in with quotes */
-        set_error(INVALID_START_STRING, node->location);
+        set_error(ctx, INVALID_START_STRING, node->location);
         return FALSE;
     }
 }
@@ -393,30 +360,34 @@ static Boolean parse_string(const char **line, ASTNode *node) {
  * This function parses using helper methods an operand and sets the appropriate addressing
  * mode in the ASTNode.
  *
+ * @param ctx The context of the assembly process.
  * @param node The ASTNode to update.
- * @param operand The operand to parse.
+ * @param operand The operand token to parse.
+ * @param macr_trie Trie structure for macro names.
+ * @param label_table The label table that label operands are interned in.
  */
-static void parse_instruct_operand(ASTNode *node, const char *operand, const MacroTrie *macr_trie) {
-    if (!operand) return; /* Null pointer */
+static void parse_instruct_operand(AsmContext *ctx, ASTNode *node, const Token *operand, const MacroTrie *macr_trie, LabelTable *label_table) {
+    const char *str = operand->start; /* The text of the operand */
+    size_t length = operand->length;  /* The number of characters in the operand */
 
     /* Integer */
-    else if (operand[0] == '#') {
-        parse_int(node, operand+1);
+    if (str[0] == '#') {
+        parse_int(ctx, node, str+1, length-1);
     }
 
     /* Indirect register */
-    else if (operand[0] == '*') {
+    else if (str[0] == '*') {
         /* Check if the rest of the string is a valid register */
-        parse_reg(node, operand+1, ADDR_INDIRECT_REG);
+        parse_reg(ctx, node, str+1, length-1, ADDR_INDIRECT_REG);
     }
 
     /* Check for direct mode register */
-    else if (get_register_index(operand) != -1) {
-        parse_reg(node, operand, ADDR_DIRECT_REG);
+    else if (find_keyword(str, length).type == KEYWORD_REGISTER) {
+        parse_reg(ctx, node, str, length, ADDR_DIRECT_REG);
     }
 
     else { /* label */
-        parse_label(node, operand, macr_trie);
+        parse_label(ctx, node, str, length, macr_trie, label_table);
     }
 }
 
@@ -424,18 +395,22 @@ static void parse_instruct_operand(ASTNode *node, const char *operand, const Mac
  * Static function - parses an integer operand.
  * This function validates if the operand is an integer and adds it to the ASTNode.
  *
+ * @param ctx The context of the assembly process.
  * @param node The ASTNode to update.
- * @param operand The operand to parse.
+ * @param operand The operand to parse - a span of the line.
+ * @param length The number of characters in the operand.
  */
-static void parse_int(ASTNode* node, const char *operand) {
+static void parse_int(AsmContext *ctx, ASTNode* node, const char *operand, size_t length) {
+    int value; /* The value of the integer */
+
     /* Validate if the rest of the string is an integer */
-    if (is_valid_integer(operand)) {
-        if (add_instruct_operand(node, ADDR_MODE_IMMEDIATE, NULL, (short)my_atoi(operand)) == FALSE) {
-            set_error(INVALID_PARAM_NUMBER, node->location);
+    if (span_to_integer(operand, length, &value) == TRUE) {
+        if (add_instruct_operand(node, ADDR_MODE_IMMEDIATE, (short)value) == FALSE) {
+            set_error(ctx, INVALID_PARAM_NUMBER, node->location);
         }
     } else {
         /* Invalid integer */
-        set_error(NOT_INTEGER, node->location);
+        set_error(ctx, NOT_INTEGER, node->location);
     }
 }
 
@@ -443,32 +418,43 @@ static void parse_int(ASTNode* node, const char *operand) {
  * Static function - parses a register operand.
  * This function validates if the operand is a register and adds it to the ASTNode.
  *
+ * @param ctx The context of the assembly process.
  * @param node The ASTNode to update.
- * @param operand The operand to parse.
+ * @param operand The operand to parse - a span of the line.
+ * @param length The number of characters in the operand.
  * @param addr_mode The addressing mode to set.
  */
-static void parse_reg(ASTNode* node, const char *operand, short addr_mode) {
+static void parse_reg(AsmContext *ctx, ASTNode* node, const char *operand, size_t length, short addr_mode) {
     /* Get the corresponding register from the mappings */
-    short index = get_register_index(operand);
-    if (index != -1) {
-        if (add_instruct_operand(node, addr_mode, NULL, index) == FALSE) {
-            set_error(INVALID_PARAM_NUMBER, node->location);
+    Keyword reg = find_keyword(operand, length);
+    if (reg.type == KEYWORD_REGISTER) {
+        if (add_instruct_operand(node, addr_mode, reg.index) == FALSE) {
+            set_error(ctx, INVALID_PARAM_NUMBER, node->location);
         }
     } else {
-        set_error(INVALID_REGISTER, node->location);
+        set_error(ctx, INVALID_REGISTER, node->location);
     }
 }
 /**
  * Static function - parses a label operand.
- * this function checks if the operand is a valid label and if so, adds it to the ASTNode.
+ * this function checks if the operand is a valid label and if so, interns it in the label
+ * table and adds its ID to the ASTNode.
  *
+ * @param ctx The context of the assembly process.
  * @param node The ASTNode to update.
- * @param operand The operand to parse.
+ * @param operand The operand to parse - a span of the line.
+ * @param length The number of characters in the operand.
+ * @param macr_trie Trie structure for macro names.
+ * @param label_table The label table that the label is interned in.
  */
-static void parse_label(ASTNode *node, const char *operand, const MacroTrie *macr_trie) {
-    if (validate_label(operand, node, macr_trie) == TRUE) { /* Validate label */
-        if (add_instruct_operand(node, ADDR_MODE_DIRECT, operand, 0) == FALSE) {
-            set_error(INVALID_PARAM_NUMBER, node->location);
+static void parse_label(AsmContext *ctx, ASTNode *node, const char *operand, size_t length, const MacroTrie *macr_trie, LabelTable *label_table) {
+    int id; /* The ID of the label */
+
+    if (validate_label(ctx, operand, length, node, macr_trie) == TRUE) { /* Validate label */
+        if ((id = intern_label(label_table, operand, length)) == -1) {
+            set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+        } else if (add_instruct_operand(node, ADDR_MODE_DIRECT, id) == FALSE) {
+            set_error(ctx, INVALID_PARAM_NUMBER, node->location);
         }
     }
-}
\ No newline at end of file
+}
@@ -8,73 +8,111 @@
 #include "../../structures/headers/cmp_data.h"
 #include "../headers/first_phase.h"
 #include "../headers/second_phase.h"
+#include "../headers/phase_controller.h"
 #include "../../utils/headers/output_files.h"
 #include "../../structures/headers/macro_data.h"
 #include "../headers/parser.h"
 #include "../../assembler/headers/code_convert.h"
+#include "../headers/encoder_pool.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Number of lines that are sized before they are handed to the encoding threads */
+#define ENCODE_WINDOW_LINES 4096
 /* ---------------------------------------------------------------------------------------
  *                               Static Functions Prototypes
  * --------------------------------------------------------------------------------------- */
-static void first_phase_controller(FILE* file_am, const char* file_name, MacroTrie *macr_trie, CmpData *cmp_data);
-static void second_phase_controller(FILE* file_am, const char* file_name, MacroTrie *macr_trie, CmpData *cmp_data);
-static Boolean create_obj_file(const char* source_file_name, CmpData* cmp_data);
-static void free_program_data(CmpData *cmp_data, FILE *source_file, Boolean delete);
+static void first_phase_controller(AsmContext *ctx, const LineBuffer *am_lines, const char* file_name, MacroTrie *macr_trie, CmpData *cmp_data,
+                                   int encode_threads);
+static Boolean parallel_first_phase(AsmContext *ctx, const LineBuffer *am_lines, const char *file_name,
+                                    MacroTrie *macr_trie, CmpData *cmp_data, int encode_threads);
+static Boolean second_phase_controller(AsmContext *ctx, const LineBuffer *am_lines, CmpData *cmp_data);
+static void create_output_files(AsmContext *ctx, const char *origin_file_name, CmpData *cmp_data);
+static Boolean create_obj_file(AsmContext *ctx, const char* source_file_name, CmpData* cmp_data);
+static void create_record_file(AsmContext *ctx, const char *source_file_name, const char *extension,
+                               const RecordBuffer *records);
+static void remove_record_file(AsmContext *ctx, const char *source_file_name, const char *extension);
 /* ---------------------------------------------------------------------------------------
  *                             Head Function Of Phase Controller
  * --------------------------------------------------------------------------------------- */
 /**
- * The `phase_controller` function orchestrates the two phases of the assembler on the am file.
- * It conducts the first and second phases of assembly and creates the final object file if both
- * phases were successful.
+ * The `phase_controller` function orchestrates the two phases of the assembler on the preprocessed
+ * lines. It conducts the first and second phases of assembly and creates the final object file
+ * if both phases were successful.
+ * The entry and extern lines are kept in memory during the phases - each of their files is
+ * created only after the object file, and only if it has lines. No file is created if an error
+ * occurred. The memory of the program's data belongs to the caller - it is reset after the file,
+ * for the next one.
  *
+ * @param ctx The context of the assembly process.
  * @param origin_file_name The name of the original source file.
- * @param file_name_am The name of the preprocessed source file (.am).
+ * @param file_name_am The name of the preprocessed source file (.am), used for error reporting.
+ * @param am_lines The preprocessed lines.
  * @param macr_trie The trie structure containing macro definitions.
+ * @param cmp_data The initialized, empty data structure that the encoded program is written to.
+ * @param encode_threads The number of threads that encode the lines of the first phase - 1 encodes
+ *        every line right after it is sized.
  */
-void phase_controller(const char *origin_file_name, const char *file_name_am, MacroTrie *macr_trie) {
-    FILE* file_am = NULL; /* the source file (.am) */
-    CmpData cmp_data;     /* program's data - initialize the memory image to 0 */
-    ErrorCode cmp_init_status;
-
-    /* Open the am file in read mode */
-    if (!(file_am = fopen(file_name_am, "r"))) {
-        /* if the file fails to open, set an error_in_file and return */
-        set_general_error(FAILED_OPEN_FILE);
-        fclose(file_am); /* close the file */
-        return;
-    }
+void phase_controller(AsmContext *ctx, const char *origin_file_name, const char *file_name_am,
+                      const LineBuffer *am_lines, MacroTrie *macr_trie, CmpData *cmp_data, int encode_threads) {
+    /* ------------------------------------ Assembler phases ------------------------------------ */
+    if (phases_controller(ctx, am_lines, file_name_am, macr_trie, cmp_data, encode_threads) == FALSE) return;
 
-    /* initialize the computer's data with the specified content */
-    cmp_init_status = init_cmp_data(&cmp_data, origin_file_name);
-    if (cmp_init_status != NO_ERROR) {
-        set_general_error(cmp_init_status);
-        free_program_data(&cmp_data, file_am, TRUE);
-        return;
-    }
+    create_output_files(ctx, origin_file_name, cmp_data);
+}
 
-    /* -------------------------------------- First phase -------------------------------------- */
-    first_phase_controller(file_am, file_name_am, macr_trie, &cmp_data);
-    if (get_status() != ERROR_FREE_FILE) {
-        free_program_data(&cmp_data, file_am, TRUE);
-        return;
-    }
+/**
+ * The `encoded_phase_controller` function completes the assembly of lines whose first phase was
+ * conducted already - it conducts the second phase and creates the output files, as
+ * `phase_controller` does after the first phase.
+ *
+ * @param ctx The context of the assembly process, with the errors of the first phase.
+ * @param origin_file_name The name of the original source file.
+ * @param am_lines The preprocessed lines.
+ * @param cmp_data The data structure holding the program encoded by the first phase.
+ */
+void encoded_phase_controller(AsmContext *ctx, const char *origin_file_name, const LineBuffer *am_lines,
+                              CmpData *cmp_data) {
+    if (second_phase_controller(ctx, am_lines, cmp_data) == FALSE) return;
 
-    /* Update address */
-    update_addr(cmp_data.label_table.root, cmp_data.image.code_count + IC_START, DIRECTIVE);
+    create_output_files(ctx, origin_file_name, cmp_data);
+}
 
-    /* -------------------------------------- Second phase -------------------------------------- */
-    second_phase_controller(file_am, file_name_am, macr_trie, &cmp_data);
-    if (get_status() != ERROR_FREE_FILE) {
-        free_program_data(&cmp_data, file_am, TRUE);
-        return;
-    }
+/**
+ * The `remove_record_files` function removes the entry and extern files of a source file, if
+ * they exist - the assembly of the file failed.
+ *
+ * @param ctx The context of the assembly process.
+ * @param origin_file_name The name of the original source file.
+ */
+void remove_record_files(AsmContext *ctx, const char *origin_file_name) {
+    remove_record_file(ctx, origin_file_name, ".ent");
+    remove_record_file(ctx, origin_file_name, ".ext");
+}
 
-    /* ------------------------------------ Create object file ----------------------------------- */
-    if (create_obj_file(origin_file_name, &cmp_data) == FALSE) {
-        free_program_data(&cmp_data, file_am, TRUE);
-    } else {
-        free_program_data(&cmp_data, file_am, FALSE);
-    }
+/**
+ * The `phases_controller` function conducts the first and second phases of the assembler on the
+ * preprocessed lines.
+ *
+ * @param ctx The context of the assembly process.
+ * @param am_lines The preprocessed lines.
+ * @param file_name_am The name of the preprocessed source file, used for error reporting.
+ * @param macr_trie The trie structure containing macro definitions.
+ * @param cmp_data The initialized data structure that the encoded program is written to.
+ * @param encode_threads The number of threads that encode the lines of the first phase - 1 encodes
+ *        every line right after it is sized.
+ * @return TRUE if both phases completed without errors, FALSE otherwise.
+ */
+Boolean phases_controller(AsmContext *ctx, const LineBuffer *am_lines, const char *file_name_am, MacroTrie *macr_trie,
+                          CmpData *cmp_data, int encode_threads) {
+    double start = stats_clock(); /* Start time of the current phase */
+
+    /* -------------------------------------- First phase -------------------------------------- */
+    first_phase_controller(ctx, am_lines, file_name_am, macr_trie, cmp_data, encode_threads);
+    add_stage_time(&ctx->stats, STAGE_FIRST_PHASE, start);
+
+    /* -------------------------------------- Second phase -------------------------------------- */
+    return second_phase_controller(ctx, am_lines, cmp_data);
 }
 
 /* ---------------------------------------------------------------------------------------
@@ -82,134 +120,282 @@ void phase_controller(const char *origin_file_name, const char *file_name_am, Ma
  * --------------------------------------------------------------------------------------- */
 /**
  * The `first_phase_controller` function performs the first phase of the assembly process.
- * It reads each line of the preprocessed file, parses it with the help of the 'parseLine' method,
+ * It goes over each line of the preprocessed file, parses it with the help of the 'parseLine' method,
  * and analyzes with the method 'first_phase_analyzer' it in the first phase context.
  * It updates the line code_count, parses lines, and handles errors if they occur.
+ * With more than one encoding thread, a file larger than a window of lines is conducted by
+ * `parallel_first_phase` - if its threads cannot be started, the lines are analyzed here.
  *
- * @param file_am The preprocessed source file (.am).
+ * @param ctx The context of the assembly process.
+ * @param am_lines The preprocessed lines.
  * @param file_name The name of the preprocessed source file.
  * @param macr_trie The trie structure containing macro names.
  * @param cmp_data The data structure holding various program-related data during assembly.
+ * @param encode_threads The number of threads that encode the lines.
  * @return TRUE if the first phase completes without errors, FALSE otherwise.
  */
-static void first_phase_controller(FILE* file_am, const char* file_name, MacroTrie *macr_trie, CmpData *cmp_data) {
+static void first_phase_controller(AsmContext *ctx, const LineBuffer *am_lines, const char* file_name, MacroTrie *macr_trie, CmpData *cmp_data,
+                                   int encode_threads) {
     int line_count = 0;                                 /* line counter */
-    char line[MAX_LINE_LENGTH] = {0};   /* string to hold the read line */
+    size_t pos = 0;             /* position of the next line in the buffer */
+    const char *line = NULL;                           /* the current line */
     ASTNode* node = NULL; /* Ast node that will contain the parsed line */
 
-    /* Read line from the am file */
-    while (fgets(line, sizeof(line), file_am) != NULL) {
+    if (encode_threads > 1 && am_lines->count > ENCODE_WINDOW_LINES &&
+        parallel_first_phase(ctx, am_lines, file_name, macr_trie, cmp_data, encode_threads) == TRUE) {
+        return;
+    }
+
+    /* Get the next preprocessed line */
+    while ((line = next_line(am_lines, &pos)) != NULL) {
         line_count++; /* Update counter */
 
         /* Parse line */
-        node = parseLine(macr_trie, file_name, line_count, line);
+        node = parseLine(ctx, macr_trie, &cmp_data->label_table, file_name, line_count, line);
 
         /* If an error occurred - ASTNode is not completed, therefore cannot be encoded */
-        if (get_error() != NO_ERROR) {
-            /* Clear for enabling the processing of the next lines */
-            clear_error();
-            free_ast_node(node); /* Free nodes */
-            continue;
+        if (get_error(ctx) == NO_ERROR) {
+            first_phase_analyzer(ctx, node, cmp_data);
         }
 
-        first_phase_analyzer(node, cmp_data);
-
-        free_ast_node(node); /* Free the astNode */
-        clear_error(); /* Clear error for the next line */
+        /* Release the node with the rest of the line's memory, and clear the error for the next line */
+        reset_arena(&ctx->line_arena);
+        clear_error(ctx);
     }
-
-    /* Reset the file pointer to the beginning */
-    fseek(file_am, 0, SEEK_SET);
 }
 
 /**
- * The `second_phase_controller` function performs the second phase of the assembly process.
- * It reads each unresolved line from the preprocessed file, parses it with the help of the 'parseLine'
- * method, and analyzes it with the method 'second_phase_analyzer' in the second phase context.
- * It updates the line code_count and handles unresolved lines specifically.
+ * The `parallel_first_phase` function performs the first phase like `first_phase_controller`, with
+ * the words of the lines written by a pool of threads. The calling thread parses and sizes the
+ * lines - every message is printed by it, in order - and the lines sized without errors are
+ * encoded at the addresses they were given, which do not depend on the other lines. The lines are
+ * handed to the pool in windows: while the threads encode a window, the next one is sized, with
+ * the nodes of every window in an arena of its own.
  *
- * @param file_am The preprocessed source file (.am).
+ * @param ctx The context of the assembly process.
+ * @param am_lines The preprocessed lines.
  * @param file_name The name of the preprocessed source file.
  * @param macr_trie The trie structure containing macro names.
  * @param cmp_data The data structure holding various program-related data during assembly.
- * @return TRUE if the second phase completes without errors, FALSE otherwise.
+ * @param encode_threads The number of threads of the pool.
+ * @return TRUE if the first phase was conducted, FALSE if the pool could not be started (no line
+ *         was analyzed).
  */
-static void second_phase_controller(FILE* file_am, const char* file_name, MacroTrie *macr_trie, CmpData *cmp_data) {
-    char line[MAX_LINE_LENGTH] = {0};   /* string to hold the read line */
-    ASTNode* node = NULL; /* Ast node that will contain the parsed line */
-    int line_count = 1;                                 /* line counter */
-    int unresolved_line = get_unresolved_line(cmp_data);
-
-    /* Read line from the am file */
-    while (fgets(line, sizeof(line), file_am) != NULL) {
-        if (line_count != unresolved_line) {
-            line_count++;
-            continue;
-        }
+static Boolean parallel_first_phase(AsmContext *ctx, const LineBuffer *am_lines, const char *file_name,
+                                    MacroTrie *macr_trie, CmpData *cmp_data, int encode_threads) {
+    EncoderPool *pool;          /* The encoding threads */
+    EncodeJob *jobs[2];         /* The sized lines of the two windows */
+    int counts[2] = {0, 0};     /* Number of sized lines of every window */
+    Arena arenas[2];            /* The memory of the lines of every window */
+    int window = 0;             /* The window that is sized */
+    int lines = 0;              /* Number of lines in the window */
+    Boolean pending = FALSE;    /* Flag indicating if the other window is encoded */
+    int line_count = 0;         /* line counter */
+    size_t pos = 0;             /* position of the next line in the buffer */
+    const char *line = NULL;    /* the current line */
+    ASTNode *node = NULL;       /* Ast node that will contain the parsed line */
+    int error_counter;          /* Number of errors before the line */
+    EncodeJob *job;
+
+    /* The sections must not move while the threads write them */
+    if (reserve_image(&cmp_data->image) == FALSE) return FALSE;
+    jobs[0] = (EncodeJob *)malloc(ENCODE_WINDOW_LINES * sizeof(EncodeJob));
+    jobs[1] = (EncodeJob *)malloc(ENCODE_WINDOW_LINES * sizeof(EncodeJob));
+    if (!jobs[0] || !jobs[1] || !(pool = start_encoder_pool(encode_threads, &cmp_data->image))) {
+        free(jobs[0]);
+        free(jobs[1]);
+        return FALSE;
+    }
+    arenas[0] = ctx->line_arena;
+    init_arena(&arenas[1]);
+
+    /* Get the next preprocessed line */
+    while ((line = next_line(am_lines, &pos)) != NULL) {
+        line_count++; /* Update counter */
+
+        /* Parse line - the node is kept with the window */
+        node = parseLine(ctx, macr_trie, &cmp_data->label_table, file_name, line_count, line);
 
-        /* Parse only unresolved lines */
-        node = parseLine(macr_trie, file_name, line_count, line);
+        /* Size the line, and keep it for the threads if it can be encoded */
+        if (get_error(ctx) == NO_ERROR) {
+            job = &jobs[window][counts[window]];
+            job->node = node;
+            job->code_pos = cmp_data->image.code_count;
+            job->data_pos = cmp_data->image.data_count;
+            error_counter = ctx->program_status.error_counter;
 
-        /* Encode Unresolved line - the second phase */
-        second_phase_analyzer(node, cmp_data);
+            first_phase_sizer(ctx, node, cmp_data);
+            if (ctx->program_status.error_counter == error_counter && cmp_data->image.full == FALSE &&
+                node->lineType != LINE_EMPTY && node->lineType != LINE_COMMENT) {
+                counts[window]++;
+            }
+        }
+        clear_error(ctx);
+
+        /* Hand the full window to the threads, and size the next one in the other arena */
+        if (++lines == ENCODE_WINDOW_LINES) {
+            if (pending == TRUE) wait_encoder_pool(pool);
+            encode_jobs(pool, jobs[window], counts[window]);
+            pending = TRUE;
 
-        /* Update counters and get the next line */
-        line_count++;
-        unresolved_line = get_unresolved_line(cmp_data);
-        free_ast_node(node); /* Free the ASTNode memory */
+            arenas[window] = ctx->line_arena;
+            window = 1 - window;
+            reset_arena(&arenas[window]);
+            ctx->line_arena = arenas[window];
+            counts[window] = 0;
+            lines = 0;
+        }
     }
+
+    /* Encode the last window */
+    if (pending == TRUE) wait_encoder_pool(pool);
+    encode_jobs(pool, jobs[window], counts[window]);
+    wait_encoder_pool(pool);
+    stop_encoder_pool(pool);
+
+    /* Keep the first arena for the next lines */
+    arenas[window] = ctx->line_arena;
+    reset_arena(&arenas[0]);
+    ctx->line_arena = arenas[0];
+    free_arena(&arenas[1]);
+    free(jobs[0]);
+    free(jobs[1]);
+    return TRUE;
+}
+
+/**
+ * The `second_phase_controller` function conducts the second phase, if the first phase completed
+ * without errors. The label references recorded in the first phase are resolved - no line is
+ * parsed again.
+ *
+ * @param ctx The context of the assembly process.
+ * @param am_lines The preprocessed lines, used for error reporting.
+ * @param cmp_data The data structure holding the program encoded by the first phase.
+ * @return TRUE if both phases completed without errors, FALSE otherwise.
+ */
+static Boolean second_phase_controller(AsmContext *ctx, const LineBuffer *am_lines, CmpData *cmp_data) {
+    double start; /* Start time of the second phase */
+
+    ctx->stats.labels = cmp_data->label_table.names.count;
+    if (get_status(ctx) != ERROR_FREE_FILE) return FALSE;
+
+    start = stats_clock();
+    second_phase_analyzer(ctx, am_lines, cmp_data);
+    add_stage_time(&ctx->stats, STAGE_SECOND_PHASE, start);
+    return (get_status(ctx) == ERROR_FREE_FILE) ? TRUE : FALSE;
 }
 
 /* ---------------------------------------------------------------------------------------
  *                                Utility Functions Functions
  * --------------------------------------------------------------------------------------- */
+/**
+ * Creates the object file, followed by the entry and extern files - each of them only if it
+ * has lines.
+ *
+ * @param ctx The context of the assembly process.
+ * @param origin_file_name The name of the original source file.
+ * @param cmp_data The data structure holding the encoded program.
+ */
+static void create_output_files(AsmContext *ctx, const char *origin_file_name, CmpData *cmp_data) {
+    double start = stats_clock(); /* Start time of the output stage */
+
+    /* ------------------------------------ Create object file ----------------------------------- */
+    if (create_obj_file(ctx, origin_file_name, cmp_data) == TRUE) {
+        /* ---------------------------- Create entry and extern files ----------------------------- */
+        create_record_file(ctx, origin_file_name, ".ent", &cmp_data->entries);
+        create_record_file(ctx, origin_file_name, ".ext", &cmp_data->externals);
+    }
+    add_stage_time(&ctx->stats, STAGE_OUTPUT, start);
+}
+
 /**
  * Creates an object file with the `.ob` extension from the source file name.
- * It writes the program's memory images to the object file with the method 'print_memory_images'.
+ * It writes the program's memory images to the object file with the method 'write_memory_images'.
  *
+ * @param ctx The context of the assembly process.
  * @param source_file_name The name of the source file.
  * @param cmp_data The data structure holding various program-related data during assembly.
  * @return TRUE if the object file is created and written successfully, FALSE otherwise.
  */
-static Boolean create_obj_file(const char* source_file_name, CmpData* cmp_data) {
+static Boolean create_obj_file(AsmContext *ctx, const char* source_file_name, CmpData* cmp_data) {
     char* file_ob = NULL;              /* the object file name */
-    FILE* object_file;                 /* the object file (.ob) */
-
+    ErrorCode write_status;            /* status of writing the object file */
+    size_t size = 0;                   /* size of the object file */
 
     /* ------------- Create the source filename with the specified extension -------------*/
     if (!create_new_file_name(source_file_name, &file_ob, ".ob")) {
-        set_general_error(MEMORY_ALLOCATION_ERROR);
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
         return FALSE;
     }
 
-    /* ----------------------- Open the source file in read mode ----------------------- */
-    if (!(object_file = fopen(file_ob, "w"))) {
-        /* If the file fails to open, set an error and return */
-        set_general_error(FAILED_OPEN_FILE);
-        free(file_ob);
+    /* ------------------------ Write the memory image to the file ------------------------ */
+    write_status = write_memory_images(file_ob, cmp_data, &size);
+    free(file_ob);
+
+    if (write_status != NO_ERROR) {
+        /* If the file fails to be written, set an error and return */
+        set_general_error(ctx, write_status);
         return FALSE;
     }
-    else { /* Print the memory image */
-        print_memory_images(object_file, cmp_data);
-        fclose(object_file); /* close the file */
-        free(file_ob);
-        return TRUE;
+    ctx->stats.bytes_written += (long)size;
+    return TRUE;
+}
+
+/**
+ * Creates an entry or extern file from the source file name and writes its lines to it with the
+ * method 'write_records'. The file is created only if it has lines - without lines, the file of a
+ * previous assembly is removed.
+ *
+ * @param ctx The context of the assembly process.
+ * @param source_file_name The name of the source file.
+ * @param extension The extension of the file (".ent" or ".ext").
+ * @param records The lines of the file.
+ */
+static void create_record_file(AsmContext *ctx, const char *source_file_name, const char *extension,
+                               const RecordBuffer *records) {
+    char *file_name = NULL;            /* the file name */
+    ErrorCode write_status;            /* status of writing the file */
+
+    /* No lines - no file, and none left from a previous assembly */
+    if (records->size == 0) {
+        remove_record_file(ctx, source_file_name, extension);
+        return;
+    }
+
+    if (!create_new_file_name(source_file_name, &file_name, extension)) {
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+        return;
     }
+
+    write_status = write_records(file_name, records);
+    free(file_name);
+
+    if (write_status != NO_ERROR) {
+        set_general_error(ctx, write_status);
+        return;
+    }
+    ctx->stats.bytes_written += (long)records->size;
 }
 
 /**
- * Frees the resources allocated for the program data, closes the source file,
- * and optionally deletes the files associated with the compiled data.
- * The files will be deleted if an error occurred during the processing stages.
+ * Removes an entry or extern file of the source file name, if it exists, with the method
+ * 'remove_output_file'. A file that cannot be removed is reported.
  *
- * @param cmp_data The data structure holding various program-related data during assembly.
- * @param source_file The source file to be closed.
- * @param delete Flag indicating whether to delete the files associated with the compiled data.
+ * @param ctx The context of the assembly process.
+ * @param source_file_name The name of the source file.
+ * @param extension The extension of the file (".ent" or ".ext").
  */
-static void free_program_data(CmpData *cmp_data, FILE *source_file, Boolean delete) {
-    free_label_tree(&cmp_data->label_table);
-    fclose(source_file);
-    free_cmp_data(cmp_data, delete);
-    /* Reset static variable for unresolved line loop */
-    get_marked_line(NULL, TRUE);
-}
\ No newline at end of file
+static void remove_record_file(AsmContext *ctx, const char *source_file_name, const char *extension) {
+    char *file_name = NULL;            /* the file name */
+    ErrorCode remove_status;           /* status of removing the file */
+
+    if (!create_new_file_name(source_file_name, &file_name, extension)) {
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+        return;
+    }
+
+    remove_status = remove_output_file(file_name);
+    free(file_name);
+
+    if (remove_status != NO_ERROR) set_general_error(ctx, remove_status);
+}
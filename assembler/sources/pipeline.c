@@ -0,0 +1,778 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "../headers/pipeline.h"
+#include "../headers/preprocessor.h"
+#include "../headers/parser.h"
+#include "../headers/first_phase.h"
+#include "../headers/phase_controller.h"
+#include "../../structures/headers/ast.h"
+#include "../../structures/headers/spsc_ring.h"
+#include "../../utils/headers/source_file.h"
+#include "../../utils/headers/utils.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Number of source lines of a batch */
+#define BATCH_LINES 256
+/* Number of batches of every link between two stages - the bound of the link */
+#define BATCH_COUNT 8
+/* The kinds of the items of a batch of expanded lines */
+#define ITEM_LINE 0  /* An expanded line */
+#define ITEM_MACRO 1 /* The name of a macro that the preprocessor defined */
+/* ---------------------------------------------------------------------------------------
+ *                                         Structures
+ * --------------------------------------------------------------------------------------- */
+/* A batch of source lines, from the reader to the preprocessor - spans of the source */
+typedef struct {
+    const char *spans[BATCH_LINES]; /* The first characters of the lines */
+    size_t lengths[BATCH_LINES];    /* The lengths of the lines, including their '\n' */
+    int count;                      /* Number of lines */
+    Boolean last;                   /* Flag indicating if this is the last batch of the source */
+} SpanBatch;
+
+/* A batch of expanded lines, from the preprocessor to the parser */
+typedef struct {
+    LineBuffer items; /* The expanded lines and the names of the defined macros, in order */
+    char *kinds;      /* The kind of every item - ITEM_LINE or ITEM_MACRO */
+    int capacity;     /* Number of allocated kinds */
+    Boolean last;     /* Flag indicating if this is the last batch of the source */
+} LineBatch;
+
+/* A parsed line, from the parser to the encoder */
+typedef struct {
+    ASTNode *node;          /* The parsed line */
+    ErrorCode error;        /* The error that the parser found in the line */
+    int errors;             /* Number of errors that the parser printed for the line */
+    Status status;          /* The status of the parser after the line */
+    Boolean file_error;     /* The file error flag of the parser after the line */
+    const char *messages;   /* The messages that the parser printed for the line, or NULL */
+    size_t messages_length; /* The number of characters of the messages */
+    char **labels;          /* The label operands that appeared for the first time, in order */
+    int label_count;        /* Number of those labels */
+} ParsedLine;
+
+/* A batch of parsed lines, from the parser to the encoder */
+typedef struct {
+    ParsedLine *lines; /* The parsed lines */
+    int count;         /* Number of lines */
+    int capacity;      /* Number of allocated lines */
+    Arena arena;       /* The nodes, messages and labels of the lines */
+    Boolean last;      /* Flag indicating if this is the last batch of the source */
+} NodeBatch;
+
+/* The stages of the pipeline and the links between them */
+typedef struct {
+    /* ------------------------------------- The source ------------------------------------- */
+    AsmContext *ctx;         /* The context of the assembly - used by the preprocessor stage */
+    const char *source;      /* The content of the source */
+    size_t size;             /* The number of characters in the content */
+    const char *source_name; /* The name of the source file */
+    char *am_name;           /* The name of the preprocessed file, used for error reporting */
+    LineBuffer *am_lines;    /* The preprocessed lines */
+    MacroTrie *macro_trie;   /* The macros of the preprocessor */
+    CmpData *cmp_data;       /* The encoded program */
+
+    /* ---------------- The links - a ring of full batches and a ring of free ones ---------------- */
+    SpscRing spans, free_spans;
+    SpscRing lines, free_lines;
+    SpscRing nodes, free_nodes;
+    SpanBatch span_batches[BATCH_COUNT];
+    LineBatch line_batches[BATCH_COUNT];
+    NodeBatch node_batches[BATCH_COUNT];
+
+    /* ------------------------------------- The parser ------------------------------------- */
+    AsmContext parser_ctx;     /* The context of the parser - its messages are captured */
+    char *parser_messages;     /* The captured messages */
+    size_t parser_size;        /* The size of the captured messages */
+    size_t parser_passed;      /* The size of the messages already passed to the encoder */
+    MacroTrie parser_macros;   /* The names of the macros defined so far */
+    LabelTable parser_labels;  /* The label operands parsed so far - their IDs are private */
+    LabelTable defined_labels; /* The labels defined by the parsed lines */
+    LineBuffer late_macros;    /* The macros defined after the first parsed line */
+    Boolean collides;          /* Flag indicating if a late macro collides with a parsed label */
+    Boolean parser_failed;     /* Flag indicating if the parser failed to allocate memory */
+
+    /* ------------------------------------- The encoder ------------------------------------- */
+    AsmContext encoder_ctx;    /* The context of the encoder - its messages are captured */
+    char *encoder_messages;    /* The captured messages, with those of the parser */
+    size_t encoder_size;       /* The size of the captured messages */
+    int *label_ids;            /* The IDs of the label operands in the label table, by private ID */
+    int label_count;           /* Number of label operands */
+    int label_capacity;        /* Number of allocated IDs */
+    Boolean encoder_failed;    /* Flag indicating if the encoder failed to allocate memory */
+    Boolean encoded;           /* Flag indicating if all the stages ran */
+} Pipeline;
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static Boolean init_pipeline(Pipeline *pipeline, const char *file_origin, CmpData *cmp_data);
+static void free_pipeline(Pipeline *pipeline);
+static void run_pipeline(AsmContext *ctx, const char *source, size_t size, LineBuffer *am_lines,
+                         const char *source_name, MacroTrie *macro_trie, void *data);
+static void *read_stage(void *data);
+static void *preprocess_stage(void *data);
+static void *parse_stage(void *data);
+static void encode_stage(Pipeline *pipeline);
+static Boolean pass_lines(LineBatch *batch, const LineBuffer *am_lines, size_t pos, const char *defined_macro);
+static Boolean add_item(LineBatch *batch, const char *item, char kind);
+static void add_parser_macro(Pipeline *pipeline, const char *name, int line_count);
+static void parse_item(Pipeline *pipeline, NodeBatch *batch, const char *line, int line_count);
+static Boolean keep_parser_output(Pipeline *pipeline, ParsedLine *parsed, int first_label);
+static ParsedLine *next_parsed_line(NodeBatch *batch);
+static Boolean late_macro_collides(const Pipeline *pipeline);
+static void encode_line(Pipeline *pipeline, ParsedLine *parsed);
+static void add_label_id(Pipeline *pipeline, const char *label);
+static void remap_labels(const Pipeline *pipeline, ASTNode *node);
+static void commit_first_phase(AsmContext *ctx, Pipeline *pipeline);
+/* ---------------------------------------------------------------------------------------
+ *                               Head Function Of Pipeline
+ * --------------------------------------------------------------------------------------- */
+/**
+ * The `pipeline_controller` function preprocesses the source file with `preprocess_file`, with
+ * the content processed by the stages of the pipeline instead of `preprocess_source`, and completes
+ * the assembly with `encoded_phase_controller`.
+ * The first phase of the pipeline is used only if it is exactly the first phase of the sequential
+ * assembly. The parser checks the labels against the macros defined so far - if a macro defined
+ * later has the name of a parsed label, or a stage could not be started, the encoded program is
+ * discarded and the phases are conducted by `phase_controller`.
+ * The preprocessor time of the statistics covers all the stages, which run together.
+ *
+ * @param ctx The context of the assembly process.
+ * @param file_origin The base name of the source file without extension.
+ * @param macro_trie A trie structure containing macro definitions for preprocessing.
+ * @param am_lines The line buffer that receives the processed lines.
+ * @param cmp_data The initialized, empty data structure that the encoded program is written to.
+ * @param emit_am Flag indicating whether to write the processed lines to the ".am" file.
+ * @param source The content of the source file (.as) if it was read already, or NULL to read it.
+ * @param encode_threads The number of threads that encode the lines if the phases are conducted
+ *        again by `phase_controller`.
+ * @return The name of the preprocessed file with the ".am" extension, or NULL if an error occurred
+ *         before the phases.
+ */
+char *pipeline_controller(AsmContext *ctx, const char *file_origin, MacroTrie *macro_trie, LineBuffer *am_lines,
+                          CmpData *cmp_data, Boolean emit_am, const SourceFile *source, int encode_threads) {
+    Pipeline *pipeline;           /* The stages and the links between them */
+    char *file_am = NULL;         /* The name of the preprocessed file */
+    double start = stats_clock(); /* Start time of the current stage */
+
+    if (!(pipeline = (Pipeline *)malloc(sizeof(Pipeline)))) {
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+        return NULL;
+    }
+    if (init_pipeline(pipeline, file_origin, cmp_data) == FALSE) {
+        free_pipeline(pipeline);
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+        return NULL;
+    }
+
+    /* ------------------------- Preprocess, parse and encode together ------------------------- */
+    file_am = preprocess_file(ctx, file_origin, macro_trie, am_lines, emit_am, source, run_pipeline, pipeline);
+    add_stage_time(&ctx->stats, STAGE_PREPROCESSOR, start);
+
+    /* ---------------- Continue only if the preprocessor completed without errors ---------------- */
+    if (get_status(ctx) == ERROR_FREE_FILE) {
+        if (pipeline->encoded == TRUE && pipeline->collides == FALSE &&
+            pipeline->parser_failed == FALSE && pipeline->encoder_failed == FALSE) {
+            start = stats_clock();
+            commit_first_phase(ctx, pipeline);
+            add_stage_time(&ctx->stats, STAGE_FIRST_PHASE, start);
+            encoded_phase_controller(ctx, file_origin, am_lines, cmp_data);
+        } else {
+            /* The first phase of the pipeline differs from the sequential one - conduct it again */
+            reset_cmp_data(cmp_data);
+            phase_controller(ctx, file_origin, file_am, am_lines, macro_trie, cmp_data, encode_threads);
+        }
+    }
+
+    free_pipeline(pipeline);
+    return file_am;
+}
+
+/* ---------------------------------------------------------------------------------------
+ *                                     Pipeline Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Initializes the links of the pipeline with free batches, and the contexts of the parser and
+ * the encoder with streams that capture their messages. The pipeline can be freed with
+ * `free_pipeline` even if the initialization failed.
+ *
+ * @param pipeline Pointer to the pipeline to be initialized.
+ * @param file_origin The base name of the source file without extension.
+ * @param cmp_data The data structure that the encoded program is written to.
+ * @return TRUE if the pipeline was initialized, FALSE if memory allocation failed.
+ */
+static Boolean init_pipeline(Pipeline *pipeline, const char *file_origin, CmpData *cmp_data) {
+    int i;
+
+    memset(pipeline, 0, sizeof(Pipeline));
+    pipeline->cmp_data = cmp_data;
+    init_context(&pipeline->parser_ctx, NULL);
+    init_context(&pipeline->encoder_ctx, NULL);
+    init_line_buffer(&pipeline->late_macros);
+    for (i = 0; i < BATCH_COUNT; i++) {
+        init_line_buffer(&pipeline->line_batches[i].items);
+        init_arena(&pipeline->node_batches[i].arena);
+    }
+
+    if (!create_new_file_name(file_origin, &pipeline->am_name, ".am") ||
+        init_ring(&pipeline->spans, BATCH_COUNT) == FALSE || init_ring(&pipeline->free_spans, BATCH_COUNT) == FALSE ||
+        init_ring(&pipeline->lines, BATCH_COUNT) == FALSE || init_ring(&pipeline->free_lines, BATCH_COUNT) == FALSE ||
+        init_ring(&pipeline->nodes, BATCH_COUNT) == FALSE || init_ring(&pipeline->free_nodes, BATCH_COUNT) == FALSE ||
+        init_macr_trie(&pipeline->parser_macros) == FALSE || init_label_table(&pipeline->parser_labels) == FALSE ||
+        init_label_table(&pipeline->defined_labels) == FALSE) {
+        return FALSE;
+    }
+
+    /* The messages of the parser and the encoder are held until the preprocessor is done */
+    pipeline->parser_ctx.output = open_memstream(&pipeline->parser_messages, &pipeline->parser_size);
+    pipeline->encoder_ctx.output = open_memstream(&pipeline->encoder_messages, &pipeline->encoder_size);
+    if (!pipeline->parser_ctx.output || !pipeline->encoder_ctx.output) return FALSE;
+
+    /* All the batches start free - the producer of every link takes them from its free ring */
+    for (i = 0; i < BATCH_COUNT; i++) {
+        ring_put(&pipeline->free_spans, &pipeline->span_batches[i]);
+        ring_put(&pipeline->free_lines, &pipeline->line_batches[i]);
+        ring_put(&pipeline->free_nodes, &pipeline->node_batches[i]);
+    }
+    return TRUE;
+}
+
+/**
+ * Frees all the memory of the pipeline, and the pipeline itself.
+ *
+ * @param pipeline Pointer to the pipeline to be freed.
+ */
+static void free_pipeline(Pipeline *pipeline) {
+    int i;
+
+    if (pipeline->parser_ctx.output) fclose(pipeline->parser_ctx.output);
+    if (pipeline->encoder_ctx.output) fclose(pipeline->encoder_ctx.output);
+    free(pipeline->parser_messages);
+    free(pipeline->encoder_messages);
+    free_context(&pipeline->parser_ctx);
+    free_context(&pipeline->encoder_ctx);
+
+    for (i = 0; i < BATCH_COUNT; i++) {
+        free_line_buffer(&pipeline->line_batches[i].items);
+        free(pipeline->line_batches[i].kinds);
+        free(pipeline->node_batches[i].lines);
+        free_arena(&pipeline->node_batches[i].arena);
+    }
+    free_ring(&pipeline->spans);
+    free_ring(&pipeline->free_spans);
+    free_ring(&pipeline->lines);
+    free_ring(&pipeline->free_lines);
+    free_ring(&pipeline->nodes);
+    free_ring(&pipeline->free_nodes);
+
+    free_macr_trie(&pipeline->parser_macros);
+    free_label_table(&pipeline->parser_labels);
+    free_label_table(&pipeline->defined_labels);
+    free_line_buffer(&pipeline->late_macros);
+    free(pipeline->label_ids);
+    free(pipeline->am_name);
+    free(pipeline);
+}
+
+/**
+ * Processes the content of a source with the stages of the pipeline - the processor that
+ * `pipeline_controller` passes to `preprocess_file`. The reader, the preprocessor and the parser
+ * run in threads of their own, and the encoder runs in the calling thread.
+ * The consumer of every link is started before its producer, so if a stage cannot be started, the
+ * started stages are ended with an empty batch and the source is preprocessed by `preprocess_source`.
+ *
+ * @param ctx The context of the assembly process.
+ * @param source The content of the source.
+ * @param size The number of characters in the content.
+ * @param am_lines The line buffer that receives the processed lines.
+ * @param source_name The name of the source file, used for error reporting.
+ * @param macro_trie A trie structure containing macro definitions for preprocessing.
+ * @param data The pipeline.
+ */
+static void run_pipeline(AsmContext *ctx, const char *source, size_t size, LineBuffer *am_lines,
+                         const char *source_name, MacroTrie *macro_trie, void *data) {
+    Pipeline *pipeline = (Pipeline *)data;
+    pthread_t threads[3]; /* The parser, the preprocessor and the reader */
+    int started = 0;      /* Number of started threads */
+    int joined;           /* Number of threads left to join */
+    SpanBatch *spans;     /* The empty batch that ends the preprocessor */
+    LineBatch *lines;     /* The empty batch that ends the parser */
+
+    pipeline->ctx = ctx;
+    pipeline->source = source;
+    pipeline->size = size;
+    pipeline->source_name = source_name;
+    pipeline->am_lines = am_lines;
+    pipeline->macro_trie = macro_trie;
+
+    /* ------------------------------ Start the stages, consumers first ------------------------------ */
+    if (pthread_create(&threads[0], NULL, parse_stage, pipeline) == 0) started++;
+    if (started == 1 && pthread_create(&threads[1], NULL, preprocess_stage, pipeline) == 0) started++;
+    if (started == 2 && pthread_create(&threads[2], NULL, read_stage, pipeline) == 0) started++;
+
+    /* End the last started stage if its producer could not be started */
+    if (started == 1) {
+        lines = (LineBatch *)ring_take(&pipeline->free_lines);
+        reset_line_buffer(&lines->items);
+        lines->last = TRUE;
+        ring_put(&pipeline->lines, lines);
+    } else if (started == 2) {
+        spans = (SpanBatch *)ring_take(&pipeline->free_spans);
+        spans->count = 0;
+        spans->last = TRUE;
+        ring_put(&pipeline->spans, spans);
+    }
+
+    /* ------------------------------ Encode, and wait for the stages ------------------------------ */
+    if (started > 0) encode_stage(pipeline);
+    for (joined = started; joined > 0; joined--) pthread_join(threads[joined - 1], NULL);
+
+    pipeline->encoded = (started == 3) ? TRUE : FALSE;
+    if (pipeline->encoded == FALSE) {
+        preprocess_source(ctx, source, size, am_lines, source_name, macro_trie);
+    }
+}
+
+/* ---------------------------------------------------------------------------------------
+ *                                      Stage Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * The reader stage - splits the source into batches of lines.
+ *
+ * @param data The pipeline.
+ * @return NULL.
+ */
+static void *read_stage(void *data) {
+    Pipeline *pipeline = (Pipeline *)data;
+    SpanBatch *batch;        /* The batch being filled */
+    const char *span = NULL; /* The read line - a span of the source */
+    size_t length = 0;       /* Length of the span, including '\n' */
+    size_t pos = 0;          /* Position of the next line to read */
+    Boolean last = FALSE;    /* Flag indicating if the source was read */
+
+    while (last == FALSE) {
+        batch = (SpanBatch *)ring_take(&pipeline->free_spans);
+        batch->count = 0;
+        while (batch->count < BATCH_LINES &&
+               (span = next_source_line(pipeline->source, pipeline->size, &pos, &length)) != NULL) {
+            batch->spans[batch->count] = span;
+            batch->lengths[batch->count] = length;
+            batch->count++;
+        }
+        last = batch->last = (span == NULL || pos >= pipeline->size) ? TRUE : FALSE;
+        ring_put(&pipeline->spans, batch);
+    }
+    return NULL;
+}
+
+/**
+ * The preprocessor stage - preprocesses the lines of the source with `preprocess_line`, as
+ * `preprocess_source` does, and passes the expanded lines and the names of the defined macros on.
+ * This stage is the only one that uses the context of the assembly while the pipeline runs.
+ *
+ * @param data The pipeline.
+ * @return NULL.
+ */
+static void *preprocess_stage(void *data) {
+    Pipeline *pipeline = (Pipeline *)data;
+    AsmContext *ctx = pipeline->ctx;
+    PreprocessorState state; /* The state of the preprocessor between lines */
+    SpanBatch *spans;        /* The batch of source lines */
+    LineBatch *lines;        /* The batch of expanded lines */
+    size_t pos;              /* Position of the first line of the current source line */
+    Boolean last = FALSE;    /* Flag indicating if the source was preprocessed */
+    int i;
+
+    init_preprocessor_state(&state, pipeline->source_name);
+    while (last == FALSE) {
+        spans = (SpanBatch *)ring_take(&pipeline->spans);
+        lines = (LineBatch *)ring_take(&pipeline->free_lines);
+        reset_line_buffer(&lines->items);
+
+        for (i = 0; i < spans->count && get_status(ctx) != FATAL_ERROR; i++) {
+            pos = pipeline->am_lines->size;
+            preprocess_line(ctx, &state, spans->spans[i], spans->lengths[i], pipeline->am_lines,
+                            pipeline->macro_trie);
+            if (pass_lines(lines, pipeline->am_lines, pos, state.defined_macro) == FALSE) {
+                set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+            }
+        }
+
+        last = lines->last = spans->last;
+        ring_put(&pipeline->free_spans, spans);
+        ring_put(&pipeline->lines, lines);
+    }
+
+    /* ------------------------------------- Free memory ------------------------------------- */
+    free_trie_data(pipeline->macro_trie);
+    return NULL;
+}
+
+/**
+ * The parser stage - parses the expanded lines with `parseLine`, as the first phase does, with
+ * the macros defined so far. The messages of every line, and the label operands that it
+ * interned first, are kept with its node for the encoder.
+ * The labels are interned in a private label table - the label table of the program belongs to
+ * the encoder.
+ *
+ * @param data The pipeline.
+ * @return NULL.
+ */
+static void *parse_stage(void *data) {
+    Pipeline *pipeline = (Pipeline *)data;
+    LineBatch *lines;       /* The batch of expanded lines */
+    NodeBatch *nodes;       /* The batch of parsed lines */
+    Arena line_arena;       /* The arena of the parser's context, while a batch's arena is used */
+    const char *item;       /* The current item of the batch */
+    size_t pos;             /* Position of the next item of the batch */
+    int line_count = 0;     /* Number of parsed lines */
+    Boolean last = FALSE;   /* Flag indicating if all the lines were parsed */
+    int i;
+
+    while (last == FALSE) {
+        lines = (LineBatch *)ring_take(&pipeline->lines);
+        nodes = (NodeBatch *)ring_take(&pipeline->free_nodes);
+        nodes->count = 0;
+        reset_arena(&nodes->arena);
+
+        /* The nodes of the batch are allocated from the batch's arena */
+        line_arena = pipeline->parser_ctx.line_arena;
+        pipeline->parser_ctx.line_arena = nodes->arena;
+
+        for (pos = 0, i = 0; (item = next_line(&lines->items, &pos)) != NULL; i++) {
+            if (lines->kinds[i] == ITEM_MACRO) {
+                add_parser_macro(pipeline, item, line_count);
+            } else {
+                parse_item(pipeline, nodes, item, ++line_count);
+            }
+        }
+
+        nodes->arena = pipeline->parser_ctx.line_arena;
+        pipeline->parser_ctx.line_arena = line_arena;
+
+        last = nodes->last = lines->last;
+        ring_put(&pipeline->free_lines, lines);
+        ring_put(&pipeline->nodes, nodes);
+    }
+
+    pipeline->collides = late_macro_collides(pipeline);
+    return NULL;
+}
+
+/**
+ * The encoder stage - encodes the parsed lines with `first_phase_analyzer`, as the first phase
+ * does, after printing the messages of the parser and interning the new label operands in the
+ * label table of the program.
+ *
+ * @param pipeline The pipeline.
+ */
+static void encode_stage(Pipeline *pipeline) {
+    NodeBatch *nodes;     /* The batch of parsed lines */
+    Boolean last = FALSE; /* Flag indicating if all the lines were encoded */
+    int i;
+
+    while (last == FALSE) {
+        nodes = (NodeBatch *)ring_take(&pipeline->nodes);
+        for (i = 0; i < nodes->count; i++) {
+            encode_line(pipeline, &nodes->lines[i]);
+        }
+        last = nodes->last;
+        ring_put(&pipeline->free_nodes, nodes);
+    }
+}
+
+/* ---------------------------------------------------------------------------------------
+ *                                 Preprocessor Stage Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Adds the lines that the preprocessor added for a source line to a batch, followed by the name
+ * of the macro that the source line defined, if any.
+ *
+ * @param batch The batch of expanded lines.
+ * @param am_lines The preprocessed lines.
+ * @param pos Position of the first line added for the source line.
+ * @param defined_macro The name of the macro that the source line defined, or an empty string.
+ * @return TRUE if the lines were added, FALSE if memory allocation failed.
+ */
+static Boolean pass_lines(LineBatch *batch, const LineBuffer *am_lines, size_t pos, const char *defined_macro) {
+    const char *line; /* The current added line */
+
+    while ((line = next_line(am_lines, &pos)) != NULL) {
+        if (add_item(batch, line, ITEM_LINE) == FALSE) return FALSE;
+    }
+    if (defined_macro[0] != '\0') return add_item(batch, defined_macro, ITEM_MACRO);
+    return TRUE;
+}
+
+/**
+ * Adds an item to a batch of expanded lines.
+ *
+ * @param batch The batch of expanded lines.
+ * @param item The line or the name of the macro.
+ * @param kind The kind of the item - ITEM_LINE or ITEM_MACRO.
+ * @return TRUE if the item was added, FALSE if memory allocation failed.
+ */
+static Boolean add_item(LineBatch *batch, const char *item, char kind) {
+    char *kinds;  /* The grown kinds */
+    int capacity; /* The grown capacity */
+
+    if (batch->items.count == batch->capacity) {
+        capacity = (batch->capacity == 0) ? BATCH_LINES : batch->capacity * 2;
+        if (!(kinds = (char *)realloc(batch->kinds, (size_t)capacity))) return FALSE;
+        batch->kinds = kinds;
+        batch->capacity = capacity;
+    }
+    if (add_line(&batch->items, item) == FALSE) return FALSE;
+    batch->kinds[batch->items.count - 1] = kind;
+    return TRUE;
+}
+
+/* ---------------------------------------------------------------------------------------
+ *                                    Parser Stage Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Adds the name of a macro that the preprocessor defined to the macros of the parser. A macro
+ * defined after the first parsed line is also kept, to be checked against the parsed labels.
+ *
+ * @param pipeline The pipeline.
+ * @param name The name of the macro.
+ * @param line_count Number of lines parsed so far.
+ */
+static void add_parser_macro(Pipeline *pipeline, const char *name, int line_count) {
+    if (add_macr(&pipeline->parser_macros, name) != NO_ERROR) {
+        pipeline->parser_failed = TRUE;
+    } else if (line_count > 0 && add_line(&pipeline->late_macros, name) == FALSE) {
+        pipeline->parser_failed = TRUE;
+    }
+}
+
+/**
+ * Parses an expanded line into the next parsed line of a batch.
+ *
+ * @param pipeline The pipeline.
+ * @param batch The batch of parsed lines.
+ * @param line The expanded line.
+ * @param line_count The number of the line in the preprocessed file.
+ */
+static void parse_item(Pipeline *pipeline, NodeBatch *batch, const char *line, int line_count) {
+    AsmContext *ctx = &pipeline->parser_ctx;
+    ParsedLine *parsed;                                      /* The parsed line */
+    int first_label = pipeline->parser_labels.names.count;   /* ID of the next new label */
+    int errors = ctx->program_status.error_counter;         /* Number of errors before the line */
+    ASTNode *node;
+
+    if (!(parsed = next_parsed_line(batch))) {
+        pipeline->parser_failed = TRUE;
+        return;
+    }
+
+    node = parsed->node = parseLine(ctx, &pipeline->parser_macros, &pipeline->parser_labels, pipeline->am_name,
+                                    line_count, line);
+    parsed->error = get_error(ctx);
+    parsed->errors = ctx->program_status.error_counter - errors;
+    parsed->status = ctx->program_status.status;
+    parsed->file_error = ctx->program_status.file_error;
+
+    /* Keep the defined label, to be checked against the macros defined later */
+    if (node && node->label[0] != '\0' &&
+        intern_label(&pipeline->defined_labels, node->label, strlen(node->label)) == -1) {
+        pipeline->parser_failed = TRUE;
+    }
+
+    if (keep_parser_output(pipeline, parsed, first_label) == FALSE) pipeline->parser_failed = TRUE;
+    clear_error(ctx);
+}
+
+/**
+ * Keeps the messages that the parser printed for a line, and the names of the label operands
+ * that the line interned first, in the arena of the line's batch.
+ *
+ * @param pipeline The pipeline.
+ * @param parsed The parsed line.
+ * @param first_label The private ID of the first label that the line could intern.
+ * @return TRUE if the output was kept, FALSE if memory allocation failed.
+ */
+static Boolean keep_parser_output(Pipeline *pipeline, ParsedLine *parsed, int first_label) {
+    Arena *arena = &pipeline->parser_ctx.line_arena;
+    const char *label; /* The name of a new label */
+    int i;
+
+    /* ------------------------------------- The messages ------------------------------------- */
+    parsed->messages = NULL;
+    fflush(pipeline->parser_ctx.output);
+    parsed->messages_length = pipeline->parser_size - pipeline->parser_passed;
+    if (parsed->messages_length > 0) {
+        parsed->messages = arena_strndup(arena, pipeline->parser_messages + pipeline->parser_passed,
+                                         parsed->messages_length);
+        pipeline->parser_passed = pipeline->parser_size;
+        if (!parsed->messages) return FALSE;
+    }
+
+    /* ------------------------------------ The new labels ------------------------------------ */
+    parsed->label_count = pipeline->parser_labels.names.count - first_label;
+    parsed->labels = NULL;
+    if (parsed->label_count > 0) {
+        if (!(parsed->labels = (char **)arena_alloc(arena, (size_t)parsed->label_count * sizeof(char *)))) {
+            return FALSE;
+        }
+        for (i = 0; i < parsed->label_count; i++) {
+            label = label_name(&pipeline->parser_labels, first_label + i);
+            if (!(parsed->labels[i] = arena_strndup(arena, label, strlen(label)))) return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**
+ * Retrieves the next free parsed line of a batch, growing the batch if needed.
+ *
+ * @param batch The batch of parsed lines.
+ * @return The parsed line, or NULL if memory allocation failed.
+ */
+static ParsedLine *next_parsed_line(NodeBatch *batch) {
+    ParsedLine *lines; /* The grown lines */
+    int capacity;      /* The grown capacity */
+
+    if (batch->count == batch->capacity) {
+        capacity = (batch->capacity == 0) ? BATCH_LINES : batch->capacity * 2;
+        if (!(lines = (ParsedLine *)realloc(batch->lines, (size_t)capacity * sizeof(ParsedLine)))) return NULL;
+        batch->lines = lines;
+        batch->capacity = capacity;
+    }
+    return &batch->lines[batch->count++];
+}
+
+/**
+ * Checks if a macro that was defined after the first parsed line has the name of a parsed label.
+ * The sequential first phase checks the labels against all the macros, so such a label is an
+ * error that the parser did not report.
+ *
+ * @param pipeline The pipeline.
+ * @return TRUE if a late macro has the name of a label operand or a defined label, FALSE otherwise.
+ */
+static Boolean late_macro_collides(const Pipeline *pipeline) {
+    const char *name; /* The name of the current late macro */
+    size_t pos = 0;   /* Position of the next late macro */
+
+    while ((name = next_line(&pipeline->late_macros, &pos)) != NULL) {
+        if (find_label_id(&pipeline->parser_labels, name) != -1 ||
+            find_label_id(&pipeline->defined_labels, name) != -1) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* ---------------------------------------------------------------------------------------
+ *                                   Encoder Stage Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Encodes a parsed line as the first phase does after `parseLine` - the messages and the errors
+ * of the parser are applied to the encoder's context first, so the messages and the status are
+ * those of the sequential first phase.
+ *
+ * @param pipeline The pipeline.
+ * @param parsed The parsed line.
+ */
+static void encode_line(Pipeline *pipeline, ParsedLine *parsed) {
+    AsmContext *ctx = &pipeline->encoder_ctx;
+    int i;
+
+    /* ------------------------------- The output of the parser ------------------------------- */
+    if (parsed->messages_length > 0) fwrite(parsed->messages, 1, parsed->messages_length, ctx->output);
+    if (parsed->errors > 0) {
+        ctx->program_status.error_counter += parsed->errors;
+        ctx->program_status.status = parsed->status;
+    }
+    if (parsed->file_error == TRUE) ctx->program_status.file_error = TRUE;
+    for (i = 0; i < parsed->label_count; i++) {
+        add_label_id(pipeline, parsed->labels[i]);
+    }
+
+    /* If an error occurred - ASTNode is not completed, therefore cannot be encoded */
+    if (parsed->error == NO_ERROR && pipeline->encoder_failed == FALSE) {
+        remap_labels(pipeline, parsed->node);
+        first_phase_analyzer(ctx, parsed->node, pipeline->cmp_data);
+    }
+
+    /* Release the rest of the line's memory, and clear the error for the next line */
+    reset_arena(&ctx->line_arena);
+    clear_error(ctx);
+}
+
+/**
+ * Interns a label operand in the label table of the program, and maps its private ID to the ID
+ * in the table - the labels arrive in the order of their private IDs.
+ *
+ * @param pipeline The pipeline.
+ * @param label The name of the label.
+ */
+static void add_label_id(Pipeline *pipeline, const char *label) {
+    int *label_ids; /* The grown IDs */
+    int capacity;   /* The grown capacity */
+    int id;         /* The ID of the label in the label table */
+
+    if (pipeline->label_count == pipeline->label_capacity) {
+        capacity = (pipeline->label_capacity == 0) ? BATCH_LINES : pipeline->label_capacity * 2;
+        if (!(label_ids = (int *)realloc(pipeline->label_ids, (size_t)capacity * sizeof(int)))) {
+            pipeline->encoder_failed = TRUE;
+            return;
+        }
+        pipeline->label_ids = label_ids;
+        pipeline->label_capacity = capacity;
+    }
+
+    if ((id = intern_label(&pipeline->cmp_data->label_table, label, strlen(label))) == -1) {
+        pipeline->encoder_failed = TRUE;
+    }
+    pipeline->label_ids[pipeline->label_count++] = id;
+}
+
+/**
+ * Replaces the private IDs of the label operands of a parsed instruction with their IDs in the
+ * label table of the program.
+ *
+ * @param pipeline The pipeline.
+ * @param node The parsed line.
+ */
+static void remap_labels(const Pipeline *pipeline, ASTNode *node) {
+    InstructionOperand *operand; /* The current operand */
+    short i;
+
+    if (node->lineType != LINE_INSTRUCTION) return;
+    for (i = 1; i <= node->specific.instruction.num_operands; i++) {
+        operand = get_operand(node, i);
+        if (operand->adr_mode == ADDR_MODE_DIRECT && operand->value.label_id >= 0 &&
+            operand->value.label_id < pipeline->label_count) {
+            operand->value.label_id = pipeline->label_ids[operand->value.label_id];
+        }
+    }
+}
+
+/**
+ * Applies the first phase of the pipeline to the context of the assembly - prints the held
+ * messages and adds the errors, the warnings and the statistics of the encoder.
+ *
+ * @param ctx The context of the assembly process.
+ * @param pipeline The pipeline.
+ */
+static void commit_first_phase(AsmContext *ctx, Pipeline *pipeline) {
+    ProgramStatus *status = &pipeline->encoder_ctx.program_status;
+
+    /* The stream is closed to get the final messages - it is not used again */
+    fclose(pipeline->encoder_ctx.output);
+    pipeline->encoder_ctx.output = NULL;
+    if (pipeline->encoder_size > 0) fwrite(pipeline->encoder_messages, 1, pipeline->encoder_size, ctx->output);
+
+    ctx->program_status.error_counter += status->error_counter;
+    ctx->program_status.warning_counter += status->warning_counter;
+    if (status->status != ERROR_FREE_FILE) ctx->program_status.status = status->status;
+    if (status->file_error == TRUE) ctx->program_status.file_error = TRUE;
+    ctx->stats.unresolved_operands += pipeline->encoder_ctx.stats.unresolved_operands;
+}
@@ -7,220 +7,341 @@
 #include "../../structures/headers/macro_data.h"
 #include "../../utils/headers/utils.h"
 #include "../../structures/headers/mappings.h"
+#include "../../structures/headers/context.h"
+#include "../../utils/headers/source_file.h"
+#include "../headers/preprocessor.h"
 /* ---------------------------------------------------------------------------------------
  *                               Static Functions Prototypes
  * --------------------------------------------------------------------------------------- */
-static void process_line(FILE *source_file, FILE* output_file, MacroTrie *macro_trie, Location location);
-static Boolean validate_line_length(const char *line, Location location);
-static Boolean verify_macro(const char *str, Location location);
-static void remove_comments(char* str);
+static Boolean validate_line_length(AsmContext *ctx, size_t length, Location location);
+static char *copy_line(AsmContext *ctx, const char *line, size_t length, Boolean newline);
+static Location with_line_content(AsmContext *ctx, Location location, const char *span, size_t length);
+static Boolean verify_macro(AsmContext *ctx, const char *str, Location location);
 static int macr_start(const char* str);
 static int macr_end(const char* str);
-static Boolean create_macr(MacroTrie *macr_trie, const char *str, Location location);
-static void copy_macro_to_file(TrieNode *macr, FILE* file);
-static void cleanup_files(FILE* source_file, FILE* output_file, char* source_filename, char* output_filename);
+static Boolean create_macr(AsmContext *ctx, MacroTrie *macr_trie, const char *str, Location location);
+static Boolean copy_macro_to_lines(Symbol *macr, LineBuffer *am_lines);
+static void cleanup_files(SourceFile *source_file, FILE* output_file, char* source_filename, char* output_filename);
 /* ---------------------------------------------------------------------------------------
  *                               Head Function Of Preprocessor
  * --------------------------------------------------------------------------------------- */
 /**
  * The `preprocessor_controller` function handles preprocessing of the source file,
- * using `process_line` to process each line and apply macro expansions.
- * The processed output is written to a new file with the ".am" extension.
+ * using `preprocess_line` to process each line and apply macro expansions.
+ * The whole source file is read at once, and its lines are processed as spans of it.
+ * The processed output is kept in memory, in the specified line buffer. It is also written
+ * to a new file with the ".am" extension, only if specified so.
+ * A source that was read already - to calculate its key in the build cache - is not read again,
+ * so the processed content is exactly the content that was read.
  *
+ * @param ctx The context of the assembly process.
  * @param file_origin The base name of the source file without extension.
  * @param macro_trie A trie structure containing macro definitions for preprocessing.
+ * @param am_lines The line buffer that receives the processed lines.
+ * @param emit_am Flag indicating whether to write the processed lines to the ".am" file.
+ * @param source The content of the source file (.as) if it was read already, or NULL to read it.
  * @return The name of the output file with the ".am" extension, or NULL if an error occurs.
  */
-char *preprocessor_controller(const char *file_origin, MacroTrie *macro_trie) {
-    FILE* source_file = NULL;        /* The source file (.as) */
+char *preprocessor_controller(AsmContext *ctx, const char *file_origin, MacroTrie *macro_trie,
+                              LineBuffer *am_lines, Boolean emit_am, const SourceFile *source) {
+    return preprocess_file(ctx, file_origin, macro_trie, am_lines, emit_am, source, NULL, NULL);
+}
+
+/**
+ * Preprocesses a source file like `preprocessor_controller`, with the content of the file
+ * processed by the specified function instead of `preprocess_source`.
+ *
+ * @param ctx The context of the assembly process.
+ * @param file_origin The base name of the source file without extension.
+ * @param macro_trie A trie structure containing macro definitions for preprocessing.
+ * @param am_lines The line buffer that receives the processed lines.
+ * @param emit_am Flag indicating whether to write the processed lines to the ".am" file.
+ * @param source The content of the source file (.as) if it was read already, or NULL to read it.
+ * @param processor The function that processes the content, or NULL for `preprocess_source`.
+ * @param data The data passed to the processor.
+ * @return The name of the output file with the ".am" extension, or NULL if an error occurs.
+ */
+char *preprocess_file(AsmContext *ctx, const char *file_origin, MacroTrie *macro_trie, LineBuffer *am_lines,
+                      Boolean emit_am, const SourceFile *source, SourceProcessor processor, void *data) {
+    SourceFile source_file;          /* The content of the source file (.as), if read here */
+    SourceFile *read_file = NULL;    /* The source file to close, if read here */
+    ErrorCode read_result;           /* The result of reading the source file */
     FILE* output_file = NULL;        /* The output file (.am) */
     char* source_filename = NULL;    /* The source file name */
     char* output_filename = NULL;    /* The output file name */
-    Location location = {NULL, 0};   /* Location variable set to default */
 
     /* ------------- Create the source filename with the specified extension -------------*/
     if (!create_new_file_name(file_origin, &source_filename, ".as")) {
-        set_general_error(MEMORY_ALLOCATION_ERROR);
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
         return NULL;
     }
 
-    /* ----------------------- Open the source file in read mode ----------------------- */
-    if (!(source_file = fopen(source_filename, "r"))) {
-        /* If the file fails to open, set an error */
-        set_general_error(FAILED_OPEN_FILE);
-        /* Cleanup resources */
-        cleanup_files(source_file, NULL, source_filename, NULL);
-        return NULL;
+    /* ------------------- Read the whole source file, unless it was read ------------------- */
+    if (!source) {
+        if ((read_result = open_source_file(source_filename, &source_file)) != NO_ERROR) {
+            /* If the file fails to open, set an error */
+            set_general_error(ctx, read_result);
+            /* Cleanup resources */
+            cleanup_files(NULL, NULL, source_filename, NULL);
+            return NULL;
+        }
+        source = read_file = &source_file;
     }
 
     /* -------------- Create the output filename with the specified extension --------------*/
     if (!create_new_file_name(file_origin, &output_filename, ".am")) {
-        set_general_error(MEMORY_ALLOCATION_ERROR);
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
         /* Cleanup resources */
-        cleanup_files(source_file, NULL, source_filename, NULL);
+        cleanup_files(read_file, NULL, source_filename, NULL);
         return NULL;
     }
 
-    /* ------------------------ Open the output file in write mode ------------------------ */
-    if (!(output_file = fopen(output_filename, "w"))) {
-        /* If the file fails to open, set an error and return */
-        set_general_error(FAILED_CREATE_FILE);
-        /* Cleanup resources */
-        cleanup_files(source_file, NULL, source_filename, output_filename);
-        return NULL;
+    /* ------------------------ Process each line in the source file ------------------------ */
+    if (processor) {
+        processor(ctx, source->text, source->size, am_lines, source_filename, macro_trie, data);
+    } else {
+        preprocess_source(ctx, source->text, source->size, am_lines, source_filename, macro_trie);
     }
 
-    /* ------------------------ Process each line in the source file ------------------------ */
-    location.file = source_filename;
-    process_line(source_file, output_file, macro_trie, location);
+    /* -------------------------- Write the output file if specified -------------------------- */
+    if (emit_am == TRUE) {
+        if (!(output_file = fopen(output_filename, "w"))) {
+            /* If the file fails to open, set an error and return */
+            set_general_error(ctx, FAILED_CREATE_FILE);
+            /* Cleanup resources */
+            cleanup_files(read_file, NULL, source_filename, output_filename);
+            return NULL;
+        }
+        write_lines(am_lines, output_file);
+        /* Every line is kept with a null-terminator that is not written */
+        ctx->stats.bytes_written += (long)(am_lines->size - (size_t)am_lines->count);
+    }
 
-    /* ------------------------------------- Free memory ------------------------------------- */
-    free_trie_data(macro_trie);
     /* Cleanup resources */
-    cleanup_files(source_file, output_file, source_filename, NULL);
+    cleanup_files(read_file, output_file, source_filename, NULL);
     return output_filename;
 }
 
+/**
+ * Preprocesses the content of a source into a line buffer. Every line of the source is
+ * processed with `preprocess_line`, and the macros data is freed at the end - only the macros
+ * names are kept for the following phases.
+ * The lines are spans of the source: the end of every line is found with `next_source_line`.
+ *
+ * @param ctx The context of the assembly process.
+ * @param source The content of the source - it is not modified.
+ * @param size The number of characters in the content.
+ * @param am_lines The line buffer that receives the processed lines.
+ * @param source_name The name of the source file, used for error reporting.
+ * @param macro_trie A trie structure containing macro definitions for preprocessing.
+ */
+void preprocess_source(AsmContext *ctx, const char *source, size_t size, LineBuffer *am_lines,
+                       const char *source_name, MacroTrie *macro_trie) {
+    PreprocessorState state;  /* The state of the preprocessor between lines */
+    const char* span = NULL;  /* the read line - a span of the source */
+    size_t length = 0;        /* length of the span, including '\n' */
+    size_t pos = 0;           /* position of the next line to read */
+
+    init_preprocessor_state(&state, source_name);
+    while (get_status(ctx) != FATAL_ERROR && (span = next_source_line(source, size, &pos, &length)) != NULL) {
+        preprocess_line(ctx, &state, span, length, am_lines, macro_trie);
+    }
+
+    /* ------------------------------------- Free memory ------------------------------------- */
+    free_trie_data(macro_trie);
+}
+
+/**
+ * Initializes the state of the preprocessor for the first line of a source.
+ *
+ * @param state Pointer to the state to be initialized.
+ * @param source_name The name of the source file, used for error reporting.
+ */
+void init_preprocessor_state(PreprocessorState *state, const char *source_name) {
+    state->location.file = source_name;
+    state->location.line = 0;
+    state->location.line_content = NULL;
+    state->inside_macro = FALSE;
+    state->defined_macro[0] = '\0';
+}
+
 /* ---------------------------------------------------------------------------------------
  *                                           Functions
  * --------------------------------------------------------------------------------------- */
 /**
- * Processes each line of the source file, handling macro definitions and usages,
- * and writes the processed lines to the output file.
+ * Processes a single line of the source, handling macro definitions and usages,
+ * and adds the processed lines to the line buffer.
+ * The line is a span of the source, and a too long line is detected by the length of its span.
+ * Only the working copy of the line is made - its content is copied for the location only
+ * when it is reported, or when it defines a macro.
+ * When the line defines a macro, its name is kept in the state until the next line.
  *
- * @param source_file The input file pointer to the source file being read.
- * @param output_file The output file pointer where processed lines are written.
+ * @param ctx The context of the assembly process.
+ * @param state The state of the preprocessor - the location and whether a macro is being defined.
+ * @param span The line - a span of the source, including its '\n' if exists.
+ * @param length The number of characters in the span.
+ * @param am_lines The line buffer where processed lines are added.
  * @param macro_trie A trie structure containing macro definitions for preprocessing.
- * @param location A structure representing the current file and line number being processed.
  */
-static void process_line(FILE *source_file, FILE* output_file, MacroTrie *macro_trie, Location location) {
+void preprocess_line(AsmContext *ctx, PreprocessorState *state, const char *span, size_t length,
+                     LineBuffer *am_lines, MacroTrie *macro_trie) {
     char word[MAX_LINE_LENGTH] = {0};        /* string to hold one read word from line */
-    char line[MAX_LINE_LENGTH+1] = {0};                /* string to hold the read line */
-    char* line_ptr = NULL;                               /* pointer to go through line */
-    int ch;                                         /* variable to skip too long lines */
-    Boolean inside_macro = FALSE; /* flag that indicated if read line is part of macro */
-    TrieNode* macr_usage = NULL;         /* node to hold macro's data in case of usage */
-
-    while (fgets(line, sizeof(line), source_file) != NULL && get_status() != FATAL_ERROR) {
-        location.line++;                                     /* Update counter */
-        line_ptr = line;                     /* Set line pointer to line start */
-        trim_leading_spaces((const char **)&line_ptr);  /* Skip leading spaces */
-        save_line_content(&location, line_ptr);           /* Save line content */
-
-        /* Check if the line is too long */
-        if (validate_line_length(line, location) == FALSE) {
-            /* Skip the rest of the overly long line */
-            while ((ch = fgetc(source_file)) != '\n' && ch != EOF) {}
-            continue;
-        }
+    const char* line_end = NULL;                           /* end of the span of the line */
+    const char* content_end = NULL;    /* end of the line, without its comment and '\n' */
+    const char* comment = NULL;                         /* start of the comment if exists */
+    char* line_ptr = NULL;                           /* the line without leading spaces */
+    Symbol* macr_usage = NULL;         /* symbol to hold macro's data in case of usage */
+    Location location;                          /* the location of the current line */
+
+    state->location.line++;                                  /* Update counter */
+    state->defined_macro[0] = '\0';
+    location = state->location;
+    ctx->stats.lines_read++;
+
+    /* Check if the line is too long */
+    if (validate_line_length(ctx, length, location) == FALSE) {
+        return; /* The span ends at the end of the line - nothing left to skip */
+    }
 
-        /* Remove comments from the line */
-        remove_comments(line_ptr);
+    /* Skip leading spaces */
+    line_end = span + length;
+    while (span < line_end && is_space(*span)) span++;
 
-        /* If line is not empty - process the line */
-        if (sscanf(line_ptr, "%s", word) == 1) {
+    /* Remove the '\n' and the comment from the end of the line */
+    content_end = line_end;
+    if (content_end > span && content_end[-1] == '\n') content_end--;
+    if ((comment = (const char *)memchr(span, ';', content_end - span)) != NULL) content_end = comment;
 
-            /* -------------------- 1. End of macro initialization -------------------- */
-            if (macr_end(word)) {
-                inside_macro = FALSE;
-                /* verify end */
-                if (!is_empty_line(line_ptr+ strlen(word))) {
-                    set_error(EXTRA_TXT_MACR, location);
-                }
+    /* Working copy of the line without its comment - the source itself is read-only */
+    line_ptr = copy_line(ctx, span, content_end - span, (content_end < line_end) ? TRUE : FALSE);
+    if (!line_ptr) {
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+        return;
+    }
+
+    /* If line is not empty - process the line */
+    if (sscanf(line_ptr, "%s", word) == 1) {
+
+        /* -------------------- 1. End of macro initialization -------------------- */
+        if (macr_end(word)) {
+            state->inside_macro = FALSE;
+            /* verify end */
+            if (!is_empty_line(line_ptr+ strlen(word))) {
+                set_error(ctx, EXTRA_TXT_MACR, with_line_content(ctx, location, span, line_end - span));
             }
+        }
 
-            /* ------------------- 2. Inside of macro initialization ------------------- */
-            else if (inside_macro) {/* copy to macro */
-                add_line_to_last_macro(macro_trie, line_ptr);
+        /* ------------------- 2. Inside of macro initialization ------------------- */
+        else if (state->inside_macro) {/* copy to macro */
+            if (add_line_to_last_macro(macro_trie, line_ptr) == FALSE) {
+                set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+            } else {
+                ctx->stats.macro_line_nodes++;
             }
+        }
 
-            /* ------------------------ 3. Macro initialization ------------------------ */
-            else if (macr_start(word)) {
-                if (create_macr(macro_trie, line_ptr + strlen(word), location) == TRUE){
-                    inside_macro = TRUE; /* set flag */
-                }
+        /* ------------------------ 3. Macro initialization ------------------------ */
+        else if (macr_start(word)) {
+            location = with_line_content(ctx, location, span, line_end - span);
+            if (create_macr(ctx, macro_trie, line_ptr + strlen(word), location) == TRUE){
+                state->inside_macro = TRUE; /* set flag */
+                sscanf(line_ptr + strlen(word), "%s", state->defined_macro);
             }
+        }
 
-            /* --------------------------- 4. Existing macro --------------------------- */
-            else if ((macr_usage = find_macro(macro_trie, word) ) != NULL) {
-                /* check if there is no extra text after macro usage */
-                if (!is_empty_line(line_ptr+ strlen(word))) {
-                    set_error(EXTRA_TXT_MACR, location);
-                }
-                copy_macro_to_file(macr_usage, output_file);
+        /* --------------------------- 4. Existing macro --------------------------- */
+        else if ((macr_usage = find_macro(macro_trie, word, strlen(word)) ) != NULL) {
+            /* check if there is no extra text after macro usage */
+            if (!is_empty_line(line_ptr+ strlen(word))) {
+                set_error(ctx, EXTRA_TXT_MACR, with_line_content(ctx, location, span, line_end - span));
             }
+            if (copy_macro_to_lines(macr_usage, am_lines) == FALSE) {
+                set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+            }
+            ctx->stats.macros_expanded++;
+        }
 
-            /* ------------------------ 5. Regular command line ------------------------ */
-            else {
-                fputs(line_ptr, output_file);
+        /* ------------------------ 5. Regular command line ------------------------ */
+        else {
+            if (add_line(am_lines, line_ptr) == FALSE) {
+                set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
             }
         }
-        /* Free line content after parsing each line */
-        free_location(&location);
     }
+    /* Release the line content after parsing each line */
+    reset_arena(&ctx->line_arena);
 }
 
 /* ---------------------------------------------------------------------------------------
  *                                Preprocessor Utility Functions
  * --------------------------------------------------------------------------------------- */
-/**
- * Checks if a given string is a comment line.
- * A comment is defined as a line/part of the line that starts with the character ';'.
- * If the comment character is found, the function trims any characters after
- * the ';' character from the line, while preserving the newline character at
- * the end of the line if it exists.
- *
- * @param str The string to check and modify.
- */
-static void remove_comments(char* str) {
-    char *comment_start = NULL; /* Pointer to the start of a comment */
-    char *newline = NULL;       /* Pointer to newLine char if exists */
-    if (str) {
-        /* Comment starts with ';' */
-        comment_start = strchr(str, ';');
-        if (comment_start) {
-            newline = strchr(comment_start, '\n');
-            if (newline) { /* If there is a newLine char in the line */
-                /* Restore the newline character */
-                *comment_start = '\n';
-                /* Trim the rest of the line after ';' */
-                *(comment_start + 1) = '\0';
-            } else { /* No newLine char */
-                /* Trim the rest of the line after ';' */
-                *comment_start = '\0';
-            }
-        }
-    }
-}
-
 /**
  * Checks if a given line exceeds the maximum allowed length.
  * If the line is too long, it sets an error and returns FALSE.
  *
- * @param line The line to check.
+ * @param ctx The context of the assembly process.
+ * @param length The length of the line, including its '\n'.
  * @param location The current file location being processed.
  * @return TRUE if the line length is valid, FALSE otherwise.
  */
-static Boolean validate_line_length(const char *line, Location location) {
+static Boolean validate_line_length(AsmContext *ctx, size_t length, Location location) {
     /* Check if the length of the line exceeds the maximum allowed length */
-    if (strlen(line) >= MAX_LINE_LENGTH) {
-        free_location(&location); /* Scanning failed */
-        set_error(LINE_TOO_LONG, location);
+    if (length >= MAX_LINE_LENGTH) {
+        location.line_content = NULL; /* The line is not shown - it is too long */
+        set_error(ctx, LINE_TOO_LONG, location);
         return FALSE;
     }
     return TRUE;
 }
 
+/**
+ * Copies a line into the line arena, as a null-terminated string, that lives until the line
+ * arena is reset. A '\n' is added to the end of the copy if specified so.
+ *
+ * @param ctx The context of the assembly process.
+ * @param line The line to copy - a span of the source.
+ * @param length The number of characters to copy.
+ * @param newline Flag indicating whether to add a '\n' to the end of the copy.
+ * @return The copy of the line, or NULL if memory allocation failed.
+ */
+static char *copy_line(AsmContext *ctx, const char *line, size_t length, Boolean newline) {
+    char *copy = (char *)arena_alloc(&ctx->line_arena, length + 2);
+    if (!copy) return NULL; /* Memory allocation failure */
+
+    memcpy(copy, line, length);
+    if (newline == TRUE) copy[length++] = '\n';
+    copy[length] = '\0';
+    return copy;
+}
+
+/**
+ * Copies the content of a line into its location, to be shown with the messages of the line.
+ * The copy lives until the line arena is reset.
+ *
+ * @param ctx The context of the assembly process.
+ * @param location The location of the line.
+ * @param span The line without its leading spaces - a span of the source.
+ * @param length The number of characters in the span.
+ * @return The location with the content of the line, or without content if memory allocation failed.
+ */
+static Location with_line_content(AsmContext *ctx, Location location, const char *span, size_t length) {
+    if (!(location.line_content = copy_line(ctx, span, length, FALSE))) {
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+    }
+    return location;
+}
+
 /**
 * Verifies the validity of a macro initialization line.
 * It checks if the macro has a valid name: if the name is not a reserved word,
 * and if there is no extra text after the macro name.
 *
+* @param ctx The context of the assembly process.
 * @param str The string to verify as a macro initialization line.
 * @param location The current file location being processed.
 * @return TRUE if the macro initialization line is valid, FALSE otherwise.
 */
-static Boolean verify_macro(const char *str, Location location) {
+static Boolean verify_macro(AsmContext *ctx, const char *str, Location location) {
     char word[MAX_LINE_LENGTH] = {0};   /* string to hold one read word from str */
 
     /* If macro don't have name */
@@ -229,13 +350,13 @@ static Boolean verify_macro(const char *str, Location location) {
 
     /* Macro name is reserved name */
     if (reserved_word(word)) {
-        set_error(MACR_RESERVED_WORD, location);
+        set_error(ctx, MACR_RESERVED_WORD, location);
         return FALSE;
     }
 
     /* Macro initialization line contain extra text */
     if (is_empty_line(str + strlen(word) + 1) == FALSE) {
-        set_error(EXTRA_TXT_MACR, location);
+        set_error(ctx, EXTRA_TXT_MACR, location);
         return FALSE;
 
     }
@@ -266,32 +387,34 @@ static int macr_end(const char* str) {
  * Creates a new macro in the macro trie if the given string
  * is a valid macro initialization line.
  *
+ * @param ctx The context of the assembly process.
  * @param macr_trie The trie structure containing macro definitions.
  * @param str The string containing the macro initialization line.
  * @param location The current file location being processed.
  * @return TRUE if the macro was successfully created, FALSE otherwise.
  */
-static Boolean create_macr(MacroTrie *macr_trie, const char *str, Location location) {
+static Boolean create_macr(AsmContext *ctx, MacroTrie *macr_trie, const char *str, Location location) {
     /* Remove leading and trailing spaces from the string */
     trim_spaces(&str);
 
     /* Verify the macro initialization line */
-    if (verify_macro(str, location) == TRUE) {
+    if (verify_macro(ctx, str, location) == TRUE) {
         /* Add the macro to the trie and return the status of this process */
         switch (add_macr(macr_trie, str)) {
             case INVALID_CHAR:
-                set_error(INVALID_CHAR_MACR, location);
+                set_error(ctx, INVALID_CHAR_MACR, location);
                 break;
 
             case DUPLICATE:
-                set_error(MACR_DUPLICATE, location);
+                set_error(ctx, MACR_DUPLICATE, location);
                 break;
 
             case MEMORY_ALLOCATION_ERROR:
-                set_general_error(MEMORY_ALLOCATION_ERROR);
+                set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
                 break;
 
             default: /* Process succeeded */
+                ctx->stats.macros_defined++;
                 return TRUE;
         }
         /* Process Failed */
@@ -303,22 +426,24 @@ static Boolean create_macr(MacroTrie *macr_trie, const char *str, Location locat
 }
 
 /**
- * Copies the contents of a macro to the specified output file.
+ * Copies the contents of a macro to the end of the specified line buffer.
  *
- * @param macr The macro node containing the macro data to copy.
- * @param file The output file to write the macro contents to.
+ * @param macr The macro symbol containing the macro data to copy.
+ * @param am_lines The line buffer to add the macro contents to.
+ * @return TRUE if the contents are copied successfully, FALSE if memory allocation failed.
  */
-static void copy_macro_to_file(TrieNode *macr, FILE* file) {
-    /* Retrieve the macro data from the trie node */
+static Boolean copy_macro_to_lines(Symbol *macr, LineBuffer *am_lines) {
+    /* Retrieve the macro data from the symbol */
     MacroData* data = (MacroData*) macr->data;
     /* Get the head of the line list in the macro data */
     LineNode* current = data->head;
 
-    /* Iterate over each line and write it to the output file */
+    /* Iterate over each line and add it to the line buffer */
     while (current != NULL) {
-        fputs(current->line, file);
+        if (add_line(am_lines, current->line) == FALSE) return FALSE;
         current = current->next;
     }
+    return TRUE;
 }
 
 /**
@@ -326,14 +451,14 @@ static void copy_macro_to_file(TrieNode *macr, FILE* file) {
  * This helper function is used to centralize the cleanup process . It closes any open files and frees
  * any allocated memory for filenames if they are not NULL.
  *
- * @param source_file Pointer to the source file to be closed. If NULL, no action is taken.
+ * @param source_file Pointer to the source file to be released. If NULL, no action is taken.
  * @param output_file Pointer to the output file to be closed. If NULL, no action is taken.
  * @param source_filename Pointer to the source filename string to be freed. If NULL, no action is taken.
  * @param output_filename Pointer to the output filename string to be freed. If NULL, no action is taken.
  */
-static void cleanup_files(FILE* source_file, FILE* output_file, char* source_filename, char* output_filename) {
+static void cleanup_files(SourceFile *source_file, FILE* output_file, char* source_filename, char* output_filename) {
     /* Close files */
-    if (source_file) fclose(source_file);
+    if (source_file) close_source_file(source_file);
     if (output_file) fclose(output_file);
 
     /* Free files names */
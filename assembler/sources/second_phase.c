@@ -3,31 +3,66 @@
  * --------------------------------------------------------------------------------------- */
 #include "../../structures/headers/ast.h"
 #include "../../structures/headers/cmp_data.h"
+#include "../headers/second_phase.h"
 #include "../headers/code_convert.h"
-#include "../../utils/headers/output_files.h"
+/* ---------------------------------------------------------------------------------------
+ *                                         Structures
+ * --------------------------------------------------------------------------------------- */
+/* Cursor going forward through the preprocessed lines, for finding the content of a line */
+typedef struct {
+    const LineBuffer *lines; /* The preprocessed lines */
+    size_t pos;              /* Position of the next line in the buffer */
+    int line_num;            /* Number of the current line */
+    const char *line;        /* Content of the current line */
+} LineCursor;
 /* ---------------------------------------------------------------------------------------
  *                               Static Functions Prototypes
  * --------------------------------------------------------------------------------------- */
-static void code_label_operands(ASTNode *node, CmpData *cmp_data);
-static void handle_entry(ASTNode *node, CmpData *cmp_data);
+static ErrorCode code_label_operand(AsmContext *ctx, Fixup *fixup, CmpData *cmp_data);
+static Boolean handle_entry(AsmContext *ctx, Fixup *fixup, LineCursor *cursor, CmpData *cmp_data);
+static Location fixup_location(const Fixup *fixup, LineCursor *cursor);
 
 /* ---------------------------------------------------------------------------------------
  *                                Head Function Of Second Phase
  * --------------------------------------------------------------------------------------- */
 /**
- * The `second_phase_analyzer` function processes an unresolved line during the second phase of assembly.
- * It handles encoding of label operand's in instruction lines and entry directives.
+ * The `second_phase_analyzer` function resolves the fixups recorded during the first phase.
+ * It encodes the label operands of the instruction lines and handles the entry directives,
+ * in the order of the source lines. Once a reference of a line fails, the rest of the
+ * references of that line are ignored.
  *
- * @param node The parsed line represented as an ASTNode containing an instruction or directive.
- * @param cmp_data The data structure holding the memory image and the label trie.
- * @return TRUE if the line is processed successfully, FALSE otherwise.
+ * @param ctx The context of the assembly process.
+ * @param am_lines The preprocessed lines, used for error reporting.
+ * @param cmp_data The data structure holding the memory image, the label trie and the fixups.
  */
-void second_phase_analyzer(ASTNode *node, CmpData *cmp_data) {
-    /* Handle operation line */
-    if (node->lineType == LINE_INSTRUCTION) {
-        code_label_operands(node, cmp_data);
-    } else { /* Handle directive line */
-        handle_entry(node, cmp_data);
+void second_phase_analyzer(AsmContext *ctx, const LineBuffer *am_lines, CmpData *cmp_data) {
+    Fixup *fixup = NULL;                    /* The current fixup */
+    int i;                                  /* Index of the current fixup */
+    LineCursor cursor = {NULL, 0, 0, NULL}; /* Cursor for finding the content of lines */
+    int failed_line = 0;                    /* The last line with a failed reference */
+    Location location;                      /* Location of a failed reference */
+    ErrorCode resolved;                     /* Result of resolving the reference */
+
+    cursor.lines = am_lines;
+
+    for (i = 0; i < cmp_data->fixups.count; i++) {
+        fixup = &cmp_data->fixups.items[i];
+        if (fixup->location.line != failed_line) {
+            /* Resolve the reference */
+            if (fixup->type == FIXUP_OPERAND) {
+                resolved = code_label_operand(ctx, fixup, cmp_data);
+            } else {
+                resolved = (handle_entry(ctx, fixup, &cursor, cmp_data) == TRUE) ? NO_ERROR : UNRECOGNIZED_LABEL;
+            }
+
+            /* The label of the reference is not recognized, or its address does not fit */
+            if (resolved != NO_ERROR) {
+                location = fixup_location(fixup, &cursor);
+                set_error(ctx, resolved, location);
+                free_location(&location);
+                failed_line = fixup->location.line;
+            }
+        }
     }
 }
 
@@ -35,84 +70,79 @@ void second_phase_analyzer(ASTNode *node, CmpData *cmp_data) {
  *                                         Functions
  * --------------------------------------------------------------------------------------- */
 /**
- * The `code_label_operands` function encodes the label operands of an instruction during the second
- * phase of assembly. It resolves the addresses of labels used in direct addressing mode.
+ * The `code_label_operand` function encodes a label operand of an instruction during the second
+ * phase of assembly. It resolves the address of the label into the word recorded by the fixup.
  *
- * @param node The parsed line represented as an ASTNode containing the instruction and its operands.
+ * @param ctx The context of the assembly process.
+ * @param fixup The fixup of the label operand.
  * @param cmp_data The data structure holding various program-related data during assembly.
- * @return TRUE if the operands are processed and encoded successfully, FALSE otherwise.
+ * @return NO_ERROR if the operand is encoded successfully, the error of the label otherwise.
  */
-static void code_label_operands(ASTNode *node, CmpData *cmp_data) {
-    InstructionOperand *current_opr; /* Variable to store the current operand */
-    short i;                     /* Variable to iterate through nodes operand */
-    int line;            /* Variable to store the consecutive unresolved line */
-
-    /* Iterate through node's operands */
-    for (i = 1; i <= node->specific.instruction.num_operands; i++) {
-        /* Get the current operand */
-        current_opr = get_operand(node, i);
-
-        /* If this is operand of type label - encode */
-        if (current_opr->adr_mode == ADDR_MODE_DIRECT) {
-            /* Get the unresolved line */
-            line = get_marked_line(&cmp_data->image, FALSE);
+static ErrorCode code_label_operand(AsmContext *ctx, Fixup *fixup, CmpData *cmp_data) {
+    cmp_data->image.code_pos = fixup->address; /* Set writer to the relevant address */
 
-            if (line != -1) { /* If line exists */
-                unmark_word(&cmp_data->image, line); /* Unmark the line */
-                cmp_data->image.code_pos = line; /* Set writer to the relevant address */
-
-                /* Encode the label */
-                if (code_direct_addr_mode(current_opr->value.char_val, cmp_data) == FALSE) {
-                    /* If an error occurred - return FALSE */
-                    set_error(UNRECOGNIZED_LABEL, node->location);
-                    return;
-                }
-            }
-        }
-    }
+    /* Encode the label */
+    return code_direct_addr_mode(ctx, fixup->label_id, cmp_data);
 }
 
 /**
- * The `handle_entry` function processes an entry directive during the second phase of assembly.
- * It resolves the addresses of entry labels and writes them to the entry file.
+ * The `handle_entry` function processes a label of an entry directive during the second phase
+ * of assembly. It resolves the address of the entry label and writes it to the entry file.
  *
- * @param node The parsed line represented as an ASTNode containing the entry directive and its operands.
+ * @param ctx The context of the assembly process.
+ * @param fixup The fixup of the entry label.
+ * @param cursor Cursor for finding the content of the line, for printing warnings.
  * @param cmp_data The data structure holding various program-related data during assembly.
- * @return TRUE if the entry labels are processed and resolved successfully, FALSE otherwise.
+ * @return TRUE if the entry label is handled, FALSE if the label is not recognized.
  */
-static void handle_entry(ASTNode *node, CmpData *cmp_data){
-    /* Variable to store the current operand */
-    DirNode *current = node->specific.directive.operands;
-    /* Variable to store the current label type */
-    LabelType type = get_label_type(&cmp_data->label_table, current->operand);
-    int address; /* Variable to store the current label address */
+static Boolean handle_entry(AsmContext *ctx, Fixup *fixup, LineCursor *cursor, CmpData *cmp_data) {
+    /* The entry label - resolved by its ID */
+    LabelData *label = &cmp_data->label_table.labels[fixup->label_id];
+    Location location; /* Location of the entry, for printing warnings */
 
-    while (current) {
-        /* Label was already set as entry */
-        if (type == ENTERNAL) {
-            /* Print warning that this line will be ignored */
-            print_warning(ENTRY_DUPLICATE, &node->location);
-            continue;
-        }
+    /* Label was already set as entry */
+    if (label->label_type == ENTERNAL) {
+        /* Print warning that this declaration will be ignored */
+        location = fixup_location(fixup, cursor);
+        print_warning(ctx, ENTRY_DUPLICATE, &location);
+        free_location(&location);
+        return TRUE;
+    }
 
-        if (type == EXTERNAL) {
-            set_error(UNRECOGNIZED_LABEL, node->location);
-            break;
-        }
+    /* External label can not be an entry, and an unknown label can not be set as entry */
+    if (label->label_type == EXTERNAL || label->label_type == UNDEFINED) {
+        return FALSE;
+    }
+    label->label_type = ENTERNAL;
 
-        /* Set label type to ENTERNAL */
-        if (set_label_type(&cmp_data->label_table, current->operand, ENTERNAL) == FALSE){
-            set_error(UNRECOGNIZED_LABEL, node->location);
-            break;
-        }
+    /* Add the label and its address to the lines of the entry file */
+    if (add_label_record(&cmp_data->entries, label_name(&cmp_data->label_table, fixup->label_id),
+                         resolve_label_address(cmp_data, fixup->label_id)) == FALSE) {
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+    }
+    return TRUE;
+}
+
+/**
+ * Retrieves the location of the specified fixup, including a copy of the line content.
+ * The fixups are in the order of the lines, therefore the cursor only goes forward.
+ * The returned location should be freed with `free_location`.
+ *
+ * @param fixup The fixup to retrieve its location.
+ * @param cursor Cursor for finding the content of the line.
+ * @return The location of the fixup. The line content is NULL if memory allocation failed.
+ */
+static Location fixup_location(const Fixup *fixup, LineCursor *cursor) {
+    Location location = fixup->location;
 
-        /* Get the entry label address */
-        address = get_label_addr(&cmp_data->label_table, current->operand);
-        /* Write the data in the entry file */
-        write_label(current->operand, address, cmp_data->entry_file.file);
-        /* Get the next operand */
-        current = (DirNode *) current->next;
+    /* Move the cursor forward to the line of the fixup */
+    while (cursor->line_num < location.line &&
+           (cursor->line = next_line(cursor->lines, &cursor->pos)) != NULL) {
+        cursor->line_num++;
     }
 
-    cmp_data->entry_file.delete = FALSE; /* Set flag to false - non-empty file should not be deleted */
+    if (cursor->line && cursor->line_num == location.line) {
+        save_line_content(&location, cursor->line);
+    }
+    return location;
 }
\ No newline at end of file
@@ -0,0 +1,439 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../headers/server.h"
+#include "../headers/assembler_controller.h"
+#include "../headers/assembler_lib.h"
+#include "../../utils/headers/frames.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Largest argument, working directory or name of a request */
+#define MAX_FIELD_SIZE 4096
+/* Largest inline source of a request */
+#define MAX_SOURCE_SIZE (64UL * 1024 * 1024)
+/* Largest number of arguments of a request */
+#define MAX_REQUEST_ARGS 65536
+/* Number of connections waiting to be accepted */
+#define LISTEN_BACKLOG 16
+/* The program name that the arguments of a request are passed after */
+#define PROGRAM_NAME "assembler_exe"
+/* The base name of an inline source without a name */
+#define DEFAULT_SOURCE_NAME "source"
+/* ---------------------------------------------------------------------------------------
+ *                                         Structures
+ * --------------------------------------------------------------------------------------- */
+/* Enum representing the result of reading a request */
+typedef enum {
+    REQUEST_READ,    /* A complete request was read */
+    REQUEST_END,     /* The stream ended before a request started */
+    REQUEST_INVALID  /* The request is invalid, too large or memory allocation failed */
+} RequestResult;
+
+/* Structure representing one request of a client */
+typedef struct {
+    char *cwd;           /* The working directory of the file names, or NULL */
+    char **args;         /* The command line, starting with the program name */
+    int count;           /* Number of arguments, including the program name */
+    int capacity;        /* Number of allocated arguments */
+    char *name;          /* The base name of the inline source, or NULL */
+    char *source;        /* The inline source, or NULL if the request carries a command line */
+    size_t source_size;  /* The size of the inline source in bytes */
+} Request;
+/* ---------------------------------------------------------------------------------------
+ *                                      Static Variables
+ * --------------------------------------------------------------------------------------- */
+/* Flag set by SIGINT and SIGTERM - the server stops after the current request */
+static volatile sig_atomic_t stop_requested = 0;
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static int open_listener(const char *path);
+static Boolean fill_address(struct sockaddr_un *address, const char *path);
+static void handle_stop(int signal_number);
+static void serve_stream(AsmWorkspace *workspace, FILE *in, FILE *out, int home);
+static RequestResult read_request(FILE *in, Request *request);
+static Boolean add_field(Request *request, const char *tag, char *data, size_t size);
+static Boolean serve_command_line(AsmWorkspace *workspace, Request *request, FILE *out, int home);
+static Boolean serve_source(AsmWorkspace *workspace, const Request *request, FILE *out);
+static Boolean write_reply_end(FILE *out, Status status);
+static Boolean write_error(FILE *out, const char *message);
+static void free_request(Request *request);
+/* ---------------------------------------------------------------------------------------
+ *                                 Head Function Of Server
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Runs the assembler as a server on the specified socket, or on the standard input and output.
+ * The connections are served one at a time in a single workspace, which is reset after every
+ * request - the working directory is restored after every request as well.
+ *
+ * @param ctx The context for reporting errors of the server itself.
+ * @param path The path of the socket, or "-" for the standard input and output.
+ * @return FATAL_ERROR if memory allocation failed, ERROR_IN_FILE if the socket cannot be created,
+ *         ERROR_FREE_FILE otherwise.
+ */
+Status run_server(AsmContext *ctx, const char *path) {
+    AsmWorkspace workspace;   /* The workspace that all the requests are assembled in */
+    struct sigaction action;  /* The handler of SIGINT and SIGTERM */
+    int listener;             /* The listening socket */
+    int connection;           /* The socket of the current client */
+    int home;                 /* The working directory of the server */
+    FILE *in, *out;           /* Streams of the current client */
+
+    if ((home = open(".", O_RDONLY)) == -1 || init_workspace(&workspace, NULL, MEMORY_WORDS) == FALSE) {
+        if (home != -1) close(home);
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+        return get_status(ctx);
+    }
+
+    /* Requests from the standard input, replies to the standard output */
+    if (strcmp(path, "-") == 0) {
+        serve_stream(&workspace, stdin, stdout, home);
+        free_workspace(&workspace);
+        close(home);
+        return ERROR_FREE_FILE;
+    }
+
+    if ((listener = open_listener(path)) == -1) {
+        set_general_error(ctx, SERVER_SOCKET_ERROR);
+        free_workspace(&workspace);
+        close(home);
+        return get_status(ctx);
+    }
+
+    /* A client that disconnects must not stop the server; a stop signal ends the accept loop */
+    signal(SIGPIPE, SIG_IGN);
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_stop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    while (!stop_requested) {
+        if ((connection = accept(listener, NULL, NULL)) == -1) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            break;
+        }
+
+        in = fdopen(connection, "r");
+        out = in ? fdopen(dup(connection), "w") : NULL;
+        if (in && out) serve_stream(&workspace, in, out, home);
+
+        if (out) fclose(out);
+        if (in) fclose(in);
+        else close(connection);
+    }
+
+    close(listener);
+    unlink(path);
+    free_workspace(&workspace);
+    close(home);
+    return ERROR_FREE_FILE;
+}
+
+/**
+ * Connects to the server listening on the specified socket.
+ *
+ * @param path The path of the socket.
+ * @return The descriptor of the connection, or -1 if no server is listening on the socket.
+ */
+int connect_server(const char *path) {
+    struct sockaddr_un address; /* The address of the socket */
+    int fd;                     /* The descriptor of the connection */
+
+    if (fill_address(&address, path) == FALSE) return -1;
+    if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1) return -1;
+    if (connect(fd, (struct sockaddr *)&address, sizeof(address)) == -1) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Creates the listening socket at the specified path. A socket left by a server that is
+ * no longer running is replaced - a socket with a live server, or any other file, is not.
+ *
+ * @param path The path of the socket.
+ * @return The descriptor of the listening socket, or -1 if it cannot be created.
+ */
+static int open_listener(const char *path) {
+    struct sockaddr_un address; /* The address of the socket */
+    struct stat info;           /* The file at the path */
+    int fd;                     /* The descriptor of the connection or the socket */
+
+    if (fill_address(&address, path) == FALSE) return -1;
+
+    if (stat(path, &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) return -1;
+        if ((fd = connect_server(path)) != -1) { /* Another server is running */
+            close(fd);
+            return -1;
+        }
+        unlink(path);
+    }
+
+    if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1) return -1;
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) == -1 || listen(fd, LISTEN_BACKLOG) == -1) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * Fills the address of a Unix domain socket.
+ *
+ * @param address Pointer to the address to fill.
+ * @param path The path of the socket.
+ * @return TRUE if the path fits in the address, FALSE otherwise.
+ */
+static Boolean fill_address(struct sockaddr_un *address, const char *path) {
+    memset(address, 0, sizeof(*address));
+    if (*path == '\0' || strlen(path) >= sizeof(address->sun_path)) return FALSE;
+
+    address->sun_family = AF_UNIX;
+    strcpy(address->sun_path, path);
+    return TRUE;
+}
+
+/**
+ * Handles SIGINT and SIGTERM - asks the server to stop.
+ *
+ * @param signal_number The number of the signal.
+ */
+static void handle_stop(int signal_number) {
+    (void)signal_number;
+    stop_requested = 1;
+}
+
+/**
+ * Serves the requests of a single stream until it ends, a request is invalid or a reply
+ * cannot be written.
+ *
+ * @param workspace The workspace to assemble the requests in.
+ * @param in The stream of the requests.
+ * @param out The stream of the replies.
+ * @param home The working directory of the server, restored after every request.
+ */
+static void serve_stream(AsmWorkspace *workspace, FILE *in, FILE *out, int home) {
+    Request request;        /* The current request */
+    RequestResult result;   /* The result of reading the request */
+    Boolean served = TRUE;  /* Flag indicating if the reply was written */
+
+    while (served == TRUE && !stop_requested) {
+        if ((result = read_request(in, &request)) == REQUEST_READ) {
+            served = request.source ? serve_source(workspace, &request, out)
+                                    : serve_command_line(workspace, &request, out, home);
+        } else if (result == REQUEST_INVALID) {
+            write_error(out, "invalid request");
+            served = FALSE;
+        } else {
+            served = FALSE;
+        }
+        free_request(&request);
+    }
+}
+
+/**
+ * Reads the frames of a single request, up to its "END" frame.
+ *
+ * @param in The stream of the requests.
+ * @param request Pointer to store the request - must be freed with `free_request` in any case.
+ * @return REQUEST_READ if a request was read, REQUEST_END if the stream ended before a request
+ *         started, REQUEST_INVALID otherwise.
+ */
+static RequestResult read_request(FILE *in, Request *request) {
+    char tag[FRAME_TAG_LENGTH];  /* The tag of the current frame */
+    char *data;                  /* The data of the current frame */
+    size_t size;                 /* The size of the data */
+    Boolean started = FALSE;     /* Flag indicating if a frame of the request was read */
+
+    memset(request, 0, sizeof(*request));
+    if (!(request->args = (char **)malloc(sizeof(char *)))) return REQUEST_INVALID;
+    request->capacity = 1;
+    request->args[request->count++] = NULL; /* The program name, set when the request is served */
+
+    while (read_frame(in, tag, &data, &size, MAX_SOURCE_SIZE) == TRUE) {
+        started = TRUE;
+        if (strcmp(tag, "END") == 0) {
+            free(data);
+            /* A request carries either a command line or an inline source */
+            return (request->source && (request->count > 1 || request->cwd)) ? REQUEST_INVALID : REQUEST_READ;
+        }
+        if (add_field(request, tag, data, size) == FALSE) {
+            free(data);
+            return REQUEST_INVALID;
+        }
+    }
+    return (started == FALSE && feof(in)) ? REQUEST_END : REQUEST_INVALID;
+}
+
+/**
+ * Adds a frame to the request - takes the ownership of its data if the frame is valid.
+ *
+ * @param request Pointer to the request.
+ * @param tag The tag of the frame.
+ * @param data The data of the frame.
+ * @param size The size of the data in bytes.
+ * @return TRUE if the frame was added, FALSE if it is unknown, repeated, too large or memory
+ *         allocation failed.
+ */
+static Boolean add_field(Request *request, const char *tag, char *data, size_t size) {
+    char **new_args; /* The grown array of arguments */
+
+    if (strcmp(tag, "SOURCE") == 0) {
+        if (request->source) return FALSE;
+        request->source = data;
+        request->source_size = size;
+        return TRUE;
+    }
+
+    /* The other fields are strings - short, and without null characters */
+    if (size > MAX_FIELD_SIZE || strlen(data) != size) return FALSE;
+
+    if (strcmp(tag, "ARG") == 0) {
+        if (request->count == MAX_REQUEST_ARGS) return FALSE;
+        if (request->count == request->capacity) {
+            new_args = (char **)realloc(request->args, 2 * request->capacity * sizeof(char *));
+            if (!new_args) return FALSE;
+            request->args = new_args;
+            request->capacity *= 2;
+        }
+        request->args[request->count++] = data;
+    } else if (strcmp(tag, "CWD") == 0 && !request->cwd) {
+        request->cwd = data;
+    } else if (strcmp(tag, "NAME") == 0 && !request->name && size > 0) {
+        request->name = data;
+    } else {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/**
+ * Assembles the command line of a request, the same as `assembler_exe` in the working directory
+ * of the request, and writes the printed messages and the status as the reply.
+ *
+ * @param workspace The workspace to assemble the files in.
+ * @param request The request.
+ * @param out The stream of the replies.
+ * @param home The working directory of the server, restored at the end.
+ * @return TRUE if the reply was written, FALSE otherwise.
+ */
+static Boolean serve_command_line(AsmWorkspace *workspace, Request *request, FILE *out, int home) {
+    static char program_name[] = PROGRAM_NAME;
+    char *messages = NULL;  /* The printed messages */
+    size_t size = 0;        /* The size of the messages */
+    FILE *output;           /* Stream capturing the messages */
+    Status status;          /* The status of the command line */
+    Boolean written;        /* Flag indicating if the reply was written */
+
+    if (!(output = open_memstream(&messages, &size))) return write_error(out, "memory allocation failed");
+    if (request->cwd && chdir(request->cwd) == -1) {
+        fclose(output);
+        free(messages);
+        return write_error(out, "cannot change to the working directory");
+    }
+
+    request->args[0] = program_name;
+    workspace->ctx.output = output;
+    status = assemble_command_line(request->count, request->args, workspace);
+    request->args[0] = NULL;
+    workspace->ctx.output = NULL;
+    if (fchdir(home) == -1) status = FATAL_ERROR;
+    fclose(output);
+
+    written = (write_frame(out, "OUTPUT", messages, size) == TRUE && write_reply_end(out, status) == TRUE)
+              ? TRUE : FALSE;
+    free(messages);
+    return written;
+}
+
+/**
+ * Assembles the inline source of a request in memory, and writes the outputs and the status
+ * as the reply.
+ *
+ * @param workspace The workspace to assemble the source in.
+ * @param request The request.
+ * @param out The stream of the replies.
+ * @return TRUE if the reply was written, FALSE otherwise.
+ */
+static Boolean serve_source(AsmWorkspace *workspace, const Request *request, FILE *out) {
+    AsmOutput output;  /* The outputs of the assembly */
+    Boolean written;   /* Flag indicating if the reply was written */
+
+    /* A previous command line may have changed the size of the memory */
+    set_memory_words(&workspace->cmp_data, MEMORY_WORDS);
+    assemble_buffer_in(workspace, request->name ? request->name : DEFAULT_SOURCE_NAME,
+                       request->source, request->source_size, &output);
+
+    written = ((output.object.data == NULL ||
+               write_frame(out, "OBJECT", output.object.data, output.object.size) == TRUE) &&
+              (output.entries.data == NULL ||
+               write_frame(out, "ENTRIES", output.entries.data, output.entries.size) == TRUE) &&
+              (output.externals.data == NULL ||
+               write_frame(out, "EXTERNALS", output.externals.data, output.externals.size) == TRUE) &&
+              write_frame(out, "DIAGNOSTICS", output.diagnostics.data, output.diagnostics.size) == TRUE &&
+              write_reply_end(out, output.status) == TRUE) ? TRUE : FALSE;
+
+    free_asm_output(&output);
+    return written;
+}
+
+/**
+ * Writes the status frame and the end frame of a reply, and flushes the reply.
+ *
+ * @param out The stream of the replies.
+ * @param status The status of the request.
+ * @return TRUE if the frames were written, FALSE otherwise.
+ */
+static Boolean write_reply_end(FILE *out, Status status) {
+    const char *name = status_name(status); /* The name of the status */
+
+    return (write_frame(out, "STATUS", name, strlen(name)) == TRUE && write_frame(out, "END", NULL, 0) == TRUE &&
+            fflush(out) == 0) ? TRUE : FALSE;
+}
+
+/**
+ * Writes a reply of a request that cannot be served - an error frame and the end frame,
+ * and flushes the reply.
+ *
+ * @param out The stream of the replies.
+ * @param message The reason the request was not served.
+ * @return TRUE if the frames were written, FALSE otherwise.
+ */
+static Boolean write_error(FILE *out, const char *message) {
+    return (write_frame(out, "ERROR", message, strlen(message)) == TRUE && write_frame(out, "END", NULL, 0) == TRUE &&
+            fflush(out) == 0) ? TRUE : FALSE;
+}
+
+/**
+ * Frees the memory of a request.
+ *
+ * @param request Pointer to the request to be freed.
+ */
+static void free_request(Request *request) {
+    int i; /* Index for iterating through the arguments */
+
+    for (i = 1; i < request->count; i++) free(request->args[i]);
+    free(request->args);
+    free(request->cwd);
+    free(request->name);
+    free(request->source);
+    memset(request, 0, sizeof(*request));
+}
@@ -0,0 +1,329 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../headers/worker_pool.h"
+#include "../../utils/headers/file_list.h"
+#include "../../utils/headers/utils.h"
+/* ---------------------------------------------------------------------------------------
+ *                                         Structures
+ * --------------------------------------------------------------------------------------- */
+/* Enum representing the state of a single job in the pool */
+typedef enum {
+    JOB_PENDING,  /* The job has not been started yet */
+    JOB_RUNNING,  /* The job is running in a worker process */
+    JOB_DONE,     /* The worker process finished, its output is ready to be printed */
+    JOB_DEFERRED, /* The job will run in the main process once it is its turn to print */
+    JOB_PRINTED   /* The output of the job has been printed */
+} JobState;
+
+/* Structure representing one file to be assembled by the pool */
+typedef struct {
+    const char *file_name; /* Base name of the file */
+    long size;             /* Size of the source file - used for scheduling */
+    int index;             /* Position of the file in the command line */
+    FILE *output;          /* Temporary file capturing the job's standard output */
+    FILE *result;          /* Temporary file receiving the totals of the job's file */
+    pid_t pid;             /* Process id of the worker */
+    JobState state;        /* Current state of the job */
+    Boolean fatal;         /* Flag indicating if the job ended with a fatal error */
+} Job;
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static int compare_jobs(const void *first, const void *second);
+static Boolean duplicate_name(Job *jobs, int index);
+static Boolean start_job(Job *job, const AsmOptions *options, AsmWorkspace *workspace,
+                         JobFunction job_function);
+static Boolean print_finished_jobs(Job *jobs, int count, int *next_print, const AsmOptions *options,
+                                   AsmWorkspace *workspace, JobFunction job_function);
+static void copy_output(FILE *output);
+static void read_result(FILE *result, BatchSummary *batch);
+static Boolean reap_worker(Job *jobs, int count);
+/* ---------------------------------------------------------------------------------------
+ *                               Head Function Of Worker Pool
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Runs the specified job on every file name with a pool of worker processes.
+ * The jobs are started from the largest source file to the smallest, and their captured
+ * output is printed in the original order of the file names. After a fatal error no more jobs
+ * are started, and the jobs that were running are printed once they finish.
+ *
+ * @param ctx The context for reporting errors of the pool itself.
+ * @param file_names The base names of the files to assemble.
+ * @param count The number of file names.
+ * @param options The command line options, passed to every job.
+ * @param workspace The workspace the jobs assemble their files in - every worker has its own copy.
+ * @param job The function that assembles a single file.
+ * @return FATAL_ERROR if one of the jobs ended with a fatal error, ERROR_FREE_FILE otherwise.
+ */
+Status run_worker_pool(AsmContext *ctx, char *file_names[], int count, const AsmOptions *options,
+                       AsmWorkspace *workspace, JobFunction job) {
+    Job *job_list = NULL;    /* The jobs, in the order of the command line */
+    Job **schedule = NULL;   /* The jobs, in the order they should be started */
+    int next_start = 0;      /* Index of the next job to start in the schedule */
+    int next_print = 0;      /* Index of the next job to print in the job list */
+    int running = 0;         /* Number of running worker processes */
+    Boolean stop = FALSE;    /* Flag indicating that a fatal error occurred */
+    int i;                   /* Variable to iterate through loops */
+
+    job_list = (Job *)malloc(count * sizeof(Job));
+    schedule = (Job **)malloc(count * sizeof(Job *));
+    if (!job_list || !schedule) {
+        set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+        free(job_list);
+        free(schedule);
+        return FATAL_ERROR;
+    }
+
+    /* ------------------------ Initialize jobs and their schedule ------------------------ */
+    for (i = 0; i < count; i++) {
+        job_list[i].file_name = file_names[i];
+        job_list[i].size = source_size(file_names[i]);
+        job_list[i].index = i;
+        job_list[i].output = NULL;
+        job_list[i].result = NULL;
+        job_list[i].pid = -1;
+        job_list[i].fatal = FALSE;
+        /* Two jobs must not write the same output files at the same time */
+        job_list[i].state = duplicate_name(job_list, i) ? JOB_DEFERRED : JOB_PENDING;
+        schedule[i] = &job_list[i];
+    }
+    qsort(schedule, count, sizeof(Job *), compare_jobs);
+
+    /* ---------------------------------- Run the jobs ---------------------------------- */
+    for (;;) {
+        /* Fill the free workers */
+        while (!stop && running < options->jobs && next_start < count) {
+            if (schedule[next_start]->state == JOB_PENDING &&
+                start_job(schedule[next_start], options, workspace, job) == TRUE) {
+                running++;
+            }
+            next_start++;
+        }
+
+        /* Print the jobs that are done, in the order of the command line */
+        if (!stop) {
+            stop = print_finished_jobs(job_list, count, &next_print, options, workspace, job);
+        }
+
+        /* All the jobs were printed, or a fatal error occurred and all workers have finished */
+        if (running == 0 && (stop || next_print >= count)) break;
+
+        /* Wait for a worker to finish */
+        if (running > 0 && reap_worker(job_list, count) == TRUE) running--;
+    }
+
+    /* After a fatal error, the running workers were waited for and their files were assembled -
+     * print their messages, so no output file is left without the messages of its file */
+    for (i = next_print; stop && i < count; i++) {
+        if (job_list[i].state == JOB_DONE) copy_output(job_list[i].output);
+    }
+
+    /* Discard the output of jobs that were not printed */
+    for (i = 0; i < count; i++) {
+        if (job_list[i].output) fclose(job_list[i].output);
+        if (job_list[i].result) fclose(job_list[i].result);
+    }
+    free(schedule);
+    free(job_list);
+    return stop ? FATAL_ERROR : ERROR_FREE_FILE;
+}
+
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Compares two jobs for sorting the schedule - larger files first, ties are broken
+ * by the order of the command line.
+ *
+ * @param first Pointer to the first job pointer.
+ * @param second Pointer to the second job pointer.
+ * @return Negative if the first job should start before the second, positive otherwise.
+ */
+static int compare_jobs(const void *first, const void *second) {
+    const Job *job1 = *(const Job **)first;
+    const Job *job2 = *(const Job **)second;
+
+    if (job1->size != job2->size) return job1->size > job2->size ? -1 : 1;
+    return job1->index - job2->index;
+}
+
+/**
+ * Checks if the file name of the specified job appears earlier in the job list.
+ *
+ * @param jobs The job list.
+ * @param index The index of the job to check.
+ * @return TRUE if the file name already appears before this job, FALSE otherwise.
+ */
+static Boolean duplicate_name(Job *jobs, int index) {
+    int i;
+    for (i = 0; i < index; i++) {
+        if (strcmp(jobs[i].file_name, jobs[index].file_name) == 0) return TRUE;
+    }
+    return FALSE;
+}
+
+/**
+ * Starts a job in a new worker process, with its standard output redirected to a temporary
+ * file, and the totals of its file written to another. If the worker cannot be created,
+ * the job is deferred to run in the main process once all the jobs before it have been printed.
+ *
+ * @param job The job to start.
+ * @param options The command line options, passed to the job.
+ * @param workspace The workspace the job assembles its file in.
+ * @param job_function The function that assembles a single file.
+ * @return TRUE if a worker process was started, FALSE if the job was deferred.
+ */
+static Boolean start_job(Job *job, const AsmOptions *options, AsmWorkspace *workspace,
+                         JobFunction job_function) {
+    Status status;
+
+    job->state = JOB_DEFERRED;
+    if (!(job->output = tmpfile())) return FALSE;
+    if (!(job->result = tmpfile())) {
+        fclose(job->output);
+        job->output = NULL;
+        return FALSE;
+    }
+
+    /* Flush the pending output so the worker will not print it again */
+    fflush(stdout);
+
+    job->pid = fork();
+    if (job->pid == -1) { /* Failed to create worker */
+        fclose(job->output);
+        fclose(job->result);
+        job->output = NULL;
+        job->result = NULL;
+        return FALSE;
+    }
+
+    /* -------------------------------- Worker process -------------------------------- */
+    if (job->pid == 0) {
+        if (dup2(fileno(job->output), STDOUT_FILENO) == -1) _exit(EXIT_FAILURE);
+        /* The worker's totals are its file alone - the main process adds them up */
+        clear_batch_summary(&workspace->batch);
+        status = job_function(job->file_name, options, workspace);
+        fflush(stdout);
+        fwrite(&workspace->batch, sizeof(BatchSummary), 1, job->result);
+        fflush(job->result);
+        _exit(status == FATAL_ERROR ? EXIT_FAILURE : EXIT_SUCCESS);
+    }
+
+    /* -------------------------------- Main process -------------------------------- */
+    job->state = JOB_RUNNING;
+    return TRUE;
+}
+
+/**
+ * Waits for one of the worker processes to finish and marks its job as done.
+ *
+ * @param jobs The job list.
+ * @param count The number of jobs.
+ * @return TRUE if a worker process has finished, FALSE otherwise.
+ */
+static Boolean reap_worker(Job *jobs, int count) {
+    int wait_status; /* The exit status of the worker */
+    pid_t pid;       /* Process id of the finished worker */
+    int i;
+
+    pid = waitpid(-1, &wait_status, 0);
+    if (pid == -1) {
+        if (errno == EINTR) return FALSE;
+        /* No workers left to wait for - consider all the running jobs as finished */
+        for (i = 0; i < count; i++) {
+            if (jobs[i].state == JOB_RUNNING) jobs[i].state = JOB_DONE;
+        }
+        return TRUE;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (jobs[i].state == JOB_RUNNING && jobs[i].pid == pid) {
+            jobs[i].state = JOB_DONE;
+            /* A worker that did not exit normally is considered as a fatal error */
+            jobs[i].fatal = (WIFEXITED(wait_status) && WEXITSTATUS(wait_status) == EXIT_SUCCESS)
+                            ? FALSE : TRUE;
+            return TRUE;
+        }
+    }
+    return FALSE; /* Not one of the pool's workers */
+}
+
+/**
+ * Prints the output of the finished jobs in the order of the command line, until reaching
+ * a job that is still running, and adds their totals to the totals of the workspace.
+ * Deferred jobs are executed in the main process when it is their turn.
+ *
+ * @param jobs The job list.
+ * @param count The number of jobs.
+ * @param next_print Pointer to the index of the next job to print, updated by the function.
+ * @param options The command line options, passed to the deferred jobs.
+ * @param workspace The workspace the deferred jobs assemble their files in.
+ * @param job_function The function that assembles a single file.
+ * @return TRUE if a printed job ended with a fatal error, FALSE otherwise.
+ */
+static Boolean print_finished_jobs(Job *jobs, int count, int *next_print, const AsmOptions *options,
+                                   AsmWorkspace *workspace, JobFunction job_function) {
+    Job *job;
+
+    while (*next_print < count) {
+        job = &jobs[*next_print];
+
+        if (job->state == JOB_DONE) {
+            copy_output(job->output);
+            read_result(job->result, &workspace->batch);
+            fclose(job->output);
+            fclose(job->result);
+            job->output = NULL;
+            job->result = NULL;
+        } else if (job->state == JOB_DEFERRED) {
+            fflush(stdout);
+            job->fatal = (job_function(job->file_name, options, workspace) == FATAL_ERROR) ? TRUE : FALSE;
+        } else {
+            break; /* Still running or not started yet */
+        }
+
+        job->state = JOB_PRINTED;
+        (*next_print)++;
+        if (job->fatal == TRUE) return TRUE;
+    }
+    return FALSE;
+}
+
+/**
+ * Copies the captured output of a job to the standard output.
+ *
+ * @param output The temporary file containing the output of the job.
+ */
+static void copy_output(FILE *output) {
+    char buffer[BUFSIZ]; /* Buffer for copying */
+    size_t bytes;        /* Number of bytes read */
+
+    rewind(output);
+    while ((bytes = fread(buffer, 1, sizeof(buffer), output)) > 0) {
+        fwrite(buffer, 1, bytes, stdout);
+    }
+    fflush(stdout);
+}
+
+/**
+ * Reads the totals that a worker wrote for its file, and adds them to the specified totals.
+ * A worker that did not write its totals adds nothing.
+ *
+ * @param result The temporary file containing the totals of the job.
+ * @param batch The totals to add to.
+ */
+static void read_result(FILE *result, BatchSummary *batch) {
+    BatchSummary part; /* The totals of the job */
+
+    rewind(result);
+    if (fread(&part, sizeof(BatchSummary), 1, result) == 1) merge_batch_summary(batch, &part);
+}
@@ -0,0 +1,142 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include "../assembler/headers/parser.h"
+#include "../structures/headers/label_data.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Number of lines in the largest run of the report */
+#define MAX_LINES 100000
+/* ---------------------------------------------------------------------------------------
+ *                                     Allocation Counter
+ * --------------------------------------------------------------------------------------- */
+/* The report is linked with '-Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc', so every
+ * allocation of the assembler code goes through the functions below */
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void *__wrap_malloc(size_t size);
+void *__wrap_calloc(size_t count, size_t size);
+void *__wrap_realloc(void *ptr, size_t size);
+
+/* Number of calls to malloc, calloc and realloc made by the assembler code */
+static unsigned long allocation_calls = 0;
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static Boolean report_parser(const MacroTrie *macro_trie, int lines);
+/* ---------------------------------------------------------------------------------------
+ *                                      Main Function
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Prints the number of allocations made while parsing a growing number of lines - the blocks
+ * of the line arena, and all the calls to `malloc`, `calloc` and `realloc` of the assembler
+ * code, counted by wrapping the functions at link time. The parser makes no allocation per
+ * line, so neither number grows with the lines.
+ *
+ * @return EXIT_SUCCESS if all the lines were parsed, EXIT_FAILURE otherwise.
+ */
+int main(void) {
+    static const int counts[] = {1000, 10000, MAX_LINES};
+    MacroTrie macro_trie; /* An empty macro table, for the label validation of the parser */
+    int i;
+
+    if (init_macr_trie(&macro_trie) == FALSE) {
+        printf("Memory allocation failed\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("%8s | %10s %10s %16s\n", "lines", "arena", "mallocs", "mallocs / line");
+    for (i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++) {
+        if (report_parser(&macro_trie, counts[i]) == FALSE) return EXIT_FAILURE;
+    }
+
+    free_macr_trie(&macro_trie);
+    return EXIT_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Parses the specified number of lines the way the first phase does - the line arena is
+ * reset after every line - and prints the number of blocks the arena allocated, and the
+ * number of allocations made while the lines were parsed.
+ *
+ * @param macro_trie The macro table.
+ * @param lines The number of lines to parse.
+ * @return TRUE if all the lines were parsed without errors, FALSE otherwise.
+ */
+static Boolean report_parser(const MacroTrie *macro_trie, int lines) {
+    static const char *program[] = {
+            "MAIN: mov #5, r3", "add *r2, LENGTH", "LOOP: cmp LENGTH, #-6", ".data 7, -57, +17, 9",
+            "STR: .string \"abcdef\"", "jmp LOOP", ".entry MAIN", "prn *r1", "stop"
+    };
+    int count = (int)(sizeof(program) / sizeof(program[0]));
+    AsmContext ctx;         /* The context of the parsed lines */
+    LabelTable label_table; /* The labels the lines refer to */
+    unsigned long calls;    /* Number of allocations before the lines */
+    int i;
+
+    init_context(&ctx, stdout);
+    if (init_label_table(&label_table) == FALSE) {
+        printf("Memory allocation failed\n");
+        free_context(&ctx);
+        return FALSE;
+    }
+    calls = allocation_calls;
+    for (i = 0; i < lines; i++) {
+        if (!parseLine(&ctx, macro_trie, &label_table, "bench.am", i + 1, program[i % count]) ||
+            get_error(&ctx) != NO_ERROR) {
+            printf("Failed to parse line: %s\n", program[i % count]);
+            free_label_table(&label_table);
+            free_context(&ctx);
+            return FALSE;
+        }
+        reset_arena(&ctx.line_arena);
+    }
+
+    calls = allocation_calls - calls;
+    printf("%8d | %10lu %10lu %16.5f\n", lines, ctx.line_arena.allocations, calls, (double)calls / lines);
+    free_label_table(&label_table);
+    free_context(&ctx);
+    return TRUE;
+}
+
+/**
+ * Counts a call to `malloc` and makes it.
+ *
+ * @param size The number of bytes to allocate.
+ * @return The allocated block, or NULL if the allocation failed.
+ */
+void *__wrap_malloc(size_t size) {
+    allocation_calls++;
+    return __real_malloc(size);
+}
+
+/**
+ * Counts a call to `calloc` and makes it.
+ *
+ * @param count The number of elements to allocate.
+ * @param size The size of an element.
+ * @return The allocated block, or NULL if the allocation failed.
+ */
+void *__wrap_calloc(size_t count, size_t size) {
+    allocation_calls++;
+    return __real_calloc(count, size);
+}
+
+/**
+ * Counts a call to `realloc` and makes it.
+ *
+ * @param ptr The block to resize.
+ * @param size The new number of bytes.
+ * @return The resized block, or NULL if the allocation failed.
+ */
+void *__wrap_realloc(void *ptr, size_t size) {
+    allocation_calls++;
+    return __real_realloc(ptr, size);
+}
@@ -0,0 +1,190 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../assembler/headers/code_convert.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Number of times the whole memory image is encoded by each encoder */
+#define ROUNDS 400
+/* Number of fields that are encoded into every word */
+#define FIELDS_PER_WORD 5
+/* Layout of the previous memory image - a word is stored in two bytes, bit by bit */
+#define LEGACY_BYTES 2
+#define LEGACY_BYTE_SIZE 8
+/* ---------------------------------------------------------------------------------------
+ *                                         Structures
+ * --------------------------------------------------------------------------------------- */
+/* The memory image as it was stored before the words became native integers */
+typedef struct {
+    char lines[MEMORY_CAPACITY][LEGACY_BYTES];
+    int pos;
+} LegacyImage;
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static void legacy_set_bit(int i, LegacyImage *image);
+static void legacy_set_int_code(int start, int end, int value, LegacyImage *image);
+static unsigned int legacy_word(const char *word);
+static double bench_legacy(LegacyImage *image);
+static double bench_native(MemoryImage *image);
+static void print_result(const char *name, double seconds);
+/* ---------------------------------------------------------------------------------------
+ *                                      Main Function
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Measures the throughput of the word encoders. Every word of the memory image is encoded
+ * the way the first word of an instruction is - operation code, ARE bit, two addressing modes
+ * and a register/immediate field - once with the previous bit-by-bit encoder and once with
+ * the shift/mask encoder of the assembler. The two images are compared, so the benchmark
+ * also checks that both encoders produce the same words.
+ *
+ * @return EXIT_SUCCESS if both encoders produced the same words, EXIT_FAILURE otherwise.
+ */
+int main(void) {
+    static LegacyImage legacy;  /* The image of the bit-by-bit encoder */
+    static MemoryImage native;  /* The image of the shift/mask encoder */
+    static Word native_words[MEMORY_CAPACITY]; /* The code section of the native image */
+    double legacy_time;        /* Time of the bit-by-bit encoder in seconds */
+    double native_time;        /* Time of the shift/mask encoder in seconds */
+    int i;
+
+    native.code = native_words;
+    native.code_size = MEMORY_CAPACITY;
+
+    legacy_time = bench_legacy(&legacy);
+    native_time = bench_native(&native);
+
+    /* Both encoders must produce the same words */
+    for (i = 0; i < MEMORY_CAPACITY; i++) {
+        if (legacy_word(legacy.lines[i]) != convert_to_octal(native.code[i])) {
+            printf("Mismatch at word %d: %05o != %05o\n", i, legacy_word(legacy.lines[i]),
+                   convert_to_octal(native.code[i]));
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("Encoded %d words x %d rounds, %d fields per word\n", MEMORY_CAPACITY, ROUNDS, FIELDS_PER_WORD);
+    print_result("bit-by-bit", legacy_time);
+    print_result("shift/mask", native_time);
+    if (native_time > 0) printf("speedup             : %.2fx\n", legacy_time / native_time);
+    return EXIT_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Encodes the whole image with the bit-by-bit encoder.
+ *
+ * @param image The image to encode into.
+ * @return The time it took in seconds.
+ */
+static double bench_legacy(LegacyImage *image) {
+    clock_t start = clock();
+    int round, i;
+
+    for (round = 0; round < ROUNDS; round++) {
+        for (i = 0; i < MEMORY_CAPACITY; i++) {
+            image->pos = i;
+            image->lines[i][0] = image->lines[i][1] = 0;
+            legacy_set_int_code(0, 3, i % 16, image);
+            legacy_set_bit(A, image);
+            legacy_set_bit(SRC_OFFSET - (i % 4), image);
+            legacy_set_bit(DEST_OFFSET - ((i / 4) % 4), image);
+            legacy_set_int_code(REGISTER_POS, REGISTER_POS + REGISTER_BIT_SIZE - 1, i % 8, image);
+        }
+    }
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Encodes the whole image with the shift/mask encoder of the assembler.
+ *
+ * @param image The image to encode into.
+ * @return The time it took in seconds.
+ */
+static double bench_native(MemoryImage *image) {
+    clock_t start = clock();
+    int round, i;
+
+    image->code_count = 0;
+    for (round = 0; round < ROUNDS; round++) {
+        for (i = 0; i < MEMORY_CAPACITY; i++) {
+            image->code_pos = i;
+            image->code[i] = 0;
+            set_int_code(0, 3, i % 16, image, CODE_IMAGE);
+            set_bit(A, 1, image, CODE_IMAGE);
+            set_bit(SRC_OFFSET - (i % 4), 1, image, CODE_IMAGE);
+            set_bit(DEST_OFFSET - ((i / 4) % 4), 1, image, CODE_IMAGE);
+            set_int_code(REGISTER_POS, REGISTER_POS + REGISTER_BIT_SIZE - 1, i % 8, image, CODE_IMAGE);
+        }
+    }
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Prints the throughput of an encoder.
+ *
+ * @param name The name of the encoder.
+ * @param seconds The time it took to encode all the rounds.
+ */
+static void print_result(const char *name, double seconds) {
+    double fields = (double)MEMORY_CAPACITY * ROUNDS * FIELDS_PER_WORD;
+
+    if (seconds <= 0) {
+        printf("%-20s: too fast to measure\n", name);
+    } else {
+        printf("%-20s: %8.3f s, %8.1f M fields/s\n", name, seconds, fields / seconds / 1e6);
+    }
+}
+
+/**
+ * The previous encoder of a single bit - recomputes the byte, mask and position for every bit.
+ *
+ * @param i The bit position to set.
+ * @param image The image to write to.
+ */
+static void legacy_set_bit(int i, LegacyImage *image) {
+    int byteIndex = i / LEGACY_BYTE_SIZE;
+    int bitOffset = i % LEGACY_BYTE_SIZE;
+    char mask = (char)(1 << (LEGACY_BYTE_SIZE - 1 - bitOffset));
+
+    image->lines[image->pos][byteIndex] |= mask;
+}
+
+/**
+ * The previous encoder of a field - sets the bits of the value one by one.
+ *
+ * @param start The starting bit position.
+ * @param end The ending bit position.
+ * @param value The value to encode.
+ * @param image The image to write to.
+ */
+static void legacy_set_int_code(int start, int end, int value, LegacyImage *image) {
+    int i;
+
+    for (i = start; i <= end; i++) {
+        if (value & (1 << (end - i))) legacy_set_bit(i, image);
+    }
+}
+
+/**
+ * Reads a word of the previous image as a 15-bit value.
+ *
+ * @param word The two bytes of the word.
+ * @return The value of the word.
+ */
+static unsigned int legacy_word(const char *word) {
+    unsigned int value = 0;
+    int i;
+
+    for (i = 0; i <= WORD_END_POS; i++) {
+        value = (value << 1) |
+                ((word[i / LEGACY_BYTE_SIZE] >> (LEGACY_BYTE_SIZE - 1 - i % LEGACY_BYTE_SIZE)) & 1);
+    }
+    return value;
+}
@@ -0,0 +1,120 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "source_gen.h"
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static int parse_arguments(int argc, char *argv[], GenOptions *options);
+static int read_number(const char *str, long min, long max, long *value);
+/* ---------------------------------------------------------------------------------------
+ *                                      Main Function
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Writes a generated assembly source to the standard output, for example:
+ *     bench/gen_source -n 20000 -m 16 -b 6 > big.as
+ * Options (the defaults are those of `default_gen_options`):
+ * '-n N' - number of lines            '-l P' - percentage of lines that define a label
+ * '-d P' - percentage of label operands '-m N' - number of macros
+ * '-b N' - number of lines of a macro  '-s P' - percentage of .data/.string lines
+ * '-r N' - seed of the generator
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The array of command line arguments.
+ * @return EXIT_SUCCESS if the source was written, EXIT_FAILURE otherwise.
+ */
+int main(int argc, char *argv[]) {
+    GenOptions options;  /* The shape of the source */
+    char *source;        /* The generated source */
+    size_t size;         /* The size of the source in bytes */
+    long words;          /* Number of memory words of the program */
+
+    default_gen_options(&options);
+    if (parse_arguments(argc, argv, &options) == 0) {
+        fprintf(stderr, "usage: gen_source [-n lines] [-l label%%] [-d direct%%] [-m macros] "
+                        "[-b macro lines] [-s data%%] [-r seed]\n");
+        return EXIT_FAILURE;
+    }
+
+    if (!(source = generate_source(&options, &size, &words))) {
+        fprintf(stderr, "Failed to generate the source - the macros must fit in the lines\n");
+        return EXIT_FAILURE;
+    }
+
+    fwrite(source, 1, size, stdout);
+    fprintf(stderr, "%ld lines, %lu bytes, %ld memory words\n", options.lines, (unsigned long)size, words);
+    free(source);
+    return EXIT_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Reads the options of the command line.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The array of command line arguments.
+ * @param options Pointer to store the options.
+ * @return Non-zero if all the options are valid, 0 otherwise.
+ */
+static int parse_arguments(int argc, char *argv[], GenOptions *options) {
+    long value;
+    int i;
+
+    for (i = 1; i < argc; i += 2) {
+        if (strlen(argv[i]) != 2 || argv[i][0] != '-' || i + 1 >= argc) return 0;
+
+        switch (argv[i][1]) {
+            case 'n':
+                if (!read_number(argv[i + 1], 1, 10000000L, &options->lines)) return 0;
+                break;
+            case 'l':
+                if (!read_number(argv[i + 1], 0, 100, &value)) return 0;
+                options->label_percent = (int)value;
+                break;
+            case 'd':
+                if (!read_number(argv[i + 1], 0, 100, &value)) return 0;
+                options->direct_percent = (int)value;
+                break;
+            case 'm':
+                if (!read_number(argv[i + 1], 0, 10000, &value)) return 0;
+                options->macros = (int)value;
+                break;
+            case 'b':
+                if (!read_number(argv[i + 1], 0, 1000, &value)) return 0;
+                options->macro_lines = (int)value;
+                break;
+            case 's':
+                if (!read_number(argv[i + 1], 0, 100, &value)) return 0;
+                options->data_percent = (int)value;
+                break;
+            case 'r':
+                if (!read_number(argv[i + 1], 0, 2147483647L, &value)) return 0;
+                options->seed = (unsigned long)value;
+                break;
+            default:
+                return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Reads a decimal number in the specified range.
+ *
+ * @param str The string to read.
+ * @param min The smallest valid value.
+ * @param max The largest valid value.
+ * @param value Pointer to store the number.
+ * @return Non-zero if the string is a number in the range, 0 otherwise.
+ */
+static int read_number(const char *str, long min, long max, long *value) {
+    char *end;
+
+    *value = strtol(str, &end, 10);
+    return (*str != '\0' && *end == '\0' && *value >= min && *value <= max);
+}
@@ -0,0 +1,189 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../assembler/headers/code_convert.h"
+#include "../utils/headers/output_files.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Number of times the object file is written by each writer */
+#define ROUNDS 300
+/* Number of code words in the image - the rest of the memory holds data words */
+#define CODE_WORDS 2048
+/* The file that the object content is written to - only the formatting is measured */
+#define NULL_DEVICE "/dev/null"
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static void fill_image(CmpData *data);
+static void stdio_print(FILE *output_file, CmpData *data);
+static Boolean same_content(CmpData *data);
+static double bench_stdio(CmpData *data);
+static double bench_buffer(CmpData *data);
+static void print_result(const char *name, double seconds);
+/* ---------------------------------------------------------------------------------------
+ *                                      Main Function
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Measures the time it takes to write the object file of a full memory image - once with
+ * a formatted stdio call per word and once with the buffer formatter of the assembler.
+ * The content of both writers is compared before measuring.
+ *
+ * @return EXIT_SUCCESS if both writers produce the same content, EXIT_FAILURE otherwise.
+ */
+int main(void) {
+    static CmpData data;  /* The program's data - only the memory image is used */
+    double stdio_time;   /* Time of the stdio writer in seconds */
+    double buffer_time;  /* Time of the buffer writer in seconds */
+
+    fill_image(&data);
+
+    if (same_content(&data) == FALSE) {
+        printf("The buffer writer and the stdio writer produced different content\n");
+        return EXIT_FAILURE;
+    }
+
+    stdio_time = bench_stdio(&data);
+    buffer_time = bench_buffer(&data);
+
+    printf("Wrote an object file of %d words x %d rounds\n", MEMORY_CAPACITY, ROUNDS);
+    print_result("stdio fprintf", stdio_time);
+    print_result("buffer + write", buffer_time);
+    if (buffer_time > 0) printf("speedup             : %.2fx\n", stdio_time / buffer_time);
+    return EXIT_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Fills the whole memory image with pseudo random words.
+ *
+ * @param data The program's data to fill.
+ */
+static void fill_image(CmpData *data) {
+    static Word code[CODE_WORDS];                        /* The code section */
+    static Word data_words[MEMORY_CAPACITY - CODE_WORDS]; /* The data section */
+    unsigned long seed = 12345; /* Seed of the generator - the same image on every run */
+    int i;
+
+    for (i = 0; i < MEMORY_CAPACITY; i++) {
+        seed = seed * 1103515245UL + 12345UL;
+        if (i < CODE_WORDS) {
+            code[i] = (Word)((seed >> 8) & WORD_MASK);
+        } else {
+            data_words[i - CODE_WORDS] = (Word)((seed >> 8) & WORD_MASK);
+        }
+    }
+    data->image.code = code;
+    data->image.data = data_words;
+    data->image.code_count = CODE_WORDS;
+    data->image.data_count = MEMORY_CAPACITY - CODE_WORDS;
+}
+
+/**
+ * The stdio writer - one formatted call per word, as the object file used to be printed.
+ *
+ * @param output_file The file to write to.
+ * @param data The program's data.
+ */
+static void stdio_print(FILE *output_file, CmpData *data) {
+    int i;
+    int data_addres = data->image.code_count + IC_START;
+
+    fprintf(output_file, "%4d   %-5d\n", data->image.code_count, data->image.data_count);
+    for (i = 0; i < data->image.code_count; i++) {
+        fprintf(output_file, "%04d   %05o\n", IC_START + i, convert_to_octal(data->image.code[i]));
+    }
+    for (i = 0; i < data->image.data_count; i++) {
+        fprintf(output_file, "%04d   %05o\n", data_addres, convert_to_octal(data->image.data[i]));
+        data_addres++;
+    }
+}
+
+/**
+ * Checks that the buffer formatter produces exactly the content of the stdio writer.
+ *
+ * @param data The program's data.
+ * @return TRUE if the contents are the same, FALSE otherwise.
+ */
+static Boolean same_content(CmpData *data) {
+    FILE *file = tmpfile();  /* The content of the stdio writer */
+    char *expected = NULL;   /* The content of the stdio writer, in memory */
+    char *content = NULL;    /* The content of the buffer formatter */
+    size_t size;             /* Size of the content of the buffer formatter */
+    long expected_size;      /* Size of the content of the stdio writer */
+    Boolean same = FALSE;
+
+    if (!file) return FALSE;
+    stdio_print(file, data);
+    expected_size = ftell(file);
+    rewind(file);
+
+    content = format_memory_images(data, &size);
+    expected = (char *)malloc((size_t)expected_size);
+    if (content && expected && fread(expected, 1, (size_t)expected_size, file) == (size_t)expected_size) {
+        same = (size == (size_t)expected_size && memcmp(content, expected, size) == 0) ? TRUE : FALSE;
+    }
+
+    free(content);
+    free(expected);
+    fclose(file);
+    return same;
+}
+
+/**
+ * Writes the object content with the stdio writer.
+ *
+ * @param data The program's data.
+ * @return The time it took in seconds.
+ */
+static double bench_stdio(CmpData *data) {
+    clock_t start = clock();
+    FILE *file;
+    int round;
+
+    for (round = 0; round < ROUNDS; round++) {
+        if (!(file = fopen(NULL_DEVICE, "w"))) return 0;
+        stdio_print(file, data);
+        fclose(file);
+    }
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Writes the object content with the buffer formatter and a single write.
+ *
+ * @param data The program's data.
+ * @return The time it took in seconds.
+ */
+static double bench_buffer(CmpData *data) {
+    clock_t start = clock();
+    int round;
+    size_t size; /* Size of the written content */
+
+    for (round = 0; round < ROUNDS; round++) {
+        if (write_memory_images(NULL_DEVICE, data, &size) != NO_ERROR) return 0;
+    }
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Prints the throughput of a writer.
+ *
+ * @param name The name of the writer.
+ * @param seconds The time it took to write all the rounds.
+ */
+static void print_result(const char *name, double seconds) {
+    double words = (double)MEMORY_CAPACITY * ROUNDS;
+
+    if (seconds <= 0) {
+        printf("%-20s: too fast to measure\n", name);
+    } else {
+        printf("%-20s: %8.3f s, %8.1f M words/s\n", name, seconds, words / seconds / 1e6);
+    }
+}
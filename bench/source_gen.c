@@ -0,0 +1,367 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "source_gen.h"
+#include "../assembler/headers/defines.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Number of bytes the source holds before its first growth */
+#define TEXT_INITIAL_CAPACITY 4096
+/* Maximal length of a generated line, including its '\n' and '\0' */
+#define GEN_LINE_LENGTH 96
+/* Number of times every macro is used */
+#define MACRO_USES 2
+/* Addressing modes, as bits of the allowed modes of an operand */
+#define MODE_IMMEDIATE 1
+#define MODE_DIRECT 2
+#define MODE_INDIRECT_REG 4
+#define MODE_REG 8
+#define MODES_ALL (MODE_IMMEDIATE | MODE_DIRECT | MODE_INDIRECT_REG | MODE_REG)
+#define MODES_WRITABLE (MODE_DIRECT | MODE_INDIRECT_REG | MODE_REG)
+#define MODES_JUMP (MODE_DIRECT | MODE_INDIRECT_REG)
+/* Kinds of the lines of the program */
+#define LINE_INSTRUCTION 0
+#define LINE_DATA 1
+#define LINE_MACRO 2
+/* Flag of a line that defines a label */
+#define LINE_LABEL 4
+/* Most memory words an instruction line, and a data line, take */
+#define MAX_INSTRUCTION_WORDS 3
+#define MAX_DATA_WORDS 13
+/* First address that does not fit the address field of a label operand */
+#define ADDRESS_LIMIT (1L << IMMEDIATE_DIRECTIVE_BIT_SIZE)
+/* ---------------------------------------------------------------------------------------
+ *                                        Structures
+ * --------------------------------------------------------------------------------------- */
+/* An instruction and the addressing modes its operands allow - 0 for a missing operand */
+typedef struct GenOp {
+    const char *name;
+    int source_modes;
+    int target_modes;
+} GenOp;
+
+/* The generated source, with the state of the generator */
+typedef struct Generator {
+    const GenOptions *options;
+    char *text;             /* The source */
+    size_t size;            /* Length of the source in bytes */
+    size_t capacity;        /* Number of bytes allocated for the source */
+    int failed;             /* Flag indicating if memory allocation failed */
+    unsigned long state;    /* State of the random numbers */
+    long labels;            /* Number of labels the program defines */
+    long *targets;          /* The labels that label operands reference */
+    long target_count;      /* Number of labels that label operands reference */
+    long words;             /* Number of memory words the program takes */
+} Generator;
+/* ---------------------------------------------------------------------------------------
+ *                                      Static Variables
+ * --------------------------------------------------------------------------------------- */
+static const GenOp ops[] = {
+        {"mov", MODES_ALL, MODES_WRITABLE}, {"cmp", MODES_ALL, MODES_ALL},
+        {"add", MODES_ALL, MODES_WRITABLE}, {"sub", MODES_ALL, MODES_WRITABLE},
+        {"lea", MODE_DIRECT, MODES_WRITABLE}, {"clr", 0, MODES_WRITABLE},
+        {"not", 0, MODES_WRITABLE}, {"inc", 0, MODES_WRITABLE}, {"dec", 0, MODES_WRITABLE},
+        {"jmp", 0, MODES_JUMP}, {"bne", 0, MODES_JUMP}, {"red", 0, MODES_WRITABLE},
+        {"prn", 0, MODES_ALL}, {"jsr", 0, MODES_JUMP}, {"rts", 0, 0}, {"stop", 0, 0}
+};
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static unsigned long next_random(Generator *gen, unsigned long range);
+static int spread(long i, long count, long total);
+static int append_line(Generator *gen, const char *line);
+static long gen_instruction(Generator *gen, char *line);
+static char *gen_operand(Generator *gen, char *pos, int modes, int *mode);
+static long gen_data(Generator *gen, char *line);
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Sets the options of a typical program: 10000 lines, a label on every fifth line, a label
+ * in every third operand, 8 macros of 4 lines, and a fifth of the lines are data.
+ *
+ * @param options Pointer to the options to be set.
+ */
+void default_gen_options(GenOptions *options) {
+    options->lines = 10000;
+    options->label_percent = 20;
+    options->direct_percent = 33;
+    options->macros = 8;
+    options->macro_lines = 4;
+    options->data_percent = 20;
+    options->seed = 1;
+}
+
+/**
+ * Generates a valid assembly source (.as) with the specified shape. The macros are defined at
+ * the start of the source, and their usages, the labels and the data lines are spread evenly
+ * over the rest of it. The labels are referenced before and after their definition, so both
+ * phases of the assembler are exercised. Only the labels of instruction lines whose address
+ * surely fits the address field of an operand are referenced - an address is bounded by the
+ * most words the lines before it may take.
+ *
+ * @param options The shape of the source.
+ * @param size Pointer to store the size of the source in bytes.
+ * @param words Pointer to store the number of memory words the program takes.
+ * @return The source (should be freed), or NULL if memory allocation failed or the options are
+ *         invalid - the macros must fit in the lines.
+ */
+char *generate_source(const GenOptions *options, size_t *size, long *words) {
+    Generator gen;                      /* The generated source */
+    char line[GEN_LINE_LENGTH];         /* The current line */
+    char *kinds;                        /* The kind of every line of the program */
+    long macro_words = 0;               /* Number of words of all the macros bodies */
+    long program;                       /* Number of lines after the macros definitions */
+    long uses = (long)options->macros * MACRO_USES; /* Number of macro usage lines */
+    long used = 0;                      /* Number of macro usage lines written */
+    long code_lines = 0, data_lines = 0; /* Number of instruction and data lines so far */
+    long bound = IC_START;              /* The highest address the current line may have */
+    int kind;                           /* The kind of the current line */
+    long i, j;
+
+    program = options->lines - (long)options->macros * (options->macro_lines + 2);
+    if (options->macros < 0 || options->macro_lines < 0 || program < uses) return NULL;
+
+    gen.options = options;
+    gen.text = NULL;
+    gen.size = gen.capacity = 0;
+    gen.failed = 0;
+    gen.state = (options->seed & 0xFFFFFFFFUL) ? (options->seed & 0xFFFFFFFFUL) : 1;
+    gen.labels = 0;
+    gen.target_count = 0;
+    gen.words = 0;
+
+    /* Decide the kind of every line first - the number of labels is known before they are used */
+    if (!(kinds = (char *)malloc((size_t)program + 1))) return NULL;
+    for (i = 0, j = 0; i < program; i++) {
+        if (spread(i, uses, program)) {
+            kinds[i] = LINE_MACRO;
+            continue;
+        }
+        kinds[i] = spread(j++, options->data_percent, 100) ? LINE_DATA : LINE_INSTRUCTION;
+        /* The labels are spread over the instructions and over the data lines on their own */
+        if (spread(kinds[i] == LINE_DATA ? data_lines++ : code_lines++, options->label_percent, 100)) {
+            kinds[i] |= LINE_LABEL;
+            gen.labels++;
+        }
+    }
+
+    /* Pick the labels that are surely addressable by an operand */
+    if (!(gen.targets = (long *)malloc((size_t)gen.labels * sizeof(long) + 1))) {
+        free(kinds);
+        return NULL;
+    }
+    for (i = 0, j = 0; i < program && bound < ADDRESS_LIMIT; i++) {
+        kind = kinds[i] & ~LINE_LABEL;
+        if (kinds[i] & LINE_LABEL) {
+            if (kind == LINE_INSTRUCTION) gen.targets[gen.target_count++] = j;
+            j++;
+        }
+        if (kind == LINE_MACRO) bound += (long)options->macro_lines * MAX_INSTRUCTION_WORDS;
+        else bound += (kind == LINE_DATA) ? MAX_DATA_WORDS : MAX_INSTRUCTION_WORDS;
+    }
+
+    /* ----------------------------------- Macros definitions ----------------------------------- */
+    for (i = 0; i < options->macros; i++) {
+        sprintf(line, "macr mc%ld\n", i);
+        append_line(&gen, line);
+        for (j = 0; j < options->macro_lines; j++) {
+            macro_words += gen_instruction(&gen, line);
+            append_line(&gen, line);
+        }
+        append_line(&gen, "endmacr\n");
+    }
+    /* Every macro is used the same number of times */
+    gen.words = macro_words * MACRO_USES;
+
+    /* ------------------------------------- The program ------------------------------------- */
+    for (i = 0, j = 0; !gen.failed && i < program; i++) {
+        line[0] = '\0';
+        if (kinds[i] & LINE_LABEL) sprintf(line, "L%ld: ", j++);
+
+        switch (kinds[i] & ~LINE_LABEL) {
+            case LINE_MACRO:
+                /* The macros are used in turns */
+                sprintf(line, "mc%ld\n", used++ % options->macros);
+                break;
+            case LINE_DATA:
+                gen.words += gen_data(&gen, line + strlen(line));
+                break;
+            default:
+                gen.words += gen_instruction(&gen, line + strlen(line));
+        }
+        append_line(&gen, line);
+    }
+    free(kinds);
+    free(gen.targets);
+
+    /* Memory allocation failed */
+    if (gen.failed) {
+        free(gen.text);
+        return NULL;
+    }
+    *size = gen.size;
+    *words = gen.words;
+    return gen.text;
+}
+
+/**
+ * Static function - returns the next random number in the specified range (xorshift), so the
+ * same seed gives the same source on every system.
+ *
+ * @param gen The generator.
+ * @param range The number of possible values - must be positive.
+ * @return A number from 0 to range - 1.
+ */
+static unsigned long next_random(Generator *gen, unsigned long range) {
+    gen->state ^= (gen->state << 13) & 0xFFFFFFFFUL;
+    gen->state ^= gen->state >> 17;
+    gen->state ^= (gen->state << 5) & 0xFFFFFFFFUL;
+    return gen->state % range;
+}
+
+/**
+ * Static function - spreads count marks evenly over total places, and tells if the specified
+ * place is marked.
+ *
+ * @param i The place.
+ * @param count The number of marks.
+ * @param total The number of places.
+ * @return Non-zero if the place is marked, 0 otherwise.
+ */
+static int spread(long i, long count, long total) {
+    return (int)(((i + 1) * count) / total != (i * count) / total);
+}
+
+/**
+ * Static function - appends a line to the source. Once memory allocation failed, the
+ * following lines are ignored.
+ *
+ * @param gen The generator.
+ * @param line The line, with its '\n'.
+ * @return Non-zero if the line was appended, 0 otherwise.
+ */
+static int append_line(Generator *gen, const char *line) {
+    size_t length = strlen(line);
+    size_t new_capacity;
+    char *new_text;
+
+    if (gen->failed) return 0;
+    if (gen->size + length + 1 > gen->capacity) {
+        new_capacity = gen->capacity ? gen->capacity : TEXT_INITIAL_CAPACITY;
+        while (gen->size + length + 1 > new_capacity) new_capacity *= 2;
+        if (!(new_text = (char *)realloc(gen->text, new_capacity))) {
+            gen->failed = 1;
+            return 0;
+        }
+        gen->text = new_text;
+        gen->capacity = new_capacity;
+    }
+    memcpy(gen->text + gen->size, line, length + 1);
+    gen->size += length;
+    return 1;
+}
+
+/**
+ * Static function - writes a random instruction line to the specified position.
+ *
+ * @param gen The generator.
+ * @param line The position to write to.
+ * @return The number of memory words the instruction takes.
+ */
+static long gen_instruction(Generator *gen, char *line) {
+    const GenOp *op;
+    int source = 0, target = 0;    /* The addressing modes of the operands */
+    long words = 1;                /* The first word of the instruction */
+    char *pos;
+
+    /* An instruction that must have a label operand needs a defined label */
+    do {
+        op = &ops[next_random(gen, sizeof(ops) / sizeof(ops[0]))];
+    } while (gen->target_count == 0 && op->source_modes == MODE_DIRECT);
+
+    pos = line + sprintf(line, "%s", op->name);
+    if (op->source_modes) {
+        pos = gen_operand(gen, pos + sprintf(pos, " "), op->source_modes, &source);
+        words++;
+    }
+    if (op->target_modes) {
+        pos += sprintf(pos, "%s", op->source_modes ? ", " : " ");
+        pos = gen_operand(gen, pos, op->target_modes, &target);
+        words++;
+    }
+    sprintf(pos, "\n");
+
+    /* Two register operands share a single word */
+    if ((source == MODE_REG || source == MODE_INDIRECT_REG) &&
+        (target == MODE_REG || target == MODE_INDIRECT_REG)) {
+        words--;
+    }
+    return words;
+}
+
+/**
+ * Static function - writes a random operand with one of the allowed addressing modes.
+ * An operand is a label at the requested ratio, if labels are allowed and addressable.
+ *
+ * @param gen The generator.
+ * @param pos The position to write to.
+ * @param modes The allowed addressing modes.
+ * @param mode Pointer to store the chosen addressing mode.
+ * @return The position after the operand.
+ */
+static char *gen_operand(Generator *gen, char *pos, int modes, int *mode) {
+    int others = modes & ~MODE_DIRECT; /* The allowed modes that are not a label */
+
+    if ((modes & MODE_DIRECT) && gen->target_count > 0 &&
+        (others == 0 || (int)next_random(gen, 100) < gen->options->direct_percent)) {
+        *mode = MODE_DIRECT;
+        return pos + sprintf(pos, "L%ld", gen->targets[next_random(gen, (unsigned long)gen->target_count)]);
+    }
+
+    /* Pick one of the other allowed modes */
+    do {
+        *mode = 1 << next_random(gen, 4);
+    } while (!(others & *mode));
+
+    switch (*mode) {
+        case MODE_IMMEDIATE:
+            return pos + sprintf(pos, "#%ld", (long)next_random(gen, 4096) - 2048);
+        case MODE_INDIRECT_REG:
+            return pos + sprintf(pos, "*r%lu", next_random(gen, 8));
+        default:
+            return pos + sprintf(pos, "r%lu", next_random(gen, 8));
+    }
+}
+
+/**
+ * Static function - writes a random .data or .string line to the specified position.
+ *
+ * @param gen The generator.
+ * @param line The position to write to.
+ * @return The number of memory words the data takes.
+ */
+static long gen_data(Generator *gen, char *line) {
+    long count = (long)next_random(gen, 6) + 1; /* Number of integers or characters */
+    long i;
+    char *pos;
+
+    if (next_random(gen, 2)) {
+        pos = line + sprintf(line, ".data ");
+        for (i = 0; i < count; i++) {
+            pos += sprintf(pos, i ? ", %ld" : "%ld", (long)next_random(gen, 32768) - 16384);
+        }
+        sprintf(pos, "\n");
+        return count;
+    }
+
+    count *= 2;
+    pos = line + sprintf(line, ".string \"");
+    for (i = 0; i < count; i++) *pos++ = (char)('a' + next_random(gen, 26));
+    sprintf(pos, "\"\n");
+    return count + 1; /* The terminating null is encoded as well */
+}
@@ -0,0 +1,42 @@
+#ifndef SOURCE_GEN_H
+#define SOURCE_GEN_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include <stddef.h>
+/* ---------------------------------------- Structures ----------------------------------------*/
+/*
+ * GenOptions struct
+ * The shape of a generated assembly source. All the percentages are between 0 and 100.
+ */
+typedef struct GenOptions {
+    long lines;             /* Number of lines of the source */
+    int label_percent;      /* Percentage of the lines of the program that define a label */
+    int direct_percent;     /* Percentage of the instruction operands that are labels */
+    int macros;             /* Number of macros - each one is defined once and used twice */
+    int macro_lines;        /* Number of lines in the body of every macro */
+    int data_percent;       /* Percentage of the lines of the program that are .data or .string */
+    unsigned long seed;     /* Seed of the generator - the same seed gives the same source */
+} GenOptions;
+
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Sets the options of a typical program: 10000 lines, a label on every fifth line, a label
+ * in every third operand, 8 macros of 4 lines, and a fifth of the lines are data.
+ *
+ * @param options Pointer to the options to be set.
+ */
+void default_gen_options(GenOptions *options);
+
+/**
+ * Generates a valid assembly source (.as) with the specified shape. The labels are referenced
+ * before and after their definition, so both phases of the assembler are exercised - only
+ * labels whose address fits the address field of an operand are referenced.
+ *
+ * @param options The shape of the source.
+ * @param size Pointer to store the size of the source in bytes.
+ * @param words Pointer to store the number of memory words the program takes.
+ * @return The source (should be freed), or NULL if memory allocation failed or the options are
+ *         invalid - the macros must fit in the lines.
+ */
+char *generate_source(const GenOptions *options, size_t *size, long *words);
+
+#endif /* SOURCE_GEN_H */
@@ -0,0 +1,148 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../structures/headers/label_data.h"
+#include "../assembler/headers/defines.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Number of labels in the largest table of the report */
+#define MAX_LABELS 4000
+/* Number of characters a label can be made of (as in the previous trie) */
+#define ALPHABET_SIZE 65
+/* ---------------------------------------------------------------------------------------
+ *                                         Structures
+ * --------------------------------------------------------------------------------------- */
+/* A node of the previous label trie - one child pointer for every possible character */
+typedef struct LegacyTrieNode {
+    struct LegacyTrieNode *children[ALPHABET_SIZE];
+    Boolean exist;
+    void *data;
+} LegacyTrieNode;
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static void make_labels(char labels[][MAX_LABEL_LENGTH], int count, int length);
+static int compare_names(const void *first, const void *second);
+static size_t trie_memory(char labels[][MAX_LABEL_LENGTH], int count);
+static void report(char labels[][MAX_LABEL_LENGTH], int count, int length);
+/* ---------------------------------------------------------------------------------------
+ *                                      Main Function
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Prints the memory footprint of the label table for several table sizes and label lengths,
+ * next to the footprint the previous trie would have had for the same labels.
+ *
+ * @return EXIT_SUCCESS if all the tables were built, EXIT_FAILURE otherwise.
+ */
+int main(void) {
+    static char labels[MAX_LABELS][MAX_LABEL_LENGTH]; /* The names of the labels */
+    static const int counts[] = {1, 100, 1000, MAX_LABELS};
+    static const int lengths[] = {8, MAX_LABEL_PRINTABLE};
+    int i, j;
+
+    printf("%8s %6s | %12s %10s | %12s %10s\n", "labels", "length",
+           "table bytes", "per label", "trie bytes", "per label");
+    for (i = 0; i < (int)(sizeof(lengths) / sizeof(lengths[0])); i++) {
+        for (j = 0; j < (int)(sizeof(counts) / sizeof(counts[0])); j++) {
+            make_labels(labels, counts[j], lengths[i]);
+            report(labels, counts[j], lengths[i]);
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Builds the label table of the specified labels and prints its footprint.
+ *
+ * @param labels The names of the labels.
+ * @param count The number of labels.
+ * @param length The length of every label.
+ */
+static void report(char labels[][MAX_LABEL_LENGTH], int count, int length) {
+    LabelTable table;   /* The label table */
+    size_t table_bytes; /* Memory of the label table */
+    size_t trie_bytes;  /* Memory the previous trie would have taken */
+    int i;
+
+    if (init_label_table(&table) == FALSE) {
+        printf("Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < count; i++) {
+        if (insert_label(&table, labels[i], i, INSTRUCTION) != NO_ERROR) {
+            printf("Failed to insert label %s\n", labels[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    table_bytes = label_table_memory(&table);
+    trie_bytes = trie_memory(labels, count);
+    printf("%8d %6d | %12lu %10.1f | %12lu %10.1f\n", count, length,
+           (unsigned long)table_bytes, (double)table_bytes / count,
+           (unsigned long)trie_bytes, (double)trie_bytes / count);
+    free_label_table(&table);
+}
+
+/**
+ * Generates distinct pseudo random label names of the specified length.
+ *
+ * @param labels The array to store the names in.
+ * @param count The number of names.
+ * @param length The length of every name.
+ */
+static void make_labels(char labels[][MAX_LABEL_LENGTH], int count, int length) {
+    static const char letters[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    unsigned long seed = 2024; /* Seed of the generator - the same names on every run */
+    int i, j;
+
+    for (i = 0; i < count; i++) {
+        /* Unique suffix, random prefix */
+        sprintf(labels[i] + length - 4, "%04d", i);
+        for (j = 0; j < length - 4; j++) {
+            seed = seed * 1103515245UL + 12345UL;
+            labels[i][j] = letters[(seed >> 16) % (sizeof(letters) - 1)];
+        }
+    }
+}
+
+/**
+ * Calculates the memory the previous trie would have taken for the specified labels:
+ * a node for every distinct prefix, plus the root, plus the data of every label.
+ *
+ * @param labels The names of the labels - sorted by the function.
+ * @param count The number of labels.
+ * @return The number of bytes.
+ */
+static size_t trie_memory(char labels[][MAX_LABEL_LENGTH], int count) {
+    size_t nodes = 1; /* The root */
+    size_t common;    /* Length of the prefix shared with the previous name */
+    int i;
+
+    qsort(labels, count, MAX_LABEL_LENGTH, compare_names);
+    for (i = 0; i < count; i++) {
+        common = 0;
+        if (i > 0) {
+            while (labels[i][common] && labels[i][common] == labels[i - 1][common]) common++;
+        }
+        nodes += strlen(labels[i]) - common;
+    }
+    return nodes * sizeof(LegacyTrieNode) + (size_t)count * sizeof(LabelData);
+}
+
+/**
+ * Compares two names for sorting.
+ *
+ * @param first The first name.
+ * @param second The second name.
+ * @return The result of comparing the names.
+ */
+static int compare_names(const void *first, const void *second) {
+    return strcmp((const char *)first, (const char *)second);
+}
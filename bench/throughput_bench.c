@@ -0,0 +1,227 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "../assembler/headers/phase_controller.h"
+#include "../assembler/headers/preprocessor.h"
+#include "../structures/headers/workspace.h"
+#include "../utils/headers/output_files.h"
+#include "source_gen.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Number of lines assembled for every profile - the rounds are repeated until reaching it */
+#define TOTAL_LINES 300000L
+/* The file that the outputs are written to - the files are not kept */
+#define NULL_DEVICE "/dev/null"
+/* ---------------------------------------------------------------------------------------
+ *                                        Structures
+ * --------------------------------------------------------------------------------------- */
+/* A named shape of the generated sources */
+typedef struct Profile {
+    const char *name;
+    long lines;             /* Number of lines of a source */
+    int label_percent;
+    int direct_percent;
+    int macros;
+    int macro_lines;
+    int data_percent;
+} Profile;
+
+/* The measures of a profile */
+typedef struct Measure {
+    double seconds[STAGE_COUNT]; /* Wall time of every stage over all the rounds */
+    long peak_kb[STAGE_COUNT];   /* Peak resident memory at the end of every stage of the first round */
+} Measure;
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static Boolean run_profile(const Profile *profile, AsmWorkspace *workspace);
+static Boolean assemble_round(AsmWorkspace *workspace, const char *source, size_t size, Measure *measure,
+                              Boolean first);
+static long peak_rss_kb(void);
+/* ---------------------------------------------------------------------------------------
+ *                                      Main Function
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Assembles generated sources of several shapes in memory and prints the throughput of every
+ * stage in lines per second, and the peak resident memory of the process at the end of every
+ * stage. A number of lines can be passed to measure a single source of the typical shape:
+ *     bench/throughput_bench 40000
+ * The sources are assembled the way the command line assembler does, in one workspace that is
+ * reset after every source, and the outputs are written to the null device.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The array of command line arguments.
+ * @return EXIT_SUCCESS if all the sources were assembled without errors, EXIT_FAILURE otherwise.
+ */
+int main(int argc, char *argv[]) {
+    static Profile profiles[] = {
+            {"small",       1000, 20, 33,  8,  4, 20},
+            {"typical",    10000, 20, 33,  8,  4, 20},
+            {"large",      30000, 20, 33,  8,  4, 20},
+            {"macro-heavy", 10000, 20, 33, 64, 16, 20},
+            {"label-heavy", 10000, 80, 90,  8,  4, 20},
+            {"data-heavy",  10000, 20, 33,  8,  4, 80}
+    };
+    int count = (int)(sizeof(profiles) / sizeof(profiles[0]));
+    AsmWorkspace workspace;   /* The workspace the sources are assembled in */
+    FILE *diagnostics;        /* The messages of the assembler are not printed */
+    int i;
+    Boolean success = TRUE;
+
+    /* A single source of the typical shape */
+    if (argc > 1) {
+        profiles[1].name = "custom";
+        profiles[1].lines = atol(argv[1]);
+        if (profiles[1].lines < 100) {
+            fprintf(stderr, "usage: throughput_bench [lines (at least 100)]\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!(diagnostics = fopen(NULL_DEVICE, "w"))) return EXIT_FAILURE;
+    if (init_workspace(&workspace, diagnostics, MAX_MEMORY_WORDS) == FALSE) {
+        printf("Memory allocation failed\n");
+        fclose(diagnostics);
+        return EXIT_FAILURE;
+    }
+
+    printf("%-12s %7s | %12s %12s %12s %12s %12s | %9s %9s %9s\n", "profile", "lines",
+           "preproc/s", "first/s", "second/s", "output/s", "total/s", "RSS pre", "phases", "output");
+    for (i = (argc > 1) ? 1 : 0; i < ((argc > 1) ? 2 : count) && success == TRUE; i++) {
+        success = run_profile(&profiles[i], &workspace);
+    }
+    printf("Throughput in lines per second, peak resident memory of the process in KB\n");
+
+    free_workspace(&workspace);
+    fclose(diagnostics);
+    return success == TRUE ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Generates a source of the specified shape, assembles it until TOTAL_LINES lines were
+ * assembled (at least once), and prints the measures.
+ *
+ * @param profile The shape of the source.
+ * @param workspace The workspace to assemble the source in.
+ * @return TRUE if the source was assembled without errors, FALSE otherwise.
+ */
+static Boolean run_profile(const Profile *profile, AsmWorkspace *workspace) {
+    GenOptions options;         /* The shape of the source */
+    Measure measure;            /* The measures of the profile */
+    char *source;               /* The generated source */
+    size_t size;                /* The size of the source in bytes */
+    long words;                 /* Number of memory words of the program */
+    long rounds;                /* Number of times the source is assembled */
+    double lines;               /* Number of lines assembled over all the rounds */
+    double total = 0;           /* Time of all the stages */
+    long round;
+    int stage;
+
+    default_gen_options(&options);
+    options.lines = profile->lines;
+    options.label_percent = profile->label_percent;
+    options.direct_percent = profile->direct_percent;
+    options.macros = profile->macros;
+    options.macro_lines = profile->macro_lines;
+    options.data_percent = profile->data_percent;
+
+    if (!(source = generate_source(&options, &size, &words))) {
+        printf("Failed to generate the source of %s\n", profile->name);
+        return FALSE;
+    }
+    if (words > MAX_MEMORY_WORDS - IC_START) {
+        printf("%-12s %7ld | the program takes %ld words - more than the memory\n", profile->name,
+               profile->lines, words);
+        free(source);
+        return TRUE;
+    }
+
+    for (stage = 0; stage < STAGE_COUNT; stage++) measure.seconds[stage] = 0;
+    rounds = (TOTAL_LINES + profile->lines - 1) / profile->lines;
+    for (round = 0; round < rounds; round++) {
+        if (assemble_round(workspace, source, size, &measure, round == 0 ? TRUE : FALSE) == FALSE) {
+            printf("The source of %s was not assembled without errors\n", profile->name);
+            free(source);
+            return FALSE;
+        }
+    }
+    free(source);
+
+    lines = (double)profile->lines * (double)rounds;
+    printf("%-12s %7ld |", profile->name, profile->lines);
+    for (stage = 0; stage < STAGE_COUNT; stage++) {
+        printf(" %12.0f", measure.seconds[stage] > 0 ? lines / measure.seconds[stage] : 0);
+        total += measure.seconds[stage];
+    }
+    printf(" %12.0f | %9ld %9ld %9ld\n", total > 0 ? lines / total : 0, measure.peak_kb[STAGE_PREPROCESSOR],
+           measure.peak_kb[STAGE_SECOND_PHASE], measure.peak_kb[STAGE_OUTPUT]);
+    return TRUE;
+}
+
+/**
+ * Assembles a source in the workspace the way the command line assembler does, and adds the
+ * time of every stage to the measures. The workspace is reset at the end.
+ *
+ * @param workspace The workspace to assemble the source in.
+ * @param source The source.
+ * @param size The size of the source in bytes.
+ * @param measure The measures to add to.
+ * @param first Flag indicating if the peak resident memory should be recorded.
+ * @return TRUE if the source was assembled without errors, FALSE otherwise.
+ */
+static Boolean assemble_round(AsmWorkspace *workspace, const char *source, size_t size, Measure *measure,
+                              Boolean first) {
+    AsmContext *ctx = &workspace->ctx;
+    CmpData *cmp_data = &workspace->cmp_data;
+    double start;                /* Start time of the current stage */
+    size_t object_size;          /* Size of the object file */
+    Boolean success;
+
+    start = stats_clock();
+    preprocess_source(ctx, source, size, &workspace->am_lines, "bench.as", &workspace->macro_trie);
+    add_stage_time(&ctx->stats, STAGE_PREPROCESSOR, start);
+    if (first == TRUE) measure->peak_kb[STAGE_PREPROCESSOR] = peak_rss_kb();
+
+    success = (get_status(ctx) == ERROR_FREE_FILE &&
+               phases_controller(ctx, &workspace->am_lines, "bench.am", &workspace->macro_trie, cmp_data, 1) == TRUE)
+              ? TRUE : FALSE;
+    if (first == TRUE) {
+        measure->peak_kb[STAGE_FIRST_PHASE] = measure->peak_kb[STAGE_SECOND_PHASE] = peak_rss_kb();
+    }
+
+    if (success == TRUE) {
+        start = stats_clock();
+        success = (write_memory_images(NULL_DEVICE, cmp_data, &object_size) == NO_ERROR &&
+                   write_records(NULL_DEVICE, &cmp_data->entries) == NO_ERROR &&
+                   write_records(NULL_DEVICE, &cmp_data->externals) == NO_ERROR) ? TRUE : FALSE;
+        add_stage_time(&ctx->stats, STAGE_OUTPUT, start);
+        if (first == TRUE) measure->peak_kb[STAGE_OUTPUT] = peak_rss_kb();
+    }
+
+    measure->seconds[STAGE_PREPROCESSOR] += ctx->stats.seconds[STAGE_PREPROCESSOR];
+    measure->seconds[STAGE_FIRST_PHASE] += ctx->stats.seconds[STAGE_FIRST_PHASE];
+    measure->seconds[STAGE_SECOND_PHASE] += ctx->stats.seconds[STAGE_SECOND_PHASE];
+    measure->seconds[STAGE_OUTPUT] += ctx->stats.seconds[STAGE_OUTPUT];
+    reset_workspace(workspace);
+    return success;
+}
+
+/**
+ * Returns the peak resident memory of the process.
+ *
+ * @return The peak resident memory in KB, or 0 if it is not available.
+ */
+static long peak_rss_kb(void) {
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return usage.ru_maxrss;
+}
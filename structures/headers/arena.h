@@ -0,0 +1,70 @@
+#ifndef ARENA_H
+#define ARENA_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+/* ---------------------------------------- Structures ----------------------------------------*/
+/* A block of memory of the arena. The memory handed out follows the header of the block */
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;                       /* The next block of the arena */
+    size_t size;                          /* Number of bytes the block can hold */
+    size_t used;                            /* Number of bytes already handed out */
+} ArenaBlock;
+
+/*
+ * Arena struct
+ * A bump allocator - memory is handed out from large blocks and is never freed one
+ * allocation at a time. Resetting the arena makes all of its memory available again while
+ * keeping the blocks, and freeing the arena releases all the blocks in one shot.
+ */
+typedef struct Arena {
+    ArenaBlock *head;                                /* The first block of the arena */
+    ArenaBlock *current;                   /* The block memory is handed out from */
+    size_t block_size;                          /* Size of the next block to allocate */
+    unsigned long allocations;          /* Number of blocks allocated with `malloc` */
+} Arena;
+
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Initializes an empty arena. No memory is allocated until the first allocation.
+ *
+ * @param arena Pointer to the arena to be initialized.
+ */
+void init_arena(Arena *arena);
+
+/**
+ * Allocates memory from the arena. The memory is suitably aligned for any type, and
+ * stays valid until the arena is reset or freed.
+ *
+ * @param arena Pointer to the arena.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the allocated memory, or NULL if memory allocation failed.
+ */
+void *arena_alloc(Arena *arena, size_t size);
+
+/**
+ * Duplicates a portion of a string up to a specified size into the arena.
+ *
+ * @param arena Pointer to the arena.
+ * @param str The string to duplicate.
+ * @param size The maximum number of characters to duplicate from the string.
+ * @return The null-terminated copy, or NULL if memory allocation failed.
+ */
+char *arena_strndup(Arena *arena, const char *str, size_t size);
+
+/**
+ * Makes all the memory of the arena available again. The blocks are kept, so an arena that
+ * is reset after every line allocates no memory once its blocks are large enough.
+ *
+ * @param arena Pointer to the arena to be reset.
+ */
+void reset_arena(Arena *arena);
+
+/**
+ * Frees all the blocks of the arena, and leaves it empty.
+ *
+ * @param arena Pointer to the arena to be freed.
+ */
+void free_arena(Arena *arena);
+
+#endif /* ARENA_H */
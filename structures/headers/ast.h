@@ -2,6 +2,7 @@
 #define AST_H
 /* ----------------------------------------- Includes -----------------------------------------*/
 #include "errors.h"
+#include "arena.h"
 #include "../../utils/headers/boolean.h"
 #include "../../assembler/headers/defines.h"
 
@@ -35,10 +36,10 @@ typedef struct {
     DirNode *operands;                       /* Linked list of operands for the directive */
 } Directive;
 
-/* Union holding either an integer or a string of instruction operation's operands */
+/* Union holding either an integer or a label of instruction operation's operands */
 typedef union {
     int int_val;                                 /* Integer value for instructions */
-    char char_val[MAX_LABEL_LENGTH]; /* Character array for labels in instructions */
+    int label_id;          /* ID of the label in the label table, for label operands */
 } InstructionValue;
 
 /* Structure representing an operand in an instruction operation */
@@ -72,20 +73,25 @@ typedef struct {
 /* ----------------------------------- Functions Prototypes ------------------------------------*/
 
 /**
- * Creates and initializes an empty AST node.
+ * Creates and initializes an empty AST node in the specified arena.
+ * The node, its line content and its operands live until the arena is reset.
+ *
+ * @param arena The arena that the node is allocated from.
  * @param file The name of the file where the node is created.
  * @param line The line number in the file where the node is created.
+ * @param line_content The content of the line, saved in the node's location.
  * @return A pointer to the newly created AST node, or a null pointer if memory allocation failed.
  */
-ASTNode *create_empty_ASTnode(const char *file, int line, char *line_content);
+ASTNode *create_empty_ASTnode(Arena *arena, const char *file, int line, const char *line_content);
 
 /**
  * Sets the label of an AST node.
  *
  * @param node The AST node whose label is to be set.
- * @param label The label to be set.
+ * @param label The label to be set - does not have to be null-terminated.
+ * @param length The number of characters in the label.
  */
-void set_ast_label(ASTNode *node, const char *label);
+void set_ast_label(ASTNode *node, const char *label, size_t length);
 
 /**
  * Sets the type of an AST node.
@@ -125,26 +131,19 @@ InstructionOperand* get_operand(ASTNode *node, short num);
  *
  * @param node The AST node to which the operand is to be added.
  * @param adr_mode The addressing mode of the operand.
- * @param value The value of the operand.
- * @param num The register number (if applicable) of the operand.
+ * @param value The value of the operand: the integer, the register number or the ID of the label.
  * @return TRUE if the operand was added successfully, FALSE otherwise.
  */
-Boolean add_instruct_operand(ASTNode *node, short adr_mode, const char *value, short num);
+Boolean add_instruct_operand(ASTNode *node, short adr_mode, int value);
 
 /**
  * Adds an operand to a directive.
  *
+ * @param arena The arena that the operand node is allocated from.
  * @param directive The directive to which the operand is to be added.
  * @param operand The operand to be added.
  * @return TRUE if the operand was added successfully, FALSE otherwise.
  */
-Boolean add_directive_operand(Directive *directive, char *operand);
-
-/**
- * Frees the memory allocated for an AST node.
- *
- * @param node: The AST node to be freed.
- */
-void free_ast_node(ASTNode *node);
+Boolean add_directive_operand(Arena *arena, Directive *directive, char *operand);
 
 #endif /* AST_H */
\ No newline at end of file
@@ -3,6 +3,7 @@
 /* ----------------------------------------- Includes -----------------------------------------*/
 #include "../../structures/headers/label_data.h"
 #include "mappings.h"
+#include "context.h"
 
 /* ---------------------------------------- Structures ----------------------------------------*/
 /*
@@ -12,101 +13,181 @@ typedef enum {
     CODE_IMAGE, /* Section containing encoded instructions */
     DATA_IMAGE    /* Section containing encoded directives */
 } MemoryImageType;
+/*
+ * A single 15-bit word of the memory image, held in a native 16-bit integer.
+ * Bit position 0 of a word is its most significant bit (bit 14 of the integer)
+ * and position WORD_END_POS is its least significant bit.
+ */
+typedef unsigned short Word;
+
 /*
  * MemoryImage struct
- * Represents a memory image with a fixed capacity for storing lines of bytes.
- * This structure holds encoded instructions and directives from the input assembly file.
- * Instructions are written starting from the lowest index, while directives are written
- * starting from the highest index.
+ * Represents a memory image that holds the encoded instructions and directives of the input
+ * assembly file. The instructions and the directives are kept in two separate buffers that
+ * grow with use, both written from the lowest index to the highest. Together they may hold at
+ * most `capacity` words - the memory of the machine that follows the IC_START offset.
  */
 typedef struct MemoryImage{
-    char lines[MEMORY_CAPACITY][NUM_OF_BYTES]; /* Storage for lines of bytes */
+    Word *code;                           /* Storage for the instruction words */
+    int code_size;                /* Number of words the code buffer can hold */
     int code_count;       /* Number of instruction lines currently in memory */
     int code_pos;                  /* Position to write the next instruction */
+    Word *data;                             /* Storage for the directive words */
+    int data_size;                /* Number of words the data buffer can hold */
     int data_count;         /* Number of directive lines currently in memory */
     int data_pos;                    /* Position to write the next directive */
+    int capacity;         /* Number of words the program may take in memory */
     Boolean full;                   /* Flag indicating if the memory is full */
 } MemoryImage;
 
+/* Enum representing the kinds of references that are resolved after the first phase */
+typedef enum {
+    FIXUP_OPERAND, /* A label operand - its word in the code image is encoded */
+    FIXUP_ENTRY    /* A label declared as entry - it is written to the entry file */
+} FixupType;
+
+/*
+ * Fixup struct
+ * Represents a reference to a label that can be resolved only after the first phase,
+ * when all the labels are known. The fixups are kept in the order of the source lines.
+ */
+typedef struct Fixup {
+    FixupType type;                  /* The kind of the reference */
+    int address;        /* Index of the word to encode in the code image (operands) */
+    int label_id;             /* The ID of the referenced label in the label table */
+    Location location;     /* The location of the reference, without line content */
+} Fixup;
+
 /*
- * UnresolvedLineList struct
- * Represents a linked list of unresolved lines in the image.
- * Each node contains a line number and a pointer to the next node.
- */
-typedef struct UnresolvedLineList{
-    int line;                          /* Line number of the unresolved line */
-    struct UnresolvedLineList *next; /* Pointer to the next node in the list */
-} UnresolvedLineList;
-
-/* File struct - Represents a file with a pointer to the file stream and the file name */
-typedef struct File{
-    FILE* file;                                /* Pointer to the file stream */
-    char* file_name;                                      /* The file's name */
-    Boolean delete;
-} File;
+ * FixupTable struct
+ * A growable array of fixups. Fixups are appended at the end and consumed in order,
+ * so adding a fixup takes constant time and there is one allocation per growth.
+ */
+typedef struct FixupTable {
+    Fixup *items;                          /* The fixups, in the order they were added */
+    int count;                                         /* Number of fixups in the table */
+    int capacity;                        /* Number of fixups the table can hold */
+} FixupTable;
+
+/*
+ * RecordBuffer struct
+ * The lines of an entry or extern file, kept in memory until the end of the assembly -
+ * the file is created only if the assembly succeeded and there is a line to write.
+ */
+typedef struct RecordBuffer {
+    char *text;                       /* The lines, terminated by '\0' */
+    size_t size;                      /* Length of the lines in bytes */
+    size_t capacity;                  /* Number of bytes allocated for the text */
+} RecordBuffer;
 
 /*
  * CmpData struct
  * Contains all the necessary data for the compilation process.
  * Includes memory images for image and data, a label table,
- * a list of unresolved lines, and file information for external and entry files.
+ * a table of fixups, and the lines of the external and entry files.
  */
 typedef struct CmpData{
     MemoryImage image;                /* Memory image for the image section */
-    Trie label_table;                            /* Trie for storing labels */
-    UnresolvedLineList *line_list;       /* Linked list of unresolved lines */
-    File extern_file;             /* File information for the external file */
-    File entry_file;                 /* File information for the entry file */
+    LabelTable label_table;                  /* Table for storing labels */
+    FixupTable fixups;         /* Label references to resolve after phase one */
+    RecordBuffer externals;              /* The lines of the external file */
+    RecordBuffer entries;                   /* The lines of the entry file */
 } CmpData;
 
 /* ----------------------------------- Functions Prototypes ------------------------------------*/
 /**
  * Function to initialize the ProgramData structure.
- * Initializes the sets to be empty sets and sets the corresponding pointers
- * of the sets to the setMappings.
+ * Allocates the memory image and the label table. The structure can be reused for several
+ * files with `reset_cmp_data`.
+ *
  * @param data Pointer to the ProgramData to be initialized
+ * @param memory_words The number of words of the machine memory, including the IC_START offset.
+ * @return NO_ERROR if the initialization succeeded, MEMORY_ALLOCATION_ERROR otherwise.
+ */
+ErrorCode init_cmp_data(CmpData *data, int memory_words);
+
+/**
+ * Sets the number of words of the machine memory, for the next file. The sections of the memory
+ * image grow with use, so no memory is allocated.
+ *
+ * @param data Pointer to the ProgramData - empty, after initialization or reset.
+ * @param memory_words The number of words of the machine memory, including the IC_START offset.
+ */
+void set_memory_words(CmpData *data, int memory_words);
+
+/**
+ * Makes room in both sections of the memory image for all the words the program may take, so
+ * the sections are not moved while the program is written. The words are kept after a reset.
+ *
+ * @param image Pointer to the memory image.
+ * @return TRUE if the sections hold all the words, FALSE if memory allocation failed.
  */
-ErrorCode init_cmp_data(CmpData *data, const char *file_name);
+Boolean reserve_image(MemoryImage *image);
 
+/**
+ * Empties the memory image, the fixup table, the label table and the entry and extern
+ * lines, keeping their memory for the next file. Only the words that were written are
+ * cleared, so the cost depends on the size of the assembled program and not on the size
+ * of the memory.
+ *
+ * @param data Pointer to the ProgramData to be reset.
+ */
+void reset_cmp_data(CmpData *data);
+
+/**
+ * Adds a fixup to the end of the fixup table, to be resolved after the first phase.
+ *
+ * @param data The program's data structure containing the fixup table.
+ * @param type The kind of the reference.
+ * @param address Index of the word in the code image (used only for operands).
+ * @param label_id The ID of the referenced label in the label table.
+ * @param location The location of the reference. The line content is not saved.
+ * @return TRUE if the fixup was added successfully, FALSE if memory allocation failed.
+ */
+Boolean add_fixup(CmpData *data, FixupType type, int address, int label_id, Location location);
 
 /**
- * Adds a line to the unresolved line list for the second phase.
- * Saves the line number in thr unresolved line list.
+ * Appends a line of a label and its address to the specified entry or extern lines.
+ * The label is left-justified in 31 characters, and the address is at least 4 digits.
  *
- * @param data The program's data structure containing the unresolved line list.
- * @param line The line number to be added to the unresolved line list.
- * @return TRUE if the line was added successfully, FALSE if memory allocation failed.
+ * @param records The lines to append to.
+ * @param label The label to be written.
+ * @param address The address associated with the label.
+ * @return TRUE if the line was added, FALSE if memory allocation failed.
  */
-Boolean add_unresolved_line(CmpData *data, int line);
+Boolean add_label_record(RecordBuffer *records, const char *label, int address);
 
 /**
- * Retrieves and removes the next unresolved line from the list.
- * Returns the number (integer) of the unresolved line.
+ * Retrieves the absolute address of a label. The code section starts at IC_START and the data
+ * section right after the last instruction.
  *
- * @param data The program's data structure containing the unresolved line list.
- * @return The line number of the next unresolved line, or -1 if the list is empty.
+ * @param data The program's data structure containing the label table and the memory image.
+ * @param label_id The ID of the label in the label table.
+ * @return The address of the label, or 0 if the label is external.
  */
-int get_unresolved_line(CmpData *data);
+int resolve_label_address(const CmpData *data, int label_id);
 
 /**
  * Updates the code memory image counter.
  * Increments the code memory image code_count and positions the writer pointer in the correct position.
  * The encoded instruction are written from the lowest index to the highest.
  *
+ * @param ctx The context of the assembly process.
  * @param memory_image A pointer to the MemoryImage structure containing the code counter and the write
  *                     pointer is to be updated.
  */
-void updt_code_counter(MemoryImage *memory_image);
+void updt_code_counter(AsmContext *ctx, MemoryImage *memory_image);
 
 /**
  * Updates the data memory image counter.
  * Increments the memory image data_count and positions the writer pointer in the correct position.
- * The encoded directives are written from the highest index to the lowest.
+ * The encoded directives are written from the lowest index to the highest.
  *
+ * @param ctx The context of the assembly process.
  * @param memory_image A pointer to the MemoryImage structure containing the code counter and the write
  *                     pointer is to be updated.
  */
-void updt_data_counter(MemoryImage *memory_image);
+void updt_data_counter(AsmContext *ctx, MemoryImage *memory_image);
 
 /**
  * Sets the code image counter and writer back by one position, allowing the re-encoding of
@@ -117,12 +198,10 @@ void updt_data_counter(MemoryImage *memory_image);
 void seek_back(MemoryImage *memory_image);
 
 /**
- * Frees the CmpData structure, containing all the programs data, including closing and
- * optionally deleting files.
+ * Frees the CmpData structure, containing all the programs data.
  *
  * @param cmp_data The programs data to be freed.
- * @param delete If TRUE, delete the files associated with the CmpData structure.
  */
-void free_cmp_data(CmpData *cmp_data, Boolean delete);
+void free_cmp_data(CmpData *cmp_data);
 
 #endif /* CMP_DATA_H */
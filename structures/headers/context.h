@@ -0,0 +1,65 @@
+#ifndef CONTEXT_H
+#define CONTEXT_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include <stdio.h>
+#include "errors.h"
+#include "arena.h"
+#include "stats.h"
+/* ---------------------------------------- Structures ----------------------------------------*/
+/*
+ * AsmOptions struct
+ * Holds the command line options, shared by the assembly processes of all the files.
+ */
+typedef struct AsmOptions {
+    int jobs;        /* Number of files to assemble at the same time */
+    Boolean emit_am; /* Flag indicating whether to write the preprocessed source to a .am file */
+    int memory_words; /* Number of words of the machine memory */
+    Boolean stats;   /* Flag indicating whether to print the statistics of every file */
+    const char *cache_dir; /* Directory of the build cache, or NULL if the cache is not used */
+    const char *manifest;  /* File listing the base names of a batch, or NULL */
+    const char *source_dir; /* Directory whose sources (.as) form a batch, or NULL */
+    Boolean pipeline; /* Flag indicating whether the first pass of a file runs as a pipeline of threads */
+    int encode_threads; /* Number of threads that encode the lines of the first phase of a file */
+} AsmOptions;
+
+/*
+ * AsmContext struct
+ * Holds the state of a single assembly process: the current error, the status of the
+ * processed file, the stream that error messages are printed to, the memory arena of the
+ * current line and the statistics of the file.
+ * Every assembly process has its own context, so several assemblies can run in the same
+ * process at the same time.
+ */
+typedef struct AsmContext {
+    Error error;                  /* The last error that was set */
+    ProgramStatus program_status; /* Status and counters of the processed file */
+    FILE *output;                 /* Stream for error messages, warnings and summaries */
+    Arena line_arena;             /* Memory of the current line - reset after every line */
+    AsmStats stats;               /* Times and counters of the processed file */
+} AsmContext;
+
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Initializes the context of an assembly process to an error free state.
+ *
+ * @param ctx Pointer to the context to be initialized.
+ * @param output The stream that error messages, warnings and summaries are printed to.
+ */
+void init_context(AsmContext *ctx, FILE *output);
+
+/**
+ * Resets the context to an error free state for the assembly of the next file.
+ * The blocks of the line arena are kept.
+ *
+ * @param ctx Pointer to the context to be reset.
+ */
+void reset_context(AsmContext *ctx);
+
+/**
+ * Frees the memory of an assembly process - the memory arena of the context.
+ *
+ * @param ctx Pointer to the context to be freed.
+ */
+void free_context(AsmContext *ctx);
+
+#endif /* CONTEXT_H */
@@ -1,6 +1,8 @@
 #ifndef ERRORS_H
 #define ERRORS_H
+#include <stdio.h>
 #include "../../assembler/headers/defines.h"
+#include "../../utils/headers/boolean.h"
 /* ----------------------------- Defines ----------------------------- */
 #define STRINGIFY(x) #x
 #define TOSTRING(x) STRINGIFY(x)
@@ -16,9 +18,14 @@ typedef enum {
     NO_ARGUMENTS,
     FAILED_OPEN_FILE,
     FAILED_CREATE_FILE,
+    FAILED_WRITE_FILE,
     FAILED_CLOSE_FILE,
     FAILED_DELETE_FILE,
 
+    /* ==== Command Line Errors ==== */
+    INVALID_OPTION,
+    SERVER_SOCKET_ERROR,
+
     /* ======== Line Errors ======= */
     LINE_TOO_LONG,
 
@@ -33,6 +40,7 @@ typedef enum {
     LABEL_RESERVED_WORD,
     LABEL_MACR_COLLIDES,
     UNRECOGNIZED_LABEL,
+    LABEL_ADDRESS_OUT_OF_RANGE,
     LABEL_DUPLICATE,
     INVALID_LABEL_LENGTH,
     INVALID_CHAR_LABEL,
@@ -96,41 +104,61 @@ typedef struct {
     Status status;                      /* Status code */
     int error_counter;     /* Number of errors in file */
     int warning_counter; /* Number of warnings in file */
+    Boolean file_error;   /* Flag indicating if a file could not be read or written */
 } ProgramStatus;
 
+/* Structure that represents the totals of a batch of files */
+typedef struct {
+    long files;      /* Number of files assembled */
+    long succeeded;  /* Number of files that were processed successfully */
+    long failed;     /* Number of files that could not be processed */
+    long errors;     /* Number of errors in all the files */
+    long warnings;   /* Number of warnings in all the files */
+} BatchSummary;
+
+/* The context of a single assembly process - defined in context.h */
+struct AsmContext;
+
 /* ---------------------------- Functions Prototypes ---------------------------- */
 /**
- * Sets the current error with the specified error code and location.
+ * Sets the current error of the specified context with the specified error code and location.
  *
+ * @param ctx The context of the assembly process.
  * @param code The error code to set.
  * @param location The location in the source file where the error occurred.
  */
-void set_error(ErrorCode code, Location location);
+void set_error(struct AsmContext *ctx, ErrorCode code, Location location);
 
 /**
  * Sets a general error with the specified error code but without a specific location.
  *
+ * @param ctx The context of the assembly process.
  * @param code The error code to set.
  */
-void set_general_error(ErrorCode code);
+void set_general_error(struct AsmContext *ctx, ErrorCode code);
 
 /**
  * Makes a copy of the given string, and saves it as the line content in the specified
  * location struct.
  * @param location the location struct to save the line into.
  * @param content the string to save as a content in the location struct.
+ * @return TRUE if the content was saved, FALSE if memory allocation failed.
  */
-void save_line_content(Location *location, char *content);
+Boolean save_line_content(Location *location, const char *content);
 
 /**
  * Clears the current error, resetting it to NO_ERROR with a default location.
+ *
+ * @param ctx The context of the assembly process.
  */
-void clear_error();
+void clear_error(struct AsmContext *ctx);
 
 /**
  * Resets the program's status to 'error free file status'.
+ *
+ * @param ctx The context of the assembly process.
  */
-void clear_status();
+void clear_status(struct AsmContext *ctx);
 
 /**
  * Frees the memory allocated for the Location struct.
@@ -141,32 +169,68 @@ void free_location(Location *location);
 /**
  * Returns the current error code.
  *
+ * @param ctx The context of the assembly process.
  * @return The current error code.
  */
-ErrorCode get_error();
+ErrorCode get_error(const struct AsmContext *ctx);
 
 /**
  * Returns the current program's status.
  *
+ * @param ctx The context of the assembly process.
  * @return The current program's status.
  */
-Status get_status();
+Status get_status(const struct AsmContext *ctx);
 
  /**
   * Prints a warning message that corresponding to the specified warning code.
   *
+  * @param ctx The context of the assembly process.
   * @param code The warning code, indicating the cause of the warning.
   * @param location The location of the line that triggered the warning.
   */
-void print_warning(WarningCode code, Location *location);
+void print_warning(struct AsmContext *ctx, WarningCode code, Location *location);
 
 /**
  * Prints the status of the program, including a summary of errors.
  * Indicates whether the file processing completed successfully, and the number
  * of errors and warnings that occurred during the process.
  *
+ * @param ctx The context of the assembly process.
  * @param file The name of the file that was processed.
  */
-void print_error_summery(char *file);
+void print_error_summery(struct AsmContext *ctx, const char *file);
+
+/**
+ * Resets the totals of a batch of files to zero.
+ *
+ * @param batch The totals of the batch.
+ */
+void clear_batch_summary(BatchSummary *batch);
+
+/**
+ * Adds the status and counters of an assembled file to the totals of its batch.
+ *
+ * @param batch The totals of the batch.
+ * @param program_status The status of the file at the end of its process.
+ */
+void add_to_batch_summary(BatchSummary *batch, const ProgramStatus *program_status);
+
+/**
+ * Adds the totals of a part of a batch to the totals of the whole batch.
+ *
+ * @param batch The totals of the whole batch.
+ * @param part The totals of the part.
+ */
+void merge_batch_summary(BatchSummary *batch, const BatchSummary *part);
+
+/**
+ * Prints the totals of a batch of files - the counts that the summary of every file
+ * prints, added up, and the number of files that succeeded and failed.
+ *
+ * @param output The stream to print to.
+ * @param batch The totals of the batch.
+ */
+void print_batch_summary(FILE *output, const BatchSummary *batch);
 
 #endif /* ERRORS_H */
@@ -1,94 +1,133 @@
 #ifndef LABEL_DATA_H
 #define LABEL_DATA_H
 /* ----------------------------------------- Includes -----------------------------------------*/
-#include "trie.h"
+#include "symbol_table.h"
 /* ---------------------------------------- Structures ----------------------------------------*/
 /* Enum for label types */
 typedef enum {
     DIRECTIVE,
     INSTRUCTION,
     EXTERNAL,
-    ENTERNAL
+    ENTERNAL,
+    UNDEFINED   /* A label that was referenced, but has not been defined */
 } LabelType;
 
-/* Trie node structure for label node */
+/* Enum for the sections a label can be defined in */
+typedef enum {
+    SECTION_NONE, /* The label has no address in this file - external or undefined */
+    SECTION_CODE, /* The label is defined on an instruction line */
+    SECTION_DATA  /* The label is defined on a data or string directive */
+} LabelSection;
+
+/*
+ * Data of a label in the label table.
+ * The address of a label is kept relative to its section, and the absolute address is
+ * computed only when the label is read - the data section starts after the last instruction,
+ * so its labels do not have to be relocated when the first phase ends.
+ */
 typedef struct LabelData {
-    int address;       /* label address */
+    int offset;           /* label offset in its section */
+    LabelSection section; /* label section */
     LabelType label_type; /* label type */
 } LabelData;
 
+/*
+ * LabelTable struct
+ * The labels of a program. A label name is interned to a dense integer ID the first time it
+ * is seen - referenced or defined - and the data of the labels is kept in an array indexed
+ * by ID, so a label that is known by its ID is resolved with a single array access.
+ */
+typedef struct LabelTable {
+    SymbolTable names;   /* The names of the labels - the index of a name is the ID of the label */
+    LabelData *labels;   /* The data of the labels, indexed by ID */
+    int capacity;        /* Number of labels the data array can hold */
+} LabelTable;
+
 /* ----------------------------------- Functions Prototypes ------------------------------------*/
 /**
- * Initialize the label trie.
- * This function sets up the trie for storing labels, it uses the init_trie method of the
- * generic trie structure.
+ * Initialize the label table.
+ * This function sets up the table for storing labels, it uses the init_symbol_table method of the
+ * generic symbol table structure for the names of the labels.
  *
- * @param trie Pointer to the trie structure.
+ * @param table Pointer to the label table.
  * @return TRUE if the initialization was successful, FALSE otherwise.
  */
-Boolean init_label_trie(Trie *trie);
+Boolean init_label_table(LabelTable *table);
 
 /**
- * Insert a label into the trie with its address and type.
- * Allocates memory for label data and inserts it into the trie.
- * Uses the generic trie structure methods.
+ * Retrieve the ID of a label, interning its name if it was not seen before.
+ * A new label is UNDEFINED until it is inserted with `insert_label`.
  *
- * @param trie Pointer to the trie structure.
+ * @param table Pointer to the label table.
+ * @param label The name of the label - does not have to be null-terminated.
+ * @param length The number of characters in the name.
+ * @return The ID of the label, or -1 if memory allocation failed.
+ */
+int intern_label(LabelTable *table, const char *label, size_t length);
+
+/**
+ * Insert a label into the table with its offset and type - defines the label.
+ * The section of the label follows from its type: INSTRUCTION labels are in the code section,
+ * DIRECTIVE labels in the data section and EXTERNAL labels in none.
+ * Uses the generic symbol table methods.
+ *
+ * @param table Pointer to the label table.
  * @param label The label to be inserted.
- * @param address The address associated with the label.
+ * @param offset The offset of the label in its section.
  * @param label_type The type of the label.
  * @return ErrorCode - Error code of the error that occurred or NO_ERROR if the process
  *          executed successfully.
  */
-ErrorCode insert_label(Trie *trie, const char *label, int address, LabelType label_type);
+ErrorCode insert_label(LabelTable *table, const char *label, int offset, LabelType label_type);
+
+/**
+ * Retrieve the ID of a label without interning it.
+ *
+ * @param table Pointer to the label table.
+ * @param label The name of the label.
+ * @return The ID of the label if it was seen, -1 otherwise.
+ */
+int find_label_id(const LabelTable *table, const char *label);
 
 /**
- * Retrieve the address of a label from the trie.
- * Searches the trie for the label and returns its address.
+ * Retrieve the name of a label.
  *
- * @param trie Pointer to the trie structure.
- * @param label The label whose address is to be retrieved.
- * @return The address of the label if found, -1 otherwise.
+ * @param table Pointer to the label table.
+ * @param id The ID of the label.
+ * @return The name of the label.
  */
-int get_label_addr(Trie *trie, const char *label);
+const char *label_name(const LabelTable *table, int id);
 
 /**
- * Retrieve the type of a label from the trie.
- * Searches the trie for the label and returns its type.
+ * Retrieve the absolute address of a label from the start addresses of the sections.
  *
- * @param trie Pointer to the trie structure.
- * @param label The label whose type is to be retrieved.
- * @return The type of the label if found, -1 otherwise.
+ * @param label The data of the label.
+ * @param code_start The address of the first instruction.
+ * @param data_start The address of the first data word.
+ * @return The address of the label, or 0 if the label has no section (external).
  */
-LabelType get_label_type(Trie *trie, const char *label);
+int label_address(const LabelData *label, int code_start, int data_start);
 
 /**
- * Set the label type for an existing label in the trie.
- * Searches for the label in the trie and updates its type.
+ * Calculate the memory held by the label table, including the data of the labels.
  *
- * @param trie Pointer to the trie structure.
- * @param label The label whose type is to be set.
- * @param label_type The new type to be assigned to the label.
- * @return TRUE if the label type was successfully set, FALSE otherwise.
+ * @param table Pointer to the label table.
+ * @return The number of allocated bytes.
  */
-Boolean set_label_type(Trie *trie, const char *label, LabelType label_type);
+size_t label_table_memory(const LabelTable *table);
 
 /**
- * Update the addresses of nodes of a specified type.
- * Increments the addresses of nodes of the given type by the specified amount.
+ * Empty the label table, keeping its memory for the labels of the next file.
  *
- * @param node Pointer to the current trie node.
- * @param increment The amount to increment the addresses by.
- * @param type The type of labels to update.
+ * @param table Pointer to the label table.
  */
-void update_addr(TrieNode *node, int increment, LabelType type);
+void reset_label_table(LabelTable *table);
 
 /**
- * Free the entire label trie.
- * Frees the memory for all nodes in the trie and resets the struct pointers to null.
+ * Free the entire label table.
  *
- * @param trie Pointer to the trie structure.
+ * @param table Pointer to the label table.
  */
-void free_label_tree(Trie *trie);
+void free_label_table(LabelTable *table);
 
 #endif /* LABEL_DATA_H */
@@ -0,0 +1,70 @@
+#ifndef LINE_BUFFER_H
+#define LINE_BUFFER_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include <stdio.h>
+#include <stddef.h>
+#include "../../utils/headers/boolean.h"
+/* ---------------------------------------- Structures ----------------------------------------*/
+/*
+ * LineBuffer struct
+ * Holds the lines of a file in memory, one after the other in a single growing block.
+ * Every line is kept as it would be written to the file (including its '\n', if exists)
+ * followed by a null-terminator, so a line can be used directly from the buffer.
+ */
+typedef struct LineBuffer {
+    char *text;      /* The lines, each one terminated by '\0' */
+    size_t size;     /* Number of used characters in the text */
+    size_t capacity; /* Number of allocated characters for the text */
+    int count;       /* Number of lines in the buffer */
+} LineBuffer;
+
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Initializes an empty line buffer.
+ *
+ * @param buffer Pointer to the line buffer to be initialized.
+ */
+void init_line_buffer(LineBuffer *buffer);
+
+/**
+ * Adds a copy of the specified line to the end of the line buffer.
+ *
+ * @param buffer Pointer to the line buffer.
+ * @param line The line to be added.
+ * @return TRUE if the line is added successfully, FALSE if memory allocation failed.
+ */
+Boolean add_line(LineBuffer *buffer, const char *line);
+
+/**
+ * Retrieves the next line of the line buffer.
+ * Start with a position of 0 to iterate the lines from the first one.
+ *
+ * @param buffer Pointer to the line buffer.
+ * @param pos Pointer to the position of the next line, updated by the function.
+ * @return The next line, or NULL if there are no more lines.
+ */
+const char *next_line(const LineBuffer *buffer, size_t *pos);
+
+/**
+ * Writes all the lines of the line buffer to the specified file.
+ *
+ * @param buffer Pointer to the line buffer.
+ * @param file The file to write the lines to.
+ */
+void write_lines(const LineBuffer *buffer, FILE *file);
+
+/**
+ * Empties the line buffer, keeping its memory for the lines of the next file.
+ *
+ * @param buffer Pointer to the line buffer to be emptied.
+ */
+void reset_line_buffer(LineBuffer *buffer);
+
+/**
+ * Frees the memory of the line buffer, leaving it empty.
+ *
+ * @param buffer Pointer to the line buffer to be freed.
+ */
+void free_line_buffer(LineBuffer *buffer);
+
+#endif /* LINE_BUFFER_H */
@@ -1,7 +1,7 @@
 #ifndef MACRO_LIST_H
 #define MACRO_LIST_H
 /* ----------------------------------------- Includes -----------------------------------------*/
-#include "trie.h"
+#include "symbol_table.h"
 #include "../../assembler/headers/defines.h"
 
 /* ---------------------------------------- Structures ----------------------------------------*/
@@ -18,12 +18,12 @@ typedef struct MacroData {
 } MacroData;
 
 /*
- * Trie node structure. Contains pointer to the last added node to consecutively
+ * Macro table structure. Contains the data of the last added macro to consecutively
  * read macros content into the structure
  */
 typedef struct MacroTrie {
-    Trie trie; /* Trie to hold the macro names and associated data */
-    TrieNode* last_added_node;   /* Pointer to the last added node */
+    SymbolTable table; /* Table to hold the macro names and associated data */
+    MacroData* last_added;          /* Data of the last added macro */
 } MacroTrie;
 
 /* ----------------------------------- Functions Prototypes ------------------------------------*/
@@ -52,24 +52,33 @@ ErrorCode add_macr(MacroTrie *macr_trie, const char *macr_name);
  * @param line The line to be added.
  * @return TRUE if the line is added successfully, FALSE otherwise.
  */
-void add_line_to_last_macro(MacroTrie *macr_trie, const char *line);
+Boolean add_line_to_last_macro(MacroTrie *macr_trie, const char *line);
 
 /**
  * Finds a macro in the Macro Trie.
  *
  * @param macr_trie Pointer to the Macro Trie structure.
- * @param macr_name The name of the macro.
- * @return Pointer to the TrieNode representing the macro, or NULL if not found.
+ * @param macr_name The name of the macro - does not have to be null-terminated.
+ * @param length The number of characters in the name.
+ * @return Pointer to the symbol representing the macro, or NULL if not found.
+ *         The data of the symbol is NULL once the macro contents were freed.
  */
-TrieNode* find_macro(const MacroTrie *macr_trie, const char *macr_name);
+Symbol* find_macro(const MacroTrie *macr_trie, const char *macr_name, size_t length);
 
 /**
- * Frees all data in the trie without freeing the nodes.
+ * Frees the contents of all the macros, keeping their names in the table.
  *
  * @param macr_trie Pointer to the Macro Trie structure.
  */
 void free_trie_data(MacroTrie *macr_trie);
 
+/**
+ * Empties the Macro Trie, keeping the memory of its table for the macros of the next file.
+ *
+ * @param macr_trie Pointer to the Macro Trie structure.
+ */
+void reset_macr_trie(MacroTrie *macr_trie);
+
 /**
  * Frees the entire Macro Trie.
  *
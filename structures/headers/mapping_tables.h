@@ -0,0 +1,47 @@
+#ifndef MAPPING_TABLES_H
+#define MAPPING_TABLES_H
+/*
+ * The mapping tables of the assembly language, with the name and the hash of a reserved word.
+ * They are used by the mappings module, and by the keyword hash generator that is linked with
+ * them to build the perfect hash of all the reserved words (keyword_hash.h) at build time.
+ */
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include <stddef.h>
+#include "mappings.h"
+/* ------------------------------------------ Defines ------------------------------------------*/
+/* Number of entries in the keyword hash table - a power of two, larger than the number of keywords */
+#define KEYWORD_HASH_SIZE 64
+/* ----------------------------------------- Mappings ------------------------------------------*/
+/* Directive table mapping directive names to their corresponding types */
+extern const DirectiveMapping directive_table[];
+
+/* Mapping of instruction names to their corresponding function parameters and addressing modes */
+extern const InstructMapping instruct_table[];
+
+/* Register table listing the names of available registers */
+extern const char *const registers[];
+
+/* Table for macro commands - initialization and the end of initialization of a macro */
+extern const MacrReserved macr_reserved_table[];
+
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Retrieves the name of a keyword from the mapping tables.
+ *
+ * @param keyword The keyword - its type and its index in the table of the type.
+ * @return The name of the keyword, or an empty string if the keyword does not exist.
+ */
+const char *keyword_name(Keyword keyword);
+
+/**
+ * Calculates the hash of a keyword with the specified seed (FNV-1a). The generator searches
+ * for a seed with which every keyword gets its own entry of the keyword hash table.
+ *
+ * @param seed The seed of the hash.
+ * @param str The word to hash.
+ * @param length The number of characters in the word.
+ * @return The index of the word in the keyword hash table.
+ */
+int keyword_hash(unsigned long seed, const char *str, size_t length);
+
+#endif /* MAPPING_TABLES_H */
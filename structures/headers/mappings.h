@@ -33,6 +33,21 @@ typedef struct {
     MacrCommand macr_code;                /* The command */
 } MacrReserved;
 
+/* Enum representing the classes of reserved words */
+typedef enum {
+    KEYWORD_NONE,        /* Not a reserved word */
+    KEYWORD_INSTRUCTION, /* An instruction name */
+    KEYWORD_DIRECTIVE,   /* A directive name */
+    KEYWORD_REGISTER,    /* A register name */
+    KEYWORD_MACRO        /* A word of macro initialization */
+} KeywordType;
+
+/* Structure representing a reserved word - its class and its index in the table of the class */
+typedef struct {
+    KeywordType type; /* The class of the word */
+    short index;      /* The index of the word in the table of its class, or -1 */
+} Keyword;
+
 /* ----------------------------------- Functions Prototypes ---------------------------------- */
 /**
  * Retrieves the number of parameters required by an instruction.
@@ -50,6 +65,16 @@ short get_num_param(short i);
  */
 DirectiveType get_dir_command (short i);
 
+/**
+ * Classifies a word with a single lookup in the perfect hash of all the reserved words.
+ *
+ * @param str The word to classify - does not have to be null-terminated.
+ * @param length The number of characters in the word.
+ * @return The class of the word and its index in the table of the class, or
+ *         {KEYWORD_NONE, -1} if the word is not reserved.
+ */
+Keyword find_keyword(const char *str, size_t length);
+
 /**
  * Finds the index in the instruction table of an instruction based on its name.
  *
@@ -94,10 +119,11 @@ MacrCommand find_macr_reserved(const char* str);
 Boolean valid_addr_mode(int command_index, int addr_mode, int param);
 
 /**
- * Checks if a given string is a reserved word, including instructions, directives, or registers.
+ * Checks if a given string is a reserved word, including instructions, directives, registers
+ * or macro words.
  *
  * @param str The string to check.
- * @return TRUE if the string matches an instruction, directive, or register ; FALSE otherwise.
+ * @return TRUE if the string matches a reserved word ; FALSE otherwise.
  */
 Boolean reserved_word(const char *str);
 
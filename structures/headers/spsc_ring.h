@@ -0,0 +1,68 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include <pthread.h>
+#include "../../utils/headers/boolean.h"
+/* ----------------------------------------- Defines ------------------------------------------*/
+/* Size of a cache line - the positions of the ring are kept on different lines */
+#define CACHE_LINE_SIZE 64
+/* ---------------------------------------- Structures ----------------------------------------*/
+/*
+ * SpscRing struct
+ * A bounded ring of pointers between exactly one producer thread and one consumer thread.
+ * The producer is the only writer of the tail and the consumer the only writer of the head,
+ * so neither side takes a lock: a slot is published by storing the tail after it was written
+ * (release), and it is read only after the tail was loaded (acquire) - and the same for the head
+ * in the other direction.
+ * A side that waited for a while sleeps on a condition variable instead, and the other side wakes
+ * it after it changed its position - the lock is taken only when a side sleeps.
+ */
+typedef struct SpscRing {
+    void **slots;                       /* The slots - a power of two of them */
+    unsigned long mask;                 /* Number of slots minus one */
+    char pad1[CACHE_LINE_SIZE];
+    unsigned long head;                 /* Number of items taken - written by the consumer */
+    char pad2[CACHE_LINE_SIZE];
+    unsigned long tail;                 /* Number of items put - written by the producer */
+    char pad3[CACHE_LINE_SIZE];
+    int sleepers;                       /* Number of sides sleeping on the ring */
+    pthread_mutex_t lock;               /* Guards the sleep of a side */
+    pthread_cond_t changed;             /* Signalled when a position changed while a side sleeps */
+} SpscRing;
+
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Initializes an empty ring.
+ *
+ * @param ring Pointer to the ring to be initialized.
+ * @param capacity The number of items the ring holds - rounded up to a power of two.
+ * @return TRUE if the ring was initialized, FALSE if memory allocation failed or its lock could
+ *         not be initialized.
+ */
+Boolean init_ring(SpscRing *ring, unsigned long capacity);
+
+/**
+ * Puts an item at the end of the ring - called by the producer only. Waits while the ring is full.
+ *
+ * @param ring Pointer to the ring.
+ * @param item The item to put.
+ */
+void ring_put(SpscRing *ring, void *item);
+
+/**
+ * Takes the item at the start of the ring - called by the consumer only. Waits while the ring is empty.
+ *
+ * @param ring Pointer to the ring.
+ * @return The item.
+ */
+void *ring_take(SpscRing *ring);
+
+/**
+ * Frees the slots and the lock of the ring - the items belong to the caller. A ring that was
+ * zeroed, or whose initialization failed, may be freed too.
+ *
+ * @param ring Pointer to the ring to be freed.
+ */
+void free_ring(SpscRing *ring);
+
+#endif /* SPSC_RING_H */
@@ -0,0 +1,79 @@
+#ifndef STATS_H
+#define STATS_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include <stdio.h>
+#include <stddef.h>
+#include "errors.h"
+/* ---------------------------------------- Structures ----------------------------------------*/
+/*
+ * Enum representing the timed stages of the assembly of a file.
+ */
+typedef enum {
+    STAGE_PREPROCESSOR,  /* Reading and preprocessing the source */
+    STAGE_FIRST_PHASE,   /* Parsing and encoding the lines */
+    STAGE_SECOND_PHASE,  /* Resolving the label references */
+    STAGE_OUTPUT,        /* Writing the object, entry and extern outputs */
+    STAGE_COUNT          /* Number of stages */
+} AsmStage;
+
+/*
+ * AsmStats struct
+ * The wall time of every stage and the counters of the assembly of a single file.
+ */
+typedef struct AsmStats {
+    double seconds[STAGE_COUNT];  /* Wall time of every stage, in seconds */
+    long lines_read;              /* Number of lines read from the source */
+    long macros_defined;          /* Number of macros that were defined */
+    long macros_expanded;         /* Number of macro usages that were expanded */
+    long macro_line_nodes;        /* Number of line nodes allocated for the macros contents */
+    long labels;                  /* Number of distinct label names, defined or referenced */
+    long unresolved_operands;     /* Number of label operands left to the second phase */
+    long bytes_written;           /* Number of bytes of the outputs (.am, .ob, .ent and .ext) */
+    long cache_hits;              /* Number of times the outputs were restored from the build cache */
+    long cache_misses;            /* Number of times the build cache had no outputs to restore */
+} AsmStats;
+
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Resets the times and counters of the specified statistics to zero.
+ *
+ * @param stats Pointer to the statistics to be reset.
+ */
+void reset_stats(AsmStats *stats);
+
+/**
+ * Returns the current time of a monotonic clock, to measure the wall time of a stage.
+ *
+ * @return The current time in seconds, from an arbitrary starting point.
+ */
+double stats_clock(void);
+
+/**
+ * Adds the time that passed since the specified start to the wall time of a stage.
+ *
+ * @param stats Pointer to the statistics.
+ * @param stage The timed stage.
+ * @param start The time the stage started, returned by `stats_clock`.
+ */
+void add_stage_time(AsmStats *stats, AsmStage stage, double start);
+
+/**
+ * Prints the statistics of a file as a single line JSON object, so the statistics of a batch
+ * can be aggregated by other tools.
+ *
+ * @param output The stream to print to.
+ * @param file_name The base name of the file.
+ * @param status The final status of the file.
+ * @param stats Pointer to the statistics of the file.
+ */
+void print_stats(FILE *output, const char *file_name, Status status, const AsmStats *stats);
+
+/**
+ * Returns the name of a status, as printed in the statistics and in the replies of the server.
+ *
+ * @param status The status.
+ * @return The name of the status - "ok", "error" or "fatal".
+ */
+const char *status_name(Status status);
+
+#endif /* STATS_H */
@@ -0,0 +1,123 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../utils/headers/boolean.h"
+#include "errors.h"
+/* ---------------------------------------- Structures ----------------------------------------*/
+/* Generic symbol structure - a name in the table with its data */
+typedef struct Symbol {
+    size_t name;                      /* Offset of the name in the string arena */
+    unsigned long hash;                                   /* Hash of the name */
+    void *data;                   /* Generic pointer to store additional data */
+} Symbol;
+
+/*
+ * SymbolTable struct
+ * A hash table of names with generic data. The symbols are kept in one array in the order
+ * they were inserted, and their names are kept in one block of memory (string arena).
+ * The buckets hold indexes into the symbol array (open addressing).
+ */
+typedef struct SymbolTable {
+    Symbol *symbols;                   /* The symbols, in the order they were inserted */
+    int count;                                          /* Number of symbols in the table */
+    int capacity;                          /* Number of symbols the array can hold */
+    int *buckets;                     /* Indexes of the symbols, or -1 for an empty bucket */
+    int bucket_count;                          /* Number of buckets - a power of two */
+    char *names;                             /* String arena - the null-terminated names */
+    size_t names_size;                               /* Number of bytes used in the arena */
+    size_t names_capacity;                          /* Number of bytes the arena can hold */
+} SymbolTable;
+
+/* ----------------------------------- Functions Prototypes ---------------------------------- */
+/**
+ * Function to initialize an empty symbol table.
+ *
+ * @param table A pointer to the symbol table to be initialized.
+ * @return Boolean TRUE if the table is successfully initialized; FALSE otherwise.
+ */
+Boolean init_symbol_table(SymbolTable *table);
+
+/**
+ * Function to insert a name into the symbol table with generic data.
+ * A name may contain only letters, digits and the characters '-', '_' and '.'.
+ *
+ * @param table A pointer to the symbol table in which the name will be inserted.
+ * @param name The name to be inserted into the table.
+ * @param data A pointer to the generic data to be stored with the name.
+ * @return ErrorCode - INVALID_CHAR if the name contains an invalid character, DUPLICATE if the
+ *         name already exists, MEMORY_ALLOCATION_ERROR or NO_ERROR if the process executed successfully.
+ */
+ErrorCode insert_symbol(SymbolTable *table, const char *name, void *data);
+
+/**
+ * Function to retrieve the index of a name in the symbol table, inserting the name without data
+ * if it does not exist. The characters of the name are not checked. The index of a symbol
+ * never changes, and the indexes are dense - from 0 to the number of symbols.
+ *
+ * @param table A pointer to the symbol table.
+ * @param name The name - does not have to be null-terminated.
+ * @param length The number of characters in the name.
+ * @return The index of the symbol with this name, or -1 if memory allocation failed.
+ */
+int intern_symbol(SymbolTable *table, const char *name, size_t length);
+
+/**
+ * Function to check that a name contains only the characters that are allowed in a symbol
+ * name: letters, digits and the characters '-', '_' and '.'.
+ *
+ * @param name The name to check.
+ * @return TRUE if all the characters of the name are valid, FALSE otherwise.
+ */
+Boolean valid_symbol_name(const char *name);
+
+/**
+ * Function to search for a symbol in the table.
+ * The name does not have to be null-terminated, so a span of a line can be searched as is.
+ * The returned pointer is valid until the next insertion to the table.
+ *
+ * @param table A pointer to the symbol table in which to search for the name.
+ * @param name The name to be searched in the table.
+ * @param length The number of characters in the name.
+ * @return Symbol* A pointer to the found symbol if the name exists; otherwise, NULL.
+ */
+Symbol* search_symbol(const SymbolTable *table, const char *name, size_t length);
+
+/**
+ * Function to retrieve the name of a symbol.
+ *
+ * @param table A pointer to the symbol table containing the symbol.
+ * @param symbol The symbol.
+ * @return The name of the symbol, stored in the string arena of the table.
+ */
+const char *symbol_name(const SymbolTable *table, const Symbol *symbol);
+
+/**
+ * Function to calculate the memory held by the symbol table itself - the symbol array,
+ * the buckets and the string arena. The data of the symbols is not included.
+ *
+ * @param table A pointer to the symbol table.
+ * @return The number of allocated bytes.
+ */
+size_t symbol_table_memory(const SymbolTable *table);
+
+/**
+ * Function to empty the symbol table, keeping its memory for reuse.
+ * Only the buckets of the symbols are cleared, so the cost depends on the number of symbols
+ * and not on the size of the table. The data of the symbols belongs to the caller.
+ *
+ * @param table A pointer to the symbol table to be emptied.
+ */
+void reset_symbol_table(SymbolTable *table);
+
+/**
+ * Function to free the symbol table.
+ * It frees the table's memory - the data of the symbols belongs to the caller.
+ *
+ * @param table A pointer to the symbol table to be freed.
+ */
+void free_symbol_table(SymbolTable *table);
+
+#endif /* SYMBOL_TABLE_H */
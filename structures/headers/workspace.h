@@ -0,0 +1,50 @@
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include "context.h"
+#include "macro_data.h"
+#include "line_buffer.h"
+#include "cmp_data.h"
+/* ---------------------------------------- Structures ----------------------------------------*/
+/*
+ * AsmWorkspace struct
+ * Holds everything the assembly of a single file needs: the context, the macro table, the
+ * preprocessed lines and the program's data. A workspace is created once and reset after
+ * every file, so a batch of files reuses the same arenas, tables and buffers instead of
+ * allocating and freeing them for every file.
+ */
+typedef struct AsmWorkspace {
+    AsmContext ctx;       /* The context of the current file */
+    MacroTrie macro_trie; /* The macros of the current file */
+    LineBuffer am_lines;  /* The preprocessed lines of the current file */
+    CmpData cmp_data;     /* The encoded program of the current file */
+    BatchSummary batch;   /* The totals of the files assembled so far - kept between files */
+} AsmWorkspace;
+
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Initializes an empty workspace.
+ *
+ * @param workspace Pointer to the workspace to be initialized.
+ * @param output The stream that error messages, warnings and summaries are printed to.
+ * @param memory_words The number of words of the machine memory.
+ * @return TRUE if the initialization was successful, FALSE if memory allocation failed.
+ */
+Boolean init_workspace(AsmWorkspace *workspace, FILE *output, int memory_words);
+
+/**
+ * Resets the workspace for the assembly of the next file. Only the memory that the last
+ * file used is cleared - the allocated memory and the totals of the batch are kept.
+ *
+ * @param workspace Pointer to the workspace to be reset.
+ */
+void reset_workspace(AsmWorkspace *workspace);
+
+/**
+ * Frees all the memory of the workspace.
+ *
+ * @param workspace Pointer to the workspace to be freed.
+ */
+void free_workspace(AsmWorkspace *workspace);
+
+#endif /* WORKSPACE_H */
@@ -0,0 +1,142 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include "../headers/arena.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Size of the first block of an arena */
+#define INITIAL_BLOCK_SIZE 4096
+/* Alignment of every allocation - the strictest alignment of the basic types */
+#define ARENA_ALIGNMENT sizeof(union { long l; double d; void *p; })
+/* Rounds a size up to a multiple of the alignment */
+#define ALIGN_UP(size) (((size) + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT)
+/* Size of the header of a block - the memory of the block starts right after it */
+#define BLOCK_HEADER ALIGN_UP(sizeof(ArenaBlock))
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static ArenaBlock *add_block(Arena *arena, ArenaBlock *last, size_t size);
+/* ---------------------------------------------------------------------------------------
+ *                                          Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Initializes an empty arena. No memory is allocated until the first allocation.
+ *
+ * @param arena Pointer to the arena to be initialized.
+ */
+void init_arena(Arena *arena) {
+    arena->head = NULL;
+    arena->current = NULL;
+    arena->block_size = INITIAL_BLOCK_SIZE;
+    arena->allocations = 0;
+}
+
+/**
+ * Allocates memory from the arena. The memory is suitably aligned for any type, and
+ * stays valid until the arena is reset or freed.
+ *
+ * @param arena Pointer to the arena.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the allocated memory, or NULL if memory allocation failed.
+ */
+void *arena_alloc(Arena *arena, size_t size) {
+    ArenaBlock *block = arena->current;  /* The block to allocate from */
+    ArenaBlock *last = NULL;             /* The last block that was tried */
+    void *memory;
+
+    size = ALIGN_UP(size ? size : 1);
+
+    /* Move on to the blocks kept from before the last reset, then allocate a new one */
+    while (block && block->used + size > block->size) {
+        last = block;
+        block = block->next;
+        if (block) block->used = 0;
+    }
+    if (!block && !(block = add_block(arena, last, size))) return NULL;
+
+    arena->current = block;
+    memory = (char *)block + BLOCK_HEADER + block->used;
+    block->used += size;
+    return memory;
+}
+
+/**
+ * Duplicates a portion of a string up to a specified size into the arena.
+ *
+ * @param arena Pointer to the arena.
+ * @param str The string to duplicate.
+ * @param size The maximum number of characters to duplicate from the string.
+ * @return The null-terminated copy, or NULL if memory allocation failed.
+ */
+char *arena_strndup(Arena *arena, const char *str, size_t size) {
+    size_t len = strlen(str); /* Strings length */
+    char *result;
+
+    /* Invalid strings length - will duplicate only a portion of it */
+    if (size < len) len = size;
+
+    result = (char *)arena_alloc(arena, len + 1);
+    if (!result) return NULL; /* Memory allocation failure */
+
+    result[len] = '\0'; /* Null-terminate the string */
+    return (char *)memcpy(result, str, len);
+}
+
+/**
+ * Makes all the memory of the arena available again. The blocks are kept, so an arena that
+ * is reset after every line allocates no memory once its blocks are large enough.
+ *
+ * @param arena Pointer to the arena to be reset.
+ */
+void reset_arena(Arena *arena) {
+    arena->current = arena->head;
+    if (arena->head) arena->head->used = 0;
+}
+
+/**
+ * Frees all the blocks of the arena, and leaves it empty.
+ *
+ * @param arena Pointer to the arena to be freed.
+ */
+void free_arena(Arena *arena) {
+    ArenaBlock *block = arena->head;
+    ArenaBlock *next;
+
+    while (block) {
+        next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->head = NULL;
+    arena->current = NULL;
+}
+
+/**
+ * Static function - allocates a new block that can hold at least the specified size, and
+ * links it after the last block. Every new block is twice the size of the previous one,
+ * so the number of blocks grows only logarithmically with the memory of the arena.
+ *
+ * @param arena Pointer to the arena.
+ * @param last The last block of the arena, or NULL if the arena has no blocks.
+ * @param size The number of bytes the block must hold.
+ * @return The new block, or NULL if memory allocation failed.
+ */
+static ArenaBlock *add_block(Arena *arena, ArenaBlock *last, size_t size) {
+    size_t block_size = arena->block_size;
+    ArenaBlock *block;
+
+    while (block_size < size) block_size *= 2;
+
+    block = (ArenaBlock *)malloc(BLOCK_HEADER + block_size);
+    if (!block) return NULL; /* Memory allocation failure */
+    arena->allocations++;
+
+    block->size = block_size;
+    block->used = 0;
+    block->next = NULL;
+    if (last) last->next = block;
+    else arena->head = block;
+    arena->block_size = block_size * 2;
+    return block;
+}
@@ -9,21 +9,26 @@
  *                                         Functions
  * --------------------------------------------------------------------------------------- */
 /**
- * Creates and initializes an empty AST node.
+ * Creates and initializes an empty AST node in the specified arena.
+ * The node, its line content and its operands live until the arena is reset.
+ *
+ * @param arena The arena that the node is allocated from.
  * @param file The name of the file where the node is created.
  * @param line The line number in the file where the node is created.
+ * @param line_content The content of the line, saved in the node's location.
  * @return A pointer to the newly created AST node, or a null pointer if memory allocation failed.
  */
-ASTNode *create_empty_ASTnode(const char *file, int line, char *line_content) {
+ASTNode *create_empty_ASTnode(Arena *arena, const char *file, int line, const char *line_content) {
     /* Allocate memory for ASTNode struct */
-    ASTNode *node = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode *node = (ASTNode*)arena_alloc(arena, sizeof(ASTNode));
     if (node) { /* If node is not null */
         node->lineType = LINE_EMPTY; /* Default line type */
         node->label[0] = '\0';  /* Empty label */
         memset(&(node->specific.instruction), 0, sizeof(Instruction));  /* Initialize instruction to 0 */
         node->location.file = file;
         node->location.line = line;
-        save_line_content(&node->location, line_content);
+        node->location.line_content = arena_strndup(arena, line_content, strlen(line_content));
+        if (!node->location.line_content) node = NULL; /* Memory allocation failure */
     }
     return node; /* Return the node or null if the memory allocation failed */
 }
@@ -32,13 +37,15 @@ ASTNode *create_empty_ASTnode(const char *file, int line, char *line_content) {
  * Sets the label of an AST node.
  *
  * @param node The AST node whose label is to be set.
- * @param label The label to be set.
+ * @param label The label to be set - does not have to be null-terminated.
+ * @param length The number of characters in the label.
  */
-void set_ast_label(ASTNode *node, const char *label) {
+void set_ast_label(ASTNode *node, const char *label, size_t length) {
     if (node) {
-        /* Copy label into node with a maximum length of 80 characters */
-        strncpy(node->label, label, MAX_LABEL_LENGTH-2);
-        node->label[MAX_LABEL_LENGTH-1] = '\0';  /* Null-terminate the label string */
+        /* Copy label into node with a maximum length of MAX_LABEL_LENGTH-2 characters */
+        if (length > MAX_LABEL_LENGTH-2) length = MAX_LABEL_LENGTH-2;
+        memcpy(node->label, label, length);
+        node->label[length] = '\0';  /* Null-terminate the label string */
     }
 }
 
@@ -101,16 +108,15 @@ InstructionOperand* get_operand(ASTNode *node, short num) {
  *
  * @param node The AST node to which the operand is to be added.
  * @param adr_mode The addressing mode of the operand.
- * @param value The value of the operand.
- * @param num The register number (if applicable) of the operand.
+ * @param value The value of the operand: the integer, the register number or the ID of the label.
  * @return TRUE if the operand was added successfully, FALSE otherwise.
  */
-Boolean add_instruct_operand(ASTNode *node, short adr_mode, const char *value, short num) {
+Boolean add_instruct_operand(ASTNode *node, short adr_mode, int value) {
     InstructionOperand* instruct_op = get_operand(node, node->specific.instruction.num_operands + 1);
     switch (adr_mode) {
         /* Direct address mode - label operand */
         case ADDR_MODE_DIRECT:
-            strcpy(instruct_op->value.char_val, value);
+            instruct_op->value.label_id = value;
             instruct_op->adr_mode = adr_mode;
             node->specific.instruction.num_operands++;
             break;
@@ -118,7 +124,7 @@ Boolean add_instruct_operand(ASTNode *node, short adr_mode, const char *value, s
         case ADDR_MODE_IMMEDIATE:          /* Immediate address mode */
         case ADDR_INDIRECT_REG: /* Register Indirect Addressing Mode */
         case ADDR_DIRECT_REG:     /* Register Direct Addressing Mode */
-            instruct_op->value.int_val = num;
+            instruct_op->value.int_val = value;
             instruct_op->adr_mode = adr_mode;
             node->specific.instruction.num_operands++;
             break;
@@ -133,13 +139,14 @@ Boolean add_instruct_operand(ASTNode *node, short adr_mode, const char *value, s
 /**
  * Private function - creates a new directive node.
  *
+ * @param arena The arena that the node is allocated from.
  * @param operand The operand for the directive node.
  * @return A pointer to the newly created directive node. Or a null pointer if the
  * memory allocation failed.
  */
-static DirNode* create_dir_node(char *operand) {
+static DirNode* create_dir_node(Arena *arena, char *operand) {
     /* Allocate memory for new DirNode */
-    DirNode *new_node = (DirNode *)malloc(sizeof(DirNode));
+    DirNode *new_node = (DirNode *)arena_alloc(arena, sizeof(DirNode));
     if (new_node) {
         new_node->operand = operand;
         new_node->next = NULL;
@@ -152,16 +159,17 @@ static DirNode* create_dir_node(char *operand) {
 /**
  * Adds an operand to a directive.
  *
+ * @param arena The arena that the operand node is allocated from.
  * @param directive The directive to which the operand is to be added.
  * @param operand The operand to be added.
  * @return TRUE if the operand was added successfully, FALSE otherwise.
  */
-Boolean add_directive_operand(Directive *directive, char *operand) {
+Boolean add_directive_operand(Arena *arena, Directive *directive, char *operand) {
     /* Create new empty DirNode */
-    DirNode *new_node = create_dir_node(operand);
+    DirNode *new_node;
 
     /* Return false if memory allocation failed */
-    if (!new_node) {
+    if (!operand || !(new_node = create_dir_node(arena, operand))) {
         return FALSE;
     }
 
@@ -179,39 +187,3 @@ Boolean add_directive_operand(Directive *directive, char *operand) {
     /* The process completed successfully */
     return TRUE;
 }
-
-/**
- * Private function - Frees the memory allocated for a list of directive nodes.
- *
- * @param node The head of the list of directive nodes to be freed.
- */
-static void free_dir_nodes(DirNode *node) {
-    DirNode *temp;
-    /* Iterate through list and free all the nodes */
-    while (node) {
-        temp = node;
-        node = (DirNode *) node->next;
-        free(temp->operand);
-        free(temp);
-    }
-}
-
-/**
- * Frees the memory allocated for an AST node.
- *
- * @param node The AST node to be freed.
- */
-void free_ast_node(ASTNode *node) {
-    if (!node) { /* Check for null pointer */
-        return;
-    }
-    /* If this is directive node - free the list of directive nodes first */
-    if (node->lineType == LINE_DIRECTIVE) {
-        free_dir_nodes(node->specific.directive.operands);
-    }
-    /* Free location content */
-    free_location(&node->location);
-
-    /* Free the node struct */
-    free(node);
-}
@@ -3,148 +3,265 @@
  * --------------------------------------------------------------------------------------- */
 #include "../../structures/headers/cmp_data.h"
 #include "../../utils/headers/utils.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Number of fixups the table holds after its first growth */
+#define FIXUP_INITIAL_CAPACITY 64
+/* Number of words every section of the memory image holds before its first growth */
+#define IMAGE_INITIAL_WORDS 64
+/* Number of bytes the entry and extern lines hold after their first growth */
+#define RECORDS_INITIAL_CAPACITY 256
+/* Maximal length of an entry or extern line: label, space, address, new line and '\0' */
+#define RECORD_MAX_LENGTH (MAX_LABEL_LENGTH + 16)
 /* ---------------------------------------------------------------------------------------
  *                                 Static Functions Prototypes
  * --------------------------------------------------------------------------------------- */
-static void close_files(CmpData* cmp_data);
-static void free_file_names(CmpData* cmp_data);
-static void delete_files(CmpData* cmp_data);
-static void free_unresolved_list(UnresolvedLineList *head);
+static Boolean reserve_word(Word **words, int *size, int pos);
+static void free_image(MemoryImage *image);
+static void free_records(RecordBuffer *records);
+static Boolean grow_fixups(FixupTable *fixups);
+static void free_fixups(FixupTable *fixups);
 /* ---------------------------------------------------------------------------------------
  *                                         Functions
  * --------------------------------------------------------------------------------------- */
 /**
  * Function to initialize the ProgramData structure.
- * Initializes the sets to be empty sets and sets the corresponding pointers
- * of the sets to the setMappings.
+ * Allocates the memory image and the label table. The structure can be reused for several
+ * files with `reset_cmp_data`.
+ *
  * @param data Pointer to the ProgramData to be initialized
+ * @param memory_words The number of words of the machine memory, including the IC_START offset.
+ * @return NO_ERROR if the initialization succeeded, MEMORY_ALLOCATION_ERROR otherwise.
  */
-ErrorCode init_cmp_data(CmpData *data, const char *file_name) {
-    char *extern_file = NULL;
-    char *entry_file = NULL;
-    int i, j;
-
-    /* Create and open a file for writing */
-    create_new_file_name(file_name, &entry_file, ".ent");
-    create_new_file_name(file_name, &extern_file, ".ext");
-
-    /* Memory allocation failure */
-    if (entry_file == NULL || extern_file == NULL) return MEMORY_ALLOCATION_ERROR;
-
-    /* Open in write mode */
-    data->entry_file.file = fopen(entry_file, "w");
-    data->extern_file.file = fopen(extern_file, "w");
-
-    /* Failed to open */
-    if (data->extern_file.file == NULL || data->entry_file.file == NULL) {
-        free(extern_file);
-        free(entry_file);
-        return PROGRAM_FILE_ERROR;
+ErrorCode init_cmp_data(CmpData *data, int memory_words) {
+    /* No entry and extern lines yet - allocated on the first line */
+    data->entries.text = data->externals.text = NULL;
+    data->entries.size = data->externals.size = 0;
+    data->entries.capacity = data->externals.capacity = 0;
+
+    /* Reset the memory image counters and writing pointers */
+    data->image.code = NULL;
+    data->image.code_size = 0;
+    data->image.code_count = 0;
+    data->image.code_pos = 0;
+    data->image.data = NULL;
+    data->image.data_size = 0;
+    data->image.data_count = 0;
+    data->image.data_pos = 0;
+    data->image.capacity = memory_words - IC_START;
+
+    data->image.full = FALSE; /* Set capacity error to false */
+
+    /* Initialize the fixup table to an empty table - allocated on the first fixup */
+    data->fixups.items = NULL;
+    data->fixups.count = 0;
+    data->fixups.capacity = 0;
+
+    /* Make room for the first word of every section */
+    if (reserve_word(&data->image.code, &data->image.code_size, 0) == FALSE ||
+        reserve_word(&data->image.data, &data->image.data_size, 0) == FALSE) {
+        free_image(&data->image);
+        return MEMORY_ALLOCATION_ERROR;
     }
 
-    /* Save the file name */
-    data->entry_file.file_name = entry_file;
-    data->extern_file.file_name = extern_file;
+    /* return the status of the label table initialization */
+    if (init_label_table(&data->label_table) == FALSE) {
+        free_image(&data->image);
+        return MEMORY_ALLOCATION_ERROR;
+    }
+    return NO_ERROR;
+}
 
-    /* Default state - delete the files. Will be changed only if text will be written on them */
-    data->entry_file.delete = TRUE;
-    data->extern_file.delete = TRUE;
+/**
+ * Sets the number of words of the machine memory, for the next file. The sections of the memory
+ * image grow with use, so no memory is allocated.
+ *
+ * @param data Pointer to the ProgramData - empty, after initialization or reset.
+ * @param memory_words The number of words of the machine memory, including the IC_START offset.
+ */
+void set_memory_words(CmpData *data, int memory_words) {
+    data->image.capacity = memory_words - IC_START;
+}
 
-    /* Reset image memory */
-    for (i = 0; i < MEMORY_CAPACITY; i++) {
-        for (j = 0; j < NUM_OF_BYTES; j++) {
-            data->image.lines[i][j] = 0;
-        }
+/**
+ * Makes room in both sections of the memory image for all the words the program may take, so
+ * the sections are not moved while the program is written. A section never takes more than
+ * `capacity` words, and its writing position is at most the one after them.
+ *
+ * @param image Pointer to the memory image.
+ * @return TRUE if the sections hold all the words, FALSE if memory allocation failed.
+ */
+Boolean reserve_image(MemoryImage *image) {
+    if (reserve_word(&image->code, &image->code_size, image->capacity) == FALSE ||
+        reserve_word(&image->data, &image->data_size, image->capacity) == FALSE) {
+        return FALSE;
     }
+    return TRUE;
+}
+
+/**
+ * Empties the memory image, the fixup table, the label table and the entry and extern
+ * lines, keeping their memory for the next file. Only the words that were written are
+ * cleared, so the cost depends on the size of the assembled program and not on the size
+ * of the memory.
+ *
+ * @param data Pointer to the ProgramData to be reset.
+ */
+void reset_cmp_data(CmpData *data) {
+    MemoryImage *image = &data->image;
+    int words; /* Number of words that may have been written in a section */
+
+    /* The word at the writing position may hold a partly encoded word */
+    words = (image->code_count < image->code_size) ? image->code_count + 1 : image->code_size;
+    memset(image->code, 0, (size_t)words * sizeof(Word));
+    words = (image->data_count < image->data_size) ? image->data_count + 1 : image->data_size;
+    memset(image->data, 0, (size_t)words * sizeof(Word));
 
     /* Reset the memory image counters and writing pointers */
-    data->image.code_count = 0;
-    data->image.code_pos = 0;
-    data->image.data_count = 0;
-    data->image.data_pos = MEMORY_CAPACITY - 1;
+    image->code_count = 0;
+    image->code_pos = 0;
+    image->data_count = 0;
+    image->data_pos = 0;
+    image->full = FALSE; /* Set capacity error to false */
+
+    data->fixups.count = 0;
+    reset_label_table(&data->label_table);
+
+    data->entries.size = data->externals.size = 0;
+    if (data->entries.text) data->entries.text[0] = '\0';
+    if (data->externals.text) data->externals.text[0] = '\0';
+}
 
-    data->image.full = FALSE; /* Set capacity error to false */
+/**
+ * Static function - makes sure a section of the memory image holds the word at the specified
+ * position. The section grows by doubling, and the new words are zeroed.
+ *
+ * @param words Pointer to the words of the section.
+ * @param size Pointer to the number of words the section holds.
+ * @param pos The position of the word.
+ * @return TRUE if the section holds the word, FALSE if memory allocation failed.
+ */
+static Boolean reserve_word(Word **words, int *size, int pos) {
+    int new_size = *size ? *size : IMAGE_INITIAL_WORDS; /* The new number of words */
+    Word *new_words;
+
+    if (pos < *size) return TRUE;
 
-    data->line_list = NULL; /* Initialize unresolved line list line_list to NULL*/
+    while (new_size <= pos) new_size *= 2;
+    if (!(new_words = (Word *)realloc(*words, (size_t)new_size * sizeof(Word)))) return FALSE;
 
-    /* return the status of trie initialization */
-    return (init_label_trie(&data->label_table) == TRUE) ? NO_ERROR : MEMORY_ALLOCATION_ERROR;
+    memset(new_words + *size, 0, (size_t)(new_size - *size) * sizeof(Word));
+    *words = new_words;
+    *size = new_size;
+    return TRUE;
+}
+
+/**
+ * Static function - frees the sections of the memory image.
+ *
+ * @param image The memory image to be freed.
+ */
+static void free_image(MemoryImage *image) {
+    free(image->code);
+    free(image->data);
+    image->code = image->data = NULL;
+    image->code_size = image->data_size = 0;
 }
 
 /**
- * Adds a line to the unresolved line list for the second phase.
- * Saves the line number in thr unresolved line list.
+ * Adds a fixup to the end of the fixup table, to be resolved after the first phase.
  *
- * @param data: The program's data structure containing the unresolved line list.
- * @param line: The line number to be added to the unresolved line list.
- * @return TRUE if the line was added successfully, FALSE if memory allocation failed.
+ * @param data The program's data structure containing the fixup table.
+ * @param type The kind of the reference.
+ * @param address Index of the word in the code image (used only for operands).
+ * @param label_id The ID of the referenced label in the label table.
+ * @param location The location of the reference. The line content is not saved.
+ * @return TRUE if the fixup was added successfully, FALSE if memory allocation failed.
  */
-Boolean add_unresolved_line(CmpData *data, int line) {
-    /* Allocate memory for list's node */
-    UnresolvedLineList *newNode = (UnresolvedLineList *)malloc(sizeof(UnresolvedLineList));
-    if (!newNode) {
+Boolean add_fixup(CmpData *data, FixupType type, int address, int label_id, Location location) {
+    Fixup *fixup; /* The added fixup */
+
+    /* Make room for the fixup */
+    if (data->fixups.count == data->fixups.capacity && grow_fixups(&data->fixups) == FALSE) {
         return FALSE; /* Memory allocation failed */
     }
 
-    newNode->line = line;
-    newNode->next = NULL;
-
-    /* If list is empty, new node is the head */
-    if (!data->line_list) {
-        data->line_list = newNode;
-    } else {
-        /* Put the line in the accurate position - the end of the list */
-        UnresolvedLineList *temp = data->line_list;
-        while (temp->next) {
-            if (temp->line == line) {
-                free(newNode);
-                return TRUE; /* Line already exists */
-            }
-            temp = temp->next;
-        }
-        if (temp->line == line) {
-            free(newNode);
-            return TRUE; /* Check the last node */
-        }
-        temp->next = newNode; /* Add new node at the end */
+    fixup = &data->fixups.items[data->fixups.count++];
+    fixup->type = type;
+    fixup->address = address;
+    fixup->label_id = label_id;
+    fixup->location = location;
+    fixup->location.line_content = NULL; /* The content belongs to the parsed line */
+    return TRUE;
+}
+
+/**
+ * Appends a line of a label and its address to the specified entry or extern lines.
+ * The label is left-justified in 31 characters, and the address is at least 4 digits.
+ * The lines grow by doubling, so appending a line does not depend on the lines before it.
+ *
+ * @param records The lines to append to.
+ * @param label The label to be written.
+ * @param address The address associated with the label.
+ * @return TRUE if the line was added, FALSE if memory allocation failed.
+ */
+Boolean add_label_record(RecordBuffer *records, const char *label, int address) {
+    size_t new_capacity;    /* The new number of bytes of the lines */
+    char *new_text;
+
+    /* Make room for the longest possible line */
+    if (records->size + RECORD_MAX_LENGTH > records->capacity) {
+        new_capacity = records->capacity ? records->capacity : RECORDS_INITIAL_CAPACITY;
+        while (records->size + RECORD_MAX_LENGTH > new_capacity) new_capacity *= 2;
+        if (!(new_text = (char *)realloc(records->text, new_capacity))) return FALSE;
+        records->text = new_text;
+        records->capacity = new_capacity;
     }
-    /* Process completed successfully */
+
+    records->size += (size_t)sprintf(records->text + records->size, "%-31s %04d\n", label, address);
     return TRUE;
 }
 
 /**
- * Retrieves and removes the next unresolved line from the list.
- * Returns the number (integer) of the unresolved line.
+ * Retrieves the absolute address of a label. The code section starts at IC_START and the data
+ * section right after the last instruction.
  *
- * @param data: The program's data structure containing the unresolved line list.
- * @return The line number of the next unresolved line, or -1 if the list is empty.
+ * @param data The program's data structure containing the label table and the memory image.
+ * @param label_id The ID of the label in the label table.
+ * @return The address of the label, or 0 if the label is external.
  */
-int get_unresolved_line(CmpData *data) {
-    UnresolvedLineList *temp = NULL; /* Variable to hole the head of the line's list */
-    int line;        /* Variable to hold the number of the unresolved line to return */
+int resolve_label_address(const CmpData *data, int label_id) {
+    return label_address(&data->label_table.labels[label_id], IC_START, IC_START + data->image.code_count);
+}
 
-    if (!data->line_list) {
-        return -1; /* List is empty */
-    }
+/**
+ * Static function - doubles the capacity of the fixup table.
+ *
+ * @param fixups The fixup table to grow.
+ * @return TRUE if the table was grown successfully, FALSE if memory allocation failed.
+ */
+static Boolean grow_fixups(FixupTable *fixups) {
+    int new_capacity = fixups->capacity ? fixups->capacity * 2 : FIXUP_INITIAL_CAPACITY;
+    Fixup *new_items = (Fixup *)realloc(fixups->items, new_capacity * sizeof(Fixup));
 
-    temp = data->line_list;
-    line = temp->line;
+    if (!new_items) return FALSE; /* The old table is kept as is */
 
-    /* Remove current line node - move the head to the next line node */
-    data->line_list = data->line_list->next;
-    free(temp); /* Free the line's node */
-    return line; /* return the freed line number */
+    fixups->items = new_items;
+    fixups->capacity = new_capacity;
+    return TRUE;
 }
 
 /**
  * Private function - checks if the memory image is full.
  * If so - sets appropriate error.
+ * @param ctx The context of the assembly process.
  * @param memory_image
  */
-static void check_capacity(MemoryImage *memory_image){
+static void check_capacity(AsmContext *ctx, MemoryImage *memory_image){
     /* Check if the program is run out of memory */
-    if (memory_image->code_count + memory_image->data_count > MEMORY_CAPACITY) {
-        set_general_error(RAM_MEMORY_FULL);
+    if (memory_image->code_count + memory_image->data_count > memory_image->capacity) {
+        set_general_error(ctx, RAM_MEMORY_FULL);
         memory_image->full = TRUE;
     }
 }
@@ -154,32 +271,48 @@ static void check_capacity(MemoryImage *memory_image){
  * Increments the code memory image code_count and positions the writer pointer in the correct position.
  * The encoded instruction are written from the lowest index to the highest.
  *
+ * @param ctx The context of the assembly process.
  * @param memory_image A pointer to the MemoryImage structure containing the code counter and the write
  *                     pointer is to be updated.
  */
-void updt_code_counter(MemoryImage *memory_image) {
+void updt_code_counter(AsmContext *ctx, MemoryImage *memory_image) {
     /* Update only if there is remaining memory */
     if (memory_image->full == FALSE){
         memory_image->code_count++;
         memory_image->code_pos = memory_image->code_count;
-        check_capacity(memory_image);
+        check_capacity(ctx, memory_image);
+
+        /* Make room for the next instruction word */
+        if (memory_image->full == FALSE &&
+            reserve_word(&memory_image->code, &memory_image->code_size, memory_image->code_pos) == FALSE) {
+            set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+            memory_image->full = TRUE;
+        }
     }
 }
 
 /**
  * Updates the data memory image counter.
  * Increments the memory image data_count and positions the writer pointer in the correct position.
- * The encoded directives are written from the highest index to the lowest.
+ * The encoded directives are written from the lowest index to the highest.
  *
+ * @param ctx The context of the assembly process.
  * @param memory_image A pointer to the MemoryImage structure containing the code counter and the write
  *                     pointer is to be updated.
  */
-void updt_data_counter(MemoryImage *memory_image) {
+void updt_data_counter(AsmContext *ctx, MemoryImage *memory_image) {
     /* Update only if there is remaining memory */
     if (memory_image->full == FALSE) {
         memory_image->data_count++;
-        memory_image->data_pos--;
-        check_capacity(memory_image);
+        memory_image->data_pos = memory_image->data_count;
+        check_capacity(ctx, memory_image);
+
+        /* Make room for the next directive word */
+        if (memory_image->full == FALSE &&
+            reserve_word(&memory_image->data, &memory_image->data_size, memory_image->data_pos) == FALSE) {
+            set_general_error(ctx, MEMORY_ALLOCATION_ERROR);
+            memory_image->full = TRUE;
+        }
     }
 }
 
@@ -198,107 +331,39 @@ void seek_back(MemoryImage *memory_image){
 }
 
 /**
- * Frees the CmpData structure, containing all the programs data, including closing and
- * optionally deleting files.
+ * Frees the CmpData structure, containing all the programs data.
  *
  * @param cmp_data The programs data to be freed.
- * @param delete If TRUE, delete the files associated with the CmpData structure.
  */
-void free_cmp_data(CmpData *cmp_data, Boolean delete) {
-    close_files(cmp_data); /* Close the files */
-    if (delete == TRUE) {
-        /* Delete files if specified so */
-        cmp_data->extern_file.delete = TRUE;
-        cmp_data->entry_file.delete = TRUE;
-    }
-    /* Delete the necessary files */
-    delete_files(cmp_data);
-
-    /* Reset file pointers to null */
-    cmp_data->entry_file.file = NULL;
-    cmp_data->extern_file.file = NULL;
-
-    /* Free the memory allocated to the file names strings */
-    free_file_names(cmp_data);
-
-    /* Free the unresolved lines list */
-    free_unresolved_list(cmp_data->line_list);
+void free_cmp_data(CmpData *cmp_data) {
+    /* Free the fixup table, the memory image, the label table and the entry and extern lines */
+    free_fixups(&cmp_data->fixups);
+    free_image(&cmp_data->image);
+    free_label_table(&cmp_data->label_table);
+    free_records(&cmp_data->entries);
+    free_records(&cmp_data->externals);
 }
 
 /**
- * Static function - frees the entire linked list of unresolved lines.
+ * Static function - frees the fixup table.
  *
- * @param head The head of the unresolved line list to be freed.
+ * @param fixups The fixup table to be freed.
  */
-static void free_unresolved_list(UnresolvedLineList *head) {
-    /* Variables to iterate through list */
-    UnresolvedLineList *current = head;
-    UnresolvedLineList *next;
-
-    /* Iterate through list and free all it's nodes */
-    while (current != NULL) {
-        next = current->next;
-        free(current);
-        current = next;
-    }
+static void free_fixups(FixupTable *fixups) {
+    free(fixups->items);
+    fixups->items = NULL;
+    fixups->count = 0;
+    fixups->capacity = 0;
 }
 
 /**
- * Static function - closes the files associated with the CmpData structure.
+ * Static function - frees the entry or extern lines.
  *
- * @param cmp_data The program's data structure containing the files to be closed.
+ * @param records The lines to be freed.
  */
-static void close_files(CmpData* cmp_data) {
-    /* If file exists - close file */
-    if (cmp_data->entry_file.file) {
-        if (fclose(cmp_data->entry_file.file) != 0) {
-            set_general_error(FAILED_CLOSE_FILE);
-        }
-    }
-
-    /* If file exists - close file */
-    if (cmp_data->extern_file.file) {
-        if (fclose(cmp_data->extern_file.file) != 0) {
-            set_general_error(FAILED_CLOSE_FILE);
-        }
-    }
-}
-
-/**
- * Static function - frees the memory allocated for the file names in the CmpData structure.
- *
- * @param cmp_data The program's data structure containing the file names to be freed.
- */
-static void free_file_names(CmpData* cmp_data){
-    /* Free the files names */
-    free(cmp_data->entry_file.file_name);
-    free(cmp_data->extern_file.file_name);
-
-    /* Reset the variable to null */
-    cmp_data->entry_file.file_name = NULL;
-    cmp_data->extern_file.file_name = NULL;
-}
-
-/**
- * Static function - deletes the files associated with the CmpData structure.
- *
- * @param cmp_data The program's data structure containing the files to be deleted.
- */
-static void delete_files(CmpData* cmp_data) {
-    /* Delete file */
-    if (cmp_data->entry_file.delete == TRUE){
-    if (cmp_data->entry_file.file_name != NULL && remove(cmp_data->entry_file.file_name) != 0) {
-        /* Failed to delete */
-        set_general_error(FAILED_DELETE_FILE);
-        printf("The file name: %s\n", cmp_data->entry_file.file_name);
-    }
-}
-    /* Delete file */
-    if (cmp_data->extern_file.delete == TRUE) {
-    if (cmp_data->extern_file.file_name != NULL && remove(cmp_data->extern_file.file_name) != 0) {
-        /* Failed to delete */
-        set_general_error(FAILED_DELETE_FILE);
-        printf("The file name: %s\n", cmp_data->extern_file.file_name);
-    }
-}
+static void free_records(RecordBuffer *records) {
+    free(records->text);
+    records->text = NULL;
+    records->size = 0;
+    records->capacity = 0;
 }
@@ -0,0 +1,42 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include "../headers/context.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Initializes the context of an assembly process to an error free state.
+ *
+ * @param ctx Pointer to the context to be initialized.
+ * @param output The stream that error messages, warnings and summaries are printed to.
+ */
+void init_context(AsmContext *ctx, FILE *output) {
+    ctx->output = output;
+    clear_error(ctx);
+    clear_status(ctx);
+    init_arena(&ctx->line_arena);
+    reset_stats(&ctx->stats);
+}
+
+/**
+ * Resets the context to an error free state for the assembly of the next file.
+ * The blocks of the line arena are kept.
+ *
+ * @param ctx Pointer to the context to be reset.
+ */
+void reset_context(AsmContext *ctx) {
+    clear_error(ctx);
+    clear_status(ctx);
+    reset_arena(&ctx->line_arena);
+    reset_stats(&ctx->stats);
+}
+
+/**
+ * Frees the memory of an assembly process - the memory arena of the context.
+ *
+ * @param ctx Pointer to the context to be freed.
+ */
+void free_context(AsmContext *ctx) {
+    free_arena(&ctx->line_arena);
+}
@@ -4,11 +4,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include "../headers/errors.h"
+#include "../headers/context.h"
 #include "../../utils/headers/utils.h"
-/* --------------------------- Initialize the static variables --------------------------- */
-static Error error = {NO_ERROR, "No error"};
-static ProgramStatus program_status = {ERROR_FREE_FILE, 0,0, };
 
 /* ---------------------------------------------------------------------------------------
  *                                          Functions
@@ -29,8 +26,11 @@ static const char* get_error_message(ErrorCode code) {
         case PROGRAM_FILE_ERROR:         return "Failed to open program's extern/entry files";
         case FAILED_OPEN_FILE:           return "Cannot open file";
         case FAILED_CREATE_FILE:         return "Cannot create file";
+        case FAILED_WRITE_FILE:          return "Failed to write file";
         case FAILED_CLOSE_FILE:          return "Failed to close file";
         case FAILED_DELETE_FILE:         return "Failed to delete file";
+        case INVALID_OPTION:             return "Invalid command line option; usage: [-j N] [--emit-am] [--memory-words N] [--stats] [--cache DIR] [--manifest FILE] [--dir PATH] [--pipeline] [--encode-threads N] <file names> | --serve [socket | -]";
+        case SERVER_SOCKET_ERROR:        return "Cannot start the server - the socket cannot be created or is in use";
         case LINE_TOO_LONG:              return "Line is too long; max length is " TOSTRING(MAX_LINE_PRINTABLE) " characters";
         case MACR_RESERVED_WORD:         return "Invalid macro name - name is a reserved word";
         case EXTRA_TXT_MACR:             return "Extra text after macro definition";
@@ -48,6 +48,7 @@ static const char* get_error_message(ErrorCode code) {
         case LABEL_MACR_COLLIDES:        return "Label and macro name collision";
         case EXT_ENT_COLLIDES:           return "Label extern and entry collision. Cannot be set to both.";
         case UNRECOGNIZED_LABEL:         return "Unrecognized label";
+        case LABEL_ADDRESS_OUT_OF_RANGE: return "Label address is out of range - does not fit the address field of the operand";
         case INVALID_LABEL_LENGTH:       return "Invalid label length - cannot exceed "TOSTRING(MAX_LABEL_PRINTABLE)" characters";
         case LABEL_DUPLICATE:            return "Invalid label name - duplicate label names found";
         case NOT_INTEGER:                return "Not an integer";
@@ -65,90 +66,104 @@ static const char* get_error_message(ErrorCode code) {
  /**
   * Prints the details of the specified location.
   *
+  * @param output The stream to print to.
   * @param location The location to print.
   */
-static void print_location(Location* location){
+static void print_location(FILE *output, Location* location){
     if (location->line > 0) {
-        printf("\nFile:    %s | Line: %d", location->file, location->line);
+        fprintf(output, "\nFile:    %s | Line: %d", location->file, location->line);
         if (location->line_content) /* Print line content if exists */
-            printf("\n         %s", location->line_content);
+            fprintf(output, "\n         %s", location->line_content);
     }
 }
 
 /**
  * Prints the current error message and location, if an error is set.
  * Activates whenever an error is set.
+ *
+ * @param ctx The context of the assembly process.
  */
-static void print_error() {
+static void print_error(AsmContext *ctx) {
     /* Print only if error is set */
-    if (error.code != NO_ERROR) {
-        printf("ERROR:   %s", error.message);
+    if (ctx->error.code != NO_ERROR) {
+        fprintf(ctx->output, "ERROR:   %s", ctx->error.message);
         /* If there is specified location - print it too */
-        print_location(&error.location);
-        printf("\n\n");
+        print_location(ctx->output, &ctx->error.location);
+        fprintf(ctx->output, "\n\n");
     }
 }
 
 /**
  * Private function - sets the program's status to the specified status.
  *
+ * @param ctx The context of the assembly process.
  * @param status The program's status.
  */
-static void set_program_status(Status status) {
-    program_status.status = status;
+static void set_program_status(AsmContext *ctx, Status status) {
+    ctx->program_status.status = status;
 }
 
 /**
  * Resets the program's status to 'error free file' status.
+ *
+ * @param ctx The context of the assembly process.
  */
-void clear_status() {
-    program_status.status = ERROR_FREE_FILE;
-    program_status.error_counter = 0;
-    program_status.warning_counter = 0;
+void clear_status(AsmContext *ctx) {
+    ctx->program_status.status = ERROR_FREE_FILE;
+    ctx->program_status.error_counter = 0;
+    ctx->program_status.warning_counter = 0;
+    ctx->program_status.file_error = FALSE;
 }
 
 /**
  * Returns the current program's status.
  *
+ * @param ctx The context of the assembly process.
  * @return The current program's status.
  */
-Status get_status() {
-    return program_status.status;
+Status get_status(const AsmContext *ctx) {
+    return ctx->program_status.status;
 }
 
 /**
- * Sets the current error with the specified error code and location.
+ * Sets the current error of the specified context with the specified error code and location.
  *
+ * @param ctx The context of the assembly process.
  * @param code The error code to set.
  * @param location The location in the source file where the error occurred.
  */
-void set_error(ErrorCode code, Location location) {
+void set_error(AsmContext *ctx, ErrorCode code, Location location) {
     /* Set the error attributes according to the inputted code */
-    error.code = code;
-    error.message = get_error_message(code);
-    error.location = location;
+    ctx->error.code = code;
+    ctx->error.message = get_error_message(code);
+    ctx->error.location = location;
 
     /* If an actual error was set */
     if (code != NO_ERROR) {
-        print_error(); /* Print the error message */
-        program_status.error_counter++;
+        print_error(ctx); /* Print the error message */
+        ctx->program_status.error_counter++;
+        if (code == PROGRAM_FILE_ERROR || code == FAILED_OPEN_FILE || code == FAILED_CREATE_FILE ||
+            code == FAILED_WRITE_FILE || code == FAILED_CLOSE_FILE || code == FAILED_DELETE_FILE) {
+            ctx->program_status.file_error = TRUE;
+        }
 
         /* Set the program's status accordingly */
         if (code == MEMORY_ALLOCATION_ERROR)
-            set_program_status(FATAL_ERROR);
+            set_program_status(ctx, FATAL_ERROR);
         else
-            set_program_status(ERROR_IN_FILE);
+            set_program_status(ctx, ERROR_IN_FILE);
     }
 }
 
 /**
  * Sets a general error with the specified error code but without a specific location.
  *
+ * @param ctx The context of the assembly process.
  * @param code The error code to set.
  */
-void set_general_error(ErrorCode code) {
+void set_general_error(AsmContext *ctx, ErrorCode code) {
     Location default_location = {NULL, 0};
-    set_error(code, default_location);
+    set_error(ctx, code, default_location);
 }
 
 /**
@@ -157,26 +172,28 @@ void set_general_error(ErrorCode code) {
  *
  * @param location the location struct to save the line into.
  * @param content the string to save as a content in the location struct.
+ * @return TRUE if the content was saved, FALSE if memory allocation failed.
  */
-void save_line_content(Location *location, char *content){
+Boolean save_line_content(Location *location, const char *content){
     char *copy_content = NULL;
-    if (!location) return; /* Null pointer */
+    if (!location) return TRUE; /* Null pointer */
 
     /* Copy the content */
     copy_content = my_strndup(content, strlen(content));
 
-    if (!copy_content) {
-        set_general_error(MEMORY_ALLOCATION_ERROR);
-    } else {
-        location->line_content = copy_content;
-    }
+    if (!copy_content) return FALSE; /* Memory allocation failure */
+
+    location->line_content = copy_content;
+    return TRUE;
 }
 
 /**
  * Clears the current error, resetting it to NO_ERROR with a default location.
+ *
+ * @param ctx The context of the assembly process.
  */
-void clear_error() {
-    set_general_error(NO_ERROR);
+void clear_error(AsmContext *ctx) {
+    set_general_error(ctx, NO_ERROR);
 }
 
 /**
@@ -195,47 +212,51 @@ void free_location(Location *location){
 /**
  * Returns the current error image.
  *
+ * @param ctx The context of the assembly process.
  * @return The current error image.
  */
-ErrorCode get_error() {
-    return error.code;
+ErrorCode get_error(const AsmContext *ctx) {
+    return ctx->error.code;
 }
 
 /**
  * Prints a warning message that corresponding to the specified warning code.
  *
+ * @param ctx The context of the assembly process.
  * @param code The warning code, indicating the cause of the warning.
  * @param location The location of the line that triggered the warning.
  */
-void print_warning(WarningCode code, Location *location) {
-    printf("WARNING: ");
+void print_warning(AsmContext *ctx, WarningCode code, Location *location) {
+    fprintf(ctx->output, "WARNING: ");
     switch (code) { /* Print the corresponding warning */
         case LABEL_ENTRY:
-            printf("Label definition before entry command is ignored");
+            fprintf(ctx->output, "Label definition before entry command is ignored");
             break;
         case LABEL_EXTERN:
-            printf("Label definition before extern command is ignored");
+            fprintf(ctx->output, "Label definition before extern command is ignored");
             break;
         case ENTRY_DUPLICATE:
-            printf("Label is already declared as entry; This declaration will be ignored");
+            fprintf(ctx->output, "Label is already declared as entry; This declaration will be ignored");
             break;
         case EXTERN_DUPLICATE:
-            printf("Label is already declared as extern; This declaration will be ignored");
+            fprintf(ctx->output, "Label is already declared as extern; This declaration will be ignored");
             break;
     }
     /* Print location */
-    print_location(location);
-    printf("\n\n");
+    print_location(ctx->output, location);
+    fprintf(ctx->output, "\n\n");
 
     /* Update counter */
-    program_status.warning_counter++;
+    ctx->program_status.warning_counter++;
 }
 
 /**
  * Static helper function - prints line for aesthetic purposes.
+ *
+ * @param output The stream to print to.
  */
-static void print_line(){
-    printf("-------------------------------------------------\n");
+static void print_line(FILE *output){
+    fprintf(output, "-------------------------------------------------\n");
 }
 
 /**
@@ -243,25 +264,85 @@ static void print_line(){
  * Indicates whether the file processing completed successfully, and the number
  * of errors and warnings that occurred during the process.
  *
+ * @param ctx The context of the assembly process.
  * @param file The name of the file that was processed.
  */
-void print_error_summery(char *file) {
-    print_line(); /* Print line separating this message from previous messages */
-    printf("| ERROR SUMMARY ('%s')\n", file);
-    printf("|    Errors   : %d\n", program_status.error_counter);
-    printf("|    Warnings : %d\n", program_status.warning_counter);
-    print_line();
+void print_error_summery(AsmContext *ctx, const char *file) {
+    FILE *output = ctx->output;
+
+    print_line(output); /* Print line separating this message from previous messages */
+    fprintf(output, "| ERROR SUMMARY ('%s')\n", file);
+    fprintf(output, "|    Errors   : %d\n", ctx->program_status.error_counter);
+    fprintf(output, "|    Warnings : %d\n", ctx->program_status.warning_counter);
+    print_line(output);
 
     /* Print the program's status */
-    if (program_status.status == ERROR_IN_FILE) {
-        printf("|    Could not process file\n");
-    } else if (program_status.status == FATAL_ERROR) {
-        printf("|    Fatal error occurred during processing,\n");
-        printf("|    terminating the program...\n");
+    if (ctx->program_status.status == ERROR_IN_FILE) {
+        fprintf(output, "|    Could not process file\n");
+    } else if (ctx->program_status.status == FATAL_ERROR) {
+        fprintf(output, "|    Fatal error occurred during processing,\n");
+        fprintf(output, "|    terminating the program...\n");
     } else {
-        printf("|    File processing completed successfully\n");
+        fprintf(output, "|    File processing completed successfully\n");
     }
 
-    print_line();
+    print_line(output);
+}
+
+
+/**
+ * Resets the totals of a batch of files to zero.
+ *
+ * @param batch The totals of the batch.
+ */
+void clear_batch_summary(BatchSummary *batch) {
+    batch->files = 0;
+    batch->succeeded = 0;
+    batch->failed = 0;
+    batch->errors = 0;
+    batch->warnings = 0;
+}
+
+/**
+ * Adds the status and counters of an assembled file to the totals of its batch.
+ *
+ * @param batch The totals of the batch.
+ * @param program_status The status of the file at the end of its process.
+ */
+void add_to_batch_summary(BatchSummary *batch, const ProgramStatus *program_status) {
+    batch->files++;
+    if (program_status->status == ERROR_FREE_FILE) batch->succeeded++;
+    else batch->failed++;
+    batch->errors += program_status->error_counter;
+    batch->warnings += program_status->warning_counter;
+}
+
+/**
+ * Adds the totals of a part of a batch to the totals of the whole batch.
+ *
+ * @param batch The totals of the whole batch.
+ * @param part The totals of the part.
+ */
+void merge_batch_summary(BatchSummary *batch, const BatchSummary *part) {
+    batch->files += part->files;
+    batch->succeeded += part->succeeded;
+    batch->failed += part->failed;
+    batch->errors += part->errors;
+    batch->warnings += part->warnings;
 }
 
+/**
+ * Prints the totals of a batch of files, in the frame of the summary of a single file.
+ *
+ * @param output The stream to print to.
+ * @param batch The totals of the batch.
+ */
+void print_batch_summary(FILE *output, const BatchSummary *batch) {
+    print_line(output);
+    fprintf(output, "| BATCH SUMMARY (%ld files)\n", batch->files);
+    fprintf(output, "|    Succeeded : %ld\n", batch->succeeded);
+    fprintf(output, "|    Failed    : %ld\n", batch->failed);
+    fprintf(output, "|    Errors    : %ld\n", batch->errors);
+    fprintf(output, "|    Warnings  : %ld\n", batch->warnings);
+    print_line(output);
+}
@@ -2,168 +2,177 @@
  *                                        Includes
  * --------------------------------------------------------------------------------------- */
 #include "../../structures/headers/label_data.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Number of labels the data array holds after its first growth */
+#define INITIAL_LABELS 16
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static Boolean grow_labels(LabelTable *table);
 /* ---------------------------------------------------------------------------------------
  *                                        Functions
  * --------------------------------------------------------------------------------------- */
 /**
- * Initialize the label trie.
- * This function sets up the trie for storing labels, it uses the init_trie method of the
- * generic trie structure.
+ * Initialize the label table.
+ * This function sets up the table for storing labels, it uses the init_symbol_table method of the
+ * generic symbol table structure for the names of the labels.
  *
- * @param trie Pointer to the trie structure.
+ * @param table Pointer to the label table.
  * @return TRUE if the initialization was successful, FALSE otherwise.
  */
-Boolean init_label_trie(Trie *trie) {
-    return init_trie(trie);
+Boolean init_label_table(LabelTable *table) {
+    table->labels = NULL;
+    table->capacity = 0;
+    return init_symbol_table(&table->names);
+}
+
+/**
+ * Retrieve the ID of a label, interning its name if it was not seen before.
+ * A new label is UNDEFINED until it is inserted with `insert_label`.
+ *
+ * @param table Pointer to the label table.
+ * @param label The name of the label - does not have to be null-terminated.
+ * @param length The number of characters in the name.
+ * @return The ID of the label, or -1 if memory allocation failed.
+ */
+int intern_label(LabelTable *table, const char *label, size_t length) {
+    int count = table->names.count; /* Number of labels before interning */
+    int id;
+
+    /* Make room for the data of a new label */
+    if (count == table->capacity && grow_labels(table) == FALSE) return -1;
+
+    id = intern_symbol(&table->names, label, length);
+    if (id == count) { /* New label */
+        table->labels[id].offset = 0;
+        table->labels[id].section = SECTION_NONE;
+        table->labels[id].label_type = UNDEFINED;
+    }
+    return id;
 }
 
 /**
- * Insert a label into the trie with its address and type.
- * Allocates memory for label data and inserts it into the trie.
- * Uses the generic trie structure methods.
+ * Insert a label into the table with its offset and type - defines the label.
+ * The section of the label follows from its type: INSTRUCTION labels are in the code section,
+ * DIRECTIVE labels in the data section and EXTERNAL labels in none.
+ * Uses the generic symbol table methods.
  *
- * @param trie Pointer to the trie structure.
+ * @param table Pointer to the label table.
  * @param label The label to be inserted.
- * @param address The address associated with the label.
+ * @param offset The offset of the label in its section.
  * @param label_type The type of the label.
  * @return ErrorCode - Error code of the error that occurred or NO_ERROR if the process
  *          executed successfully.
  */
-ErrorCode insert_label(Trie *trie, const char *label, int address, LabelType label_type) {
-    ErrorCode insert_status;
-    /* Allocate memory for the labelData struct */
-    LabelData *label_data = (LabelData *)malloc(sizeof(LabelData));
-    if (!label_data) return MEMORY_ALLOCATION_ERROR;
+ErrorCode insert_label(LabelTable *table, const char *label, int offset, LabelType label_type) {
+    LabelData *label_data;
+    int id;
 
-    /* Set the specified values */
-    label_data->address = address;
-    label_data->label_type = label_type;
+    /* Char not found */
+    if (valid_symbol_name(label) == FALSE) return INVALID_CHAR;
 
-    /* Insert the label in the trie and save the process status */
-    insert_status = insert_to_trie(trie, label, label_data);
+    id = intern_label(table, label, strlen(label));
+    if (id == -1) return MEMORY_ALLOCATION_ERROR;
 
-    /* If the process failed - free the located memory */
-    if (insert_status != NO_ERROR) free(label_data);
+    /* The label is already defined */
+    label_data = &table->labels[id];
+    if (label_data->label_type != UNDEFINED) return DUPLICATE;
 
-    return insert_status;
+    /* Set the specified values */
+    label_data->offset = offset;
+    label_data->label_type = label_type;
+    switch (label_type) {
+        case INSTRUCTION: label_data->section = SECTION_CODE; break;
+        case DIRECTIVE:   label_data->section = SECTION_DATA; break;
+        default:          label_data->section = SECTION_NONE; break;
+    }
+    return NO_ERROR;
 }
 
 /**
- * Retrieve the address of a label from the trie.
- * Searches the trie for the label and returns its address.
+ * Retrieve the ID of a label without interning it.
  *
- * @param trie Pointer to the trie structure.
- * @param label The label whose address is to be retrieved.
- * @return The address of the label if found, -1 otherwise.
+ * @param table Pointer to the label table.
+ * @param label The name of the label.
+ * @return The ID of the label if it was seen, -1 otherwise.
  */
-int get_label_addr(Trie *trie, const char *label) {
-    TrieNode *node;
-    LabelData *label_data;
-
-    /* Search for the label in the trie */
-    node = search_trie(trie, label);
-    if (!node) return -1;/* Label was not found */
-
-    label_data = (LabelData *)node->data;
-
-    /* label does not contain any associated data */
-    if (!label_data) return -1;
-
-    /* Return labels address */
-    return label_data->address;
+int find_label_id(const LabelTable *table, const char *label) {
+    Symbol *symbol = search_symbol(&table->names, label, strlen(label));
+    return symbol ? (int)(symbol - table->names.symbols) : -1;
 }
 
 /**
- * Retrieve the type of a label from the trie.
- * Searches the trie for the label and returns its type.
+ * Retrieve the name of a label.
  *
- * @param trie Pointer to the trie structure.
- * @param label The label whose type is to be retrieved.
- * @return The type of the label if found, -1 otherwise.
+ * @param table Pointer to the label table.
+ * @param id The ID of the label.
+ * @return The name of the label.
  */
-LabelType get_label_type(Trie *trie, const char *label) {
-    TrieNode *node;
-    LabelData *label_data;
-
-    /* Search for the label in the trie */
-    node = search_trie(trie, label);
-    if (!node) return -1;/* Label was not found */
-
-    label_data = (LabelData *)node->data;
-    /* label does not contain any associated data */
-    if (!label_data) return -1;
-
-    /* return labels type */
-    return label_data->label_type;
+const char *label_name(const LabelTable *table, int id) {
+    return symbol_name(&table->names, &table->names.symbols[id]);
 }
 
 /**
- * Set the label type for an existing label in the trie.
- * Searches for the label in the trie and updates its type.
+ * Retrieve the absolute address of a label from the start addresses of the sections.
  *
- * @param trie Pointer to the trie structure.
- * @param label The label whose type is to be set.
- * @param label_type The new type to be assigned to the label.
- * @return TRUE if the label type was successfully set, FALSE otherwise.
+ * @param label The data of the label.
+ * @param code_start The address of the first instruction.
+ * @param data_start The address of the first data word.
+ * @return The address of the label, or 0 if the label has no section (external).
  */
-Boolean set_label_type(Trie *trie, const char *label, LabelType label_type) {
-    TrieNode *node;
-    LabelData *label_data;
-
-    /* Search for the label */
-    node = search_trie(trie, label);
-
-    if (!node) return FALSE; /* Label was not found */
-
-    label_data = (LabelData *)node->data;
-
-    /* No data associated with this label */
-    if (!label_data) return FALSE;
-
-    /* Set the specified type */
-    label_data->label_type = label_type;
-    return TRUE; /* Process executed successfully */
+int label_address(const LabelData *label, int code_start, int data_start) {
+    switch (label->section) {
+        case SECTION_CODE: return code_start + label->offset;
+        case SECTION_DATA: return data_start + label->offset;
+        default:           return 0;
+    }
 }
 
 /**
- * Update the addresses of nodes of a specified type.
- * Increments the addresses of nodes of the given type by the specified amount.
+ * Calculate the memory held by the label table, including the data of the labels.
  *
- * @param node Pointer to the current trie node.
- * @param increment The amount to increment the addresses by.
- * @param type The type of labels to update.
+ * @param table Pointer to the label table.
+ * @return The number of allocated bytes.
  */
-void update_addr(TrieNode *node, int increment, LabelType type) {
-    int i;
-    LabelData *data;
-
-    if (!node) return; /* Null pointer */
-
-    data = (LabelData *)node->data;
-
-    /* If data exists and it is the accurate label type */
-    if (data && data->label_type == type) {
-        data->address += increment;
-    }
+size_t label_table_memory(const LabelTable *table) {
+    return symbol_table_memory(&table->names) + (size_t)table->capacity * sizeof(LabelData);
+}
 
-    /* Recursively update child nodes */
-    for (i = 0; i < ALPHABET_SIZE; ++i) {
-        if (node->children[i] != NULL) {
-            update_addr(node->children[i], increment, type);
-        }
-    }
+/**
+ * Empty the label table, keeping its memory for the labels of the next file.
+ *
+ * @param table Pointer to the label table.
+ */
+void reset_label_table(LabelTable *table) {
+    reset_symbol_table(&table->names);
 }
 
 /**
- * Free the entire label trie.
- * Frees the memory for all nodes in the trie and resets the struct pointers to null.
+ * Free the entire label table.
  *
- * @param trie Pointer to the trie structure.
+ * @param table Pointer to the label table.
  */
-void free_label_tree(Trie *trie) {
-    if (trie->root) {
-        free_node(trie->root);
-        trie->root = NULL;
-    }
+void free_label_table(LabelTable *table) {
+    free_symbol_table(&table->names);
+    free(table->labels);
+    table->labels = NULL;
+    table->capacity = 0;
 }
 
+/**
+ * Static function - doubles the capacity of the label data array.
+ *
+ * @param table Pointer to the label table.
+ * @return TRUE if the array was grown successfully, FALSE if memory allocation failed.
+ */
+static Boolean grow_labels(LabelTable *table) {
+    int new_capacity = table->capacity ? table->capacity * 2 : INITIAL_LABELS;
+    LabelData *new_labels = (LabelData *)realloc(table->labels, new_capacity * sizeof(LabelData));
+    if (!new_labels) return FALSE;
+
+    table->labels = new_labels;
+    table->capacity = new_capacity;
+    return TRUE;
+}
@@ -0,0 +1,109 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/line_buffer.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Initial number of allocated characters, enough for a small program */
+#define INITIAL_CAPACITY 1024
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Initializes an empty line buffer.
+ *
+ * @param buffer Pointer to the line buffer to be initialized.
+ */
+void init_line_buffer(LineBuffer *buffer) {
+    buffer->text = NULL;
+    buffer->size = 0;
+    buffer->capacity = 0;
+    buffer->count = 0;
+}
+
+/**
+ * Adds a copy of the specified line to the end of the line buffer.
+ * The buffer is doubled whenever the line does not fit in it.
+ *
+ * @param buffer Pointer to the line buffer.
+ * @param line The line to be added.
+ * @return TRUE if the line is added successfully, FALSE if memory allocation failed.
+ */
+Boolean add_line(LineBuffer *buffer, const char *line) {
+    size_t length = strlen(line) + 1; /* Length of the line, including the null-terminator */
+    size_t new_capacity;              /* The capacity after growing the buffer */
+    char *new_text = NULL;            /* The grown buffer */
+
+    /* Grow the buffer if needed */
+    if (buffer->size + length > buffer->capacity) {
+        new_capacity = buffer->capacity ? buffer->capacity : INITIAL_CAPACITY;
+        while (buffer->size + length > new_capacity) new_capacity *= 2;
+
+        new_text = (char *)realloc(buffer->text, new_capacity);
+        if (!new_text) return FALSE; /* Memory allocation failure */
+
+        buffer->text = new_text;
+        buffer->capacity = new_capacity;
+    }
+
+    /* Copy the line with its null-terminator */
+    memcpy(buffer->text + buffer->size, line, length);
+    buffer->size += length;
+    buffer->count++;
+    return TRUE;
+}
+
+/**
+ * Retrieves the next line of the line buffer.
+ *
+ * @param buffer Pointer to the line buffer.
+ * @param pos Pointer to the position of the next line, updated by the function.
+ * @return The next line, or NULL if there are no more lines.
+ */
+const char *next_line(const LineBuffer *buffer, size_t *pos) {
+    const char *line;
+
+    if (*pos >= buffer->size) return NULL; /* No more lines */
+
+    line = buffer->text + *pos;
+    *pos += strlen(line) + 1; /* Skip to the start of the next line */
+    return line;
+}
+
+/**
+ * Writes all the lines of the line buffer to the specified file.
+ *
+ * @param buffer Pointer to the line buffer.
+ * @param file The file to write the lines to.
+ */
+void write_lines(const LineBuffer *buffer, FILE *file) {
+    size_t pos = 0;       /* Position of the next line */
+    const char *line;
+
+    while ((line = next_line(buffer, &pos)) != NULL) {
+        fputs(line, file);
+    }
+}
+
+/**
+ * Empties the line buffer, keeping its memory for the lines of the next file.
+ *
+ * @param buffer Pointer to the line buffer to be emptied.
+ */
+void reset_line_buffer(LineBuffer *buffer) {
+    buffer->size = 0;
+    buffer->count = 0;
+}
+
+/**
+ * Frees the memory of the line buffer, leaving it empty.
+ *
+ * @param buffer Pointer to the line buffer to be freed.
+ */
+void free_line_buffer(LineBuffer *buffer) {
+    free(buffer->text);
+    init_line_buffer(buffer);
+}
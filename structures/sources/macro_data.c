@@ -15,8 +15,8 @@
  * @return TRUE if initialization is successful, FALSE otherwise.
  */
 Boolean init_macr_trie(MacroTrie *macr_trie) {
-    if (init_trie(&macr_trie->trie) == TRUE) {
-        macr_trie->last_added_node = NULL;
+    if (init_symbol_table(&macr_trie->table) == TRUE) {
+        macr_trie->last_added = NULL;
         return TRUE;
     }
     return FALSE;
@@ -40,10 +40,10 @@ ErrorCode add_macr(MacroTrie *macr_trie, const char *macr_name) {
     macr_data->head = NULL;
     macr_data->tail = NULL;
 
-    /* Try inserting the macro to the trie node */
-    status = insert_to_trie(&macr_trie->trie, macr_name, macr_data);
+    /* Try inserting the macro to the table */
+    status = insert_symbol(&macr_trie->table, macr_name, macr_data);
     if (status == NO_ERROR) {
-        macr_trie->last_added_node = search_trie(&macr_trie->trie, macr_name);
+        macr_trie->last_added = macr_data;
     } else {
         /* Process failed */
         free(macr_data);
@@ -58,21 +58,18 @@ ErrorCode add_macr(MacroTrie *macr_trie, const char *macr_name) {
  * @param line The line to be added.
  * @return TRUE if the line is added successfully, FALSE otherwise.
  */
-void add_line_to_last_macro(MacroTrie *macr_trie, const char *line) {
+Boolean add_line_to_last_macro(MacroTrie *macr_trie, const char *line) {
     MacroData *macr_data = NULL;
     LineNode *new_line_node = NULL;
 
     /* Null pointer */
-    if (!macr_trie->last_added_node) return;
+    if (!macr_trie->last_added) return TRUE;
 
-    macr_data = (MacroData *)macr_trie->last_added_node->data;
+    macr_data = macr_trie->last_added;
     new_line_node = (LineNode *)malloc(sizeof(LineNode));
 
     /* Memory allocation failure */
-    if (!new_line_node) {
-        set_general_error(MEMORY_ALLOCATION_ERROR);
-        return;
-    }
+    if (!new_line_node) return FALSE;
 
     /* Copy line to macro data structure */
     strncpy(new_line_node->line, line, MAX_LINE_LENGTH);
@@ -86,22 +83,24 @@ void add_line_to_last_macro(MacroTrie *macr_trie, const char *line) {
         macr_data->head = new_line_node;
         macr_data->tail = new_line_node;
     }
+    return TRUE;
 }
 
 /**
  * Finds a macro in the Macro Trie.
  *
  * @param macr_trie Pointer to the Macro Trie structure.
- * @param macr_name The name of the macro.
- * @return Pointer to the TrieNode representing the macro, or NULL if not found.
+ * @param macr_name The name of the macro - does not have to be null-terminated.
+ * @param length The number of characters in the name.
+ * @return Pointer to the symbol representing the macro, or NULL if not found.
+ *         The data of the symbol is NULL once the macro contents were freed.
  */
-TrieNode* find_macro(const MacroTrie *macr_trie, const char *macr_name) {
-    return search_trie(&macr_trie->trie, macr_name);
+Symbol* find_macro(const MacroTrie *macr_trie, const char *macr_name, size_t length) {
+    return search_symbol(&macr_trie->table, macr_name, length);
 }
 
 /**
- * Static function - frees a LineNode linked list associated with a Macro
- * Trie node.
+ * Static function - frees a LineNode linked list associated with a macro.
  *
  * @param head Pointer to the head of the LineNode linked list.
  */
@@ -119,7 +118,7 @@ static void free_line_nodes(LineNode *head) {
 }
 
 /**
- * Static function - frees the data associated with a Macro Trie node.
+ * Static function - frees the data associated with a macro.
  *
  * @param data Pointer to the data to be freed.
  */
@@ -135,35 +134,30 @@ static void free_macr_data(void *data) {
 }
 
 /**
- * Static function - frees all data in the trie without freeing the nodes.
+ * Frees the contents of all the macros, keeping their names in the table.
  * Leaving the only necessary data for the following steps.
  *
- * @param node Pointer to the root of the trie.
+ * @param macr_trie Pointer to the Macro Trie structure.
  */
-void free_data_recursive(TrieNode* node) {
+void free_trie_data(MacroTrie *macr_trie) {
     int i;
-    if (node) {
-        /* Iterate through all nodes children */
-        for (i = 0; i < ALPHABET_SIZE; i++) {
-            if (node->children[i]) {
-                free_data_recursive(node->children[i]);
-            }
-        }
-        /* Free all associated data with this node, if exists */
-        if (node->data) {
-            free_macr_data(node->data);
-            node->data = NULL;
-        }
+
+    /* Free all associated data with the macros, if exists */
+    for (i = 0; i < macr_trie->table.count; i++) {
+        free_macr_data(macr_trie->table.symbols[i].data);
+        macr_trie->table.symbols[i].data = NULL;
     }
+    macr_trie->last_added = NULL;
 }
 
 /**
- * Frees all data in the trie without freeing the nodes.
+ * Empties the Macro Trie, keeping the memory of its table for the macros of the next file.
  *
  * @param macr_trie Pointer to the Macro Trie structure.
  */
-void free_trie_data(MacroTrie *macr_trie) {
-    free_data_recursive(macr_trie->trie.root);
+void reset_macr_trie(MacroTrie *macr_trie) {
+    free_trie_data(macr_trie);
+    reset_symbol_table(&macr_trie->table);
 }
 
 /**
@@ -172,5 +166,6 @@ void free_trie_data(MacroTrie *macr_trie) {
  * @param macr_trie Pointer to the Macro Trie structure.
  */
 void free_macr_trie(MacroTrie *macr_trie) {
-    free_node(macr_trie->trie.root);
+    free_trie_data(macr_trie);
+    free_symbol_table(&macr_trie->table);
 }
\ No newline at end of file
@@ -0,0 +1,89 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include "../headers/mapping_tables.h"
+/* ---------------------------------------------------------------------------------------
+ *                                         Mappings
+ * --------------------------------------------------------------------------------------- */
+/* Directive table mapping directive names to their corresponding types */
+const DirectiveMapping directive_table[] = {
+        {"string", STRING},    /* Maps "string" to the STRING directive type */
+        {"data", DATA},        /* Maps "data" to the DATA directive type */
+        {"entry", ENTRY},      /* Maps "entry" to the ENTRY directive type */
+        {"extern", EXTERN},    /* Maps "extern" to the EXTERN directive type */
+        {""}                   /* Sentinel value to mark the end of the table */
+};
+
+/**
+ * Mapping of instruction names to their corresponding function parameters and addressing modes
+ * In the address mode array - 1 indicates a valid address mode ; 0 indicates invalid address mode.
+ */
+const InstructMapping instruct_table[] = {
+        {"mov", 2, {1,1,1,1}, {0,1,1,1}}, /* MOV instruction with 2 parameters */
+        {"cmp", 2, {1,1,1,1}, {1,1,1,1}}, /* CMP instruction with 2 parameters */
+        {"add", 2, {1,1,1,1}, {0,1,1,1}}, /* ADD instruction with 2 parameters */
+        {"sub", 2, {1,1,1,1}, {0,1,1,1}}, /* SUB instruction with 2 parameters */
+        {"lea", 2, {0,1,0,0}, {0,1,1,1}}, /* LEA instruction with 2 parameters */
+        {"clr", 1, {0,1,1,1}},            /* CLR instruction with 1 parameter */
+        {"not", 1, {0,1,1,1}},            /* NOT instruction with 1 parameter */
+        {"inc", 1, {0,1,1,1}},            /* INC instruction with 1 parameter */
+        {"dec", 1, {0,1,1,1}},            /* DEC instruction with 1 parameter */
+        {"jmp", 1, {0,1,1,0}},            /* JMP instruction with 1 parameter */
+        {"bne", 1, {0,1,1,0}},            /* BNE instruction with 1 parameter */
+        {"red", 1, {0,1,1,1}},            /* RED instruction with 1 parameter */
+        {"prn", 1, {1,1,1,1}},            /* PRN instruction with 1 parameter */
+        {"jsr", 1, {0,1,1,0}},            /* JSR instruction with 1 parameter */
+        {"rts", 0},                       /* RTS instruction with no parameters */
+        {"stop", 0},                      /* STOP instruction with no parameters */
+        {"", 0}                           /* Sentinel value to mark the end of the table */
+};
+
+/* Register table listing the names of available registers */
+const char *const registers[] = {
+        "r0", "r1", "r2", "r3", "r4", "r5",
+        "r6", "r7", NULL /* NULL marks the end of the array */
+};
+
+/* Table for macro commands - initialization and the end of initialization of a macro */
+const MacrReserved macr_reserved_table[] = {
+        {"macr", MACR_START}, {"endmacr", MACR_END},
+        {"",0} /* Sentinel value to mark the end of the table */
+};
+
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Retrieves the name of a keyword from the mapping tables.
+ *
+ * @param keyword The keyword - its type and its index in the table of the type.
+ * @return The name of the keyword, or an empty string if the keyword does not exist.
+ */
+const char *keyword_name(Keyword keyword) {
+    switch (keyword.type) {
+        case KEYWORD_INSTRUCTION: return instruct_table[keyword.index].command_str;
+        case KEYWORD_DIRECTIVE: return directive_table[keyword.index].command_str;
+        case KEYWORD_REGISTER: return registers[keyword.index];
+        case KEYWORD_MACRO: return macr_reserved_table[keyword.index].command_str;
+        default: return "";
+    }
+}
+
+/**
+ * Calculates the hash of a keyword with the specified seed (FNV-1a). The generator searches
+ * for a seed with which every keyword gets its own entry of the keyword hash table.
+ *
+ * @param seed The seed of the hash.
+ * @param str The word to hash.
+ * @param length The number of characters in the word.
+ * @return The index of the word in the keyword hash table.
+ */
+int keyword_hash(unsigned long seed, const char *str, size_t length) {
+    unsigned long hash = seed;
+    size_t i;
+
+    for (i = 0; i < length; i++) {
+        hash = ((hash ^ (unsigned char)str[i]) * 16777619UL) & 0xFFFFFFFFUL;
+    }
+    return (int)((hash ^ (hash >> 16)) & (KEYWORD_HASH_SIZE - 1));
+}
@@ -4,55 +4,8 @@
 #include <stdio.h>
 #include <string.h>
 #include "../headers/mappings.h"
-/* ---------------------------------------------------------------------------------------
- *                                          Mappings
- * --------------------------------------------------------------------------------------- */
-
-/* Directive table mapping directive names to their corresponding types */
-static DirectiveMapping directive_table[] = {
-        {"string", STRING},    /* Maps "string" to the STRING directive type */
-        {"data", DATA},        /* Maps "data" to the DATA directive type */
-        {"entry", ENTRY},      /* Maps "entry" to the ENTRY directive type */
-        {"extern", EXTERN},    /* Maps "extern" to the EXTERN directive type */
-        {""}                   /* Sentinel value to mark the end of the table */
-};
-
-/**
- * Mapping of instruction names to their corresponding function parameters and addressing modes
- * In the address mode array - 1 indicates a valid address mode ; 0 indicates invalid address mode.
- */
-static InstructMapping instruct_table[] = {
-        {"mov", 2, {1,1,1,1}, {0,1,1,1}}, /* MOV instruction with 2 parameters */
-        {"cmp", 2, {1,1,1,1}, {1,1,1,1}}, /* CMP instruction with 2 parameters */
-        {"add", 2, {1,1,1,1}, {0,1,1,1}}, /* ADD instruction with 2 parameters */
-        {"sub", 2, {1,1,1,1}, {0,1,1,1}}, /* SUB instruction with 2 parameters */
-        {"lea", 2, {0,1,0,0}, {0,1,1,1}}, /* LEA instruction with 2 parameters */
-        {"clr", 1, {0,1,1,1}},            /* CLR instruction with 1 parameter */
-        {"not", 1, {0,1,1,1}},            /* NOT instruction with 1 parameter */
-        {"inc", 1, {0,1,1,1}},            /* INC instruction with 1 parameter */
-        {"dec", 1, {0,1,1,1}},            /* DEC instruction with 1 parameter */
-        {"jmp", 1, {0,1,1,0}},            /* JMP instruction with 1 parameter */
-        {"bne", 1, {0,1,1,0}},            /* BNE instruction with 1 parameter */
-        {"red", 1, {0,1,1,1}},            /* RED instruction with 1 parameter */
-        {"prn", 1, {1,1,1,1}},            /* PRN instruction with 1 parameter */
-        {"jsr", 1, {0,1,1,0}},            /* JSR instruction with 1 parameter */
-        {"rts", 0},                       /* RTS instruction with no parameters */
-        {"stop", 0},                      /* STOP instruction with no parameters */
-        {"", 0}                           /* Sentinel value to mark the end of the table */
-};
-
-/* Register table listing the names of available registers */
-static const char* registers[] = {
-        "r0", "r1", "r2", "r3", "r4", "r5",
-        "r6", "r7", NULL /* NULL marks the end of the array */
-};
-
-/* Table for macro commands - initialization and the end of initialization of a macro */
-static const MacrReserved macr_reserved_table[] = {
-        {"macr", MACR_START}, {"endmacr", MACR_END},
-        {"",0} /* Sentinel value to mark the end of the table */
-};
-
+#include "../headers/mapping_tables.h"
+#include "keyword_hash.h" /* Generated at build time from the mapping tables */
 /* ---------------------------------------------------------------------------------------
  *                                       Functions
  * --------------------------------------------------------------------------------------- */
@@ -76,6 +29,27 @@ DirectiveType get_dir_command (short i) {
     return directive_table[i].dir_command;
 }
 
+/**
+ * Classifies a word with a single lookup in the perfect hash of all the reserved words.
+ * The hash gives every reserved word its own entry, so a word is compared only to the
+ * one reserved word of its entry.
+ *
+ * @param str The word to classify - does not have to be null-terminated.
+ * @param length The number of characters in the word.
+ * @return The class of the word and its index in the table of the class, or
+ *         {KEYWORD_NONE, -1} if the word is not reserved.
+ */
+Keyword find_keyword(const char *str, size_t length) {
+    Keyword keyword = keyword_hash_table[keyword_hash(KEYWORD_HASH_SEED, str, length)];
+    const char *name = keyword_name(keyword);
+
+    if (keyword.type == KEYWORD_NONE || strncmp(name, str, length) != 0 || name[length] != '\0') {
+        keyword.type = KEYWORD_NONE;
+        keyword.index = -1;
+    }
+    return keyword;
+}
+
 /**
  * Finds the index in the instruction table of an instruction based on its name.
  *
@@ -83,18 +57,8 @@ DirectiveType get_dir_command (short i) {
  * @return The index of the instruction in the instruct_table, or -1 if not found.
  */
 short get_instruct_index(const char* str) {
-    short i = 0; /* Index for iterating through the instruct_table array */
-
-    /* Iterate through the instruct_table array */
-    while (instruct_table[i].command_str[0] != '\0') {
-        if (strcmp(instruct_table[i].command_str, str) == 0) {
-            return i; /* Found corresponding instruction */
-        }
-        i++;
-    }
-
-    /* Return -1 if the corresponding instruction has not been found */
-    return -1;
+    Keyword keyword = find_keyword(str, strlen(str));
+    return (keyword.type == KEYWORD_INSTRUCTION) ? keyword.index : -1;
 }
 
 /**
@@ -104,18 +68,8 @@ short get_instruct_index(const char* str) {
  * @return The index of the directive in the directive_table, or -1 if not found.
  */
 short get_dir_index(const char* str) {
-    short i = 0; /* Index for iterating through the directive_table array */
-
-    /* Iterate through the directive_table array */
-    while (directive_table[i].command_str[0] != '\0') {
-        if (strcmp(directive_table[i].command_str, str) == 0) {
-            return i; /* found corresponding directive */
-        }
-        i++;
-    }
-
-    /* Return -1 if the corresponding directive has not been found */
-    return -1;
+    Keyword keyword = find_keyword(str, strlen(str));
+    return (keyword.type == KEYWORD_DIRECTIVE) ? keyword.index : -1;
 }
 
 /**
@@ -125,18 +79,8 @@ short get_dir_index(const char* str) {
  * @return The index of the register in the registers array, or -1 if not found.
  */
 short get_register_index(const char* str) {
-    short i = 0; /* Index for iterating through the registers array */
-
-    /* Iterate through the registers array */
-    while (registers[i] != NULL) {
-        if (strcmp(registers[i] , str) == 0) {
-            return i; /* Found register */
-        }
-        i++;
-    }
-
-    /* Return -1 if the corresponding register has not been found */
-    return -1;
+    Keyword keyword = find_keyword(str, strlen(str));
+    return (keyword.type == KEYWORD_REGISTER) ? keyword.index : -1;
 }
 
 /**
@@ -147,18 +91,11 @@ short get_register_index(const char* str) {
  * @return The macro command image.
  */
 MacrCommand find_macr_reserved(const char* str) {
-    short i = 0; /* Index for iterating through the macr_reserved_table array */
-
-    /* Iterate through the macr_reserved_table array */
-    while (macr_reserved_table[i].command_str[0] != '\0') {
-        if (strcmp(macr_reserved_table[i].command_str, str) == 0) {
-            return macr_reserved_table[i].macr_code; /* Found macr_code reserved word */
-        }
-        i++;
-    }
+    Keyword keyword = find_keyword(str, strlen(str));
 
     /* Return -1 if the corresponding macr_code reserved word has not been found */
-    return -1;
+    if (keyword.type != KEYWORD_MACRO) return -1;
+    return macr_reserved_table[keyword.index].macr_code;
 }
 
 /**
@@ -183,30 +120,12 @@ Boolean valid_addr_mode(int command_index, int addr_mode, int param) {
 }
 
 /**
- * Checks if a given string is a reserved word, including instructions, directives, or registers.
+ * Checks if a given string is a reserved word, including instructions, directives, registers
+ * or macro words.
  *
  * @param str The string to check.
- * @return TRUE if the string matches an instruction, directive, or register ; FALSE otherwise.
+ * @return TRUE if the string matches a reserved word ; FALSE otherwise.
  */
 Boolean reserved_word(const char *str) {
-    /* Check instructions */
-    if (get_instruct_index(str) != -1) {
-        return TRUE;
-    }
-
-    /* Check directive */
-    if (get_dir_index(str) != -1) {
-        return TRUE;
-    }
-
-    /* Check register */
-    if (get_register_index(str) != -1) {
-        return TRUE;
-    }
-
-    /* Check macr_code definition reserved words */
-    if (find_macr_reserved(str) != -1) {
-        return TRUE;
-    }
-    return FALSE;
+    return (find_keyword(str, strlen(str)).type != KEYWORD_NONE) ? TRUE : FALSE;
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#define _POSIX_C_SOURCE 200112L
+#include <stdlib.h>
+#include <pthread.h>
+#include "../headers/spsc_ring.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Number of times to check the ring again before sleeping */
+#define SPIN_COUNT 64
+/* Loads and stores of the positions - ordered with the writes and reads of the slots */
+#if defined(__GNUC__)
+#define LOAD_ACQUIRE(position) __atomic_load_n(&(position), __ATOMIC_ACQUIRE)
+#define LOAD_RELAXED(position) __atomic_load_n(&(position), __ATOMIC_RELAXED)
+/* The position that a side publishes, and the sleepers, are in a single order for both sides */
+#define STORE_SEQ_CST(position, value) __atomic_store_n(&(position), (value), __ATOMIC_SEQ_CST)
+#define LOAD_SEQ_CST(position) __atomic_load_n(&(position), __ATOMIC_SEQ_CST)
+#define ADD_SLEEPERS(ring, count) __atomic_add_fetch(&(ring)->sleepers, (count), __ATOMIC_SEQ_CST)
+#else
+#error "The ring needs the atomic builtins of GCC or Clang"
+#endif
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static void wait_turn(SpscRing *ring, const unsigned long *position, unsigned long seen, int *spins);
+static void wake_other_side(SpscRing *ring);
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Initializes an empty ring.
+ *
+ * @param ring Pointer to the ring to be initialized.
+ * @param capacity The number of items the ring holds - rounded up to a power of two.
+ * @return TRUE if the ring was initialized, FALSE if memory allocation failed or its lock could
+ *         not be initialized.
+ */
+Boolean init_ring(SpscRing *ring, unsigned long capacity) {
+    unsigned long slots = 1; /* Number of slots */
+
+    while (slots < capacity) slots <<= 1;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->sleepers = 0;
+    ring->mask = slots - 1;
+    if (!(ring->slots = (void **)malloc(slots * sizeof(void *)))) return FALSE;
+
+    /* The lock exists only with the slots - free_ring destroys it only if there are slots */
+    if (pthread_mutex_init(&ring->lock, NULL) != 0) {
+        free(ring->slots);
+        ring->slots = NULL;
+        return FALSE;
+    }
+    if (pthread_cond_init(&ring->changed, NULL) != 0) {
+        pthread_mutex_destroy(&ring->lock);
+        free(ring->slots);
+        ring->slots = NULL;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/**
+ * Puts an item at the end of the ring - called by the producer only. Waits while the ring is full.
+ * The item is written before the tail is published, so the consumer sees the item with the tail.
+ *
+ * @param ring Pointer to the ring.
+ * @param item The item to put.
+ */
+void ring_put(SpscRing *ring, void *item) {
+    unsigned long tail = LOAD_RELAXED(ring->tail); /* Only this thread writes the tail */
+    unsigned long head;
+    int spins = 0;
+
+    while (tail - (head = LOAD_ACQUIRE(ring->head)) > ring->mask) {
+        wait_turn(ring, &ring->head, head, &spins);
+    }
+    ring->slots[tail & ring->mask] = item;
+    STORE_SEQ_CST(ring->tail, tail + 1);
+    wake_other_side(ring);
+}
+
+/**
+ * Takes the item at the start of the ring - called by the consumer only. Waits while the ring is empty.
+ * The item is read before the head is published, so the producer does not overwrite it.
+ *
+ * @param ring Pointer to the ring.
+ * @return The item.
+ */
+void *ring_take(SpscRing *ring) {
+    unsigned long head = LOAD_RELAXED(ring->head); /* Only this thread writes the head */
+    void *item;
+    int spins = 0;
+
+    while (LOAD_ACQUIRE(ring->tail) == head) wait_turn(ring, &ring->tail, head, &spins);
+    item = ring->slots[head & ring->mask];
+    STORE_SEQ_CST(ring->head, head + 1);
+    wake_other_side(ring);
+    return item;
+}
+
+/**
+ * Frees the slots and the lock of the ring - the items belong to the caller. A ring that was
+ * zeroed, or whose initialization failed, may be freed too.
+ *
+ * @param ring Pointer to the ring to be freed.
+ */
+void free_ring(SpscRing *ring) {
+    if (!ring->slots) return;
+    pthread_cond_destroy(&ring->changed);
+    pthread_mutex_destroy(&ring->lock);
+    free(ring->slots);
+    ring->slots = NULL;
+}
+
+/**
+ * Static function - waits for the other side of the ring to change its position. The position is
+ * checked again a few times at once - the other side is usually in the middle of a batch - and
+ * after that the side sleeps until the other side changes the position.
+ * The side is counted as a sleeper before it checks the position for the last time, and the other
+ * side checks the sleepers after it changed the position - all four accesses are sequentially
+ * consistent, so either the change is seen here or the sleeper is seen there, and a wake-up is
+ * never lost.
+ *
+ * @param ring Pointer to the ring.
+ * @param position The position written by the other side.
+ * @param seen The value of the position that the side waits to change.
+ * @param spins Pointer to the number of checks so far, updated by the function.
+ */
+static void wait_turn(SpscRing *ring, const unsigned long *position, unsigned long seen, int *spins) {
+    if (++(*spins) <= SPIN_COUNT) return;
+
+    pthread_mutex_lock(&ring->lock);
+    ADD_SLEEPERS(ring, 1);
+    while (LOAD_SEQ_CST(*position) == seen) pthread_cond_wait(&ring->changed, &ring->lock);
+    ADD_SLEEPERS(ring, -1);
+    pthread_mutex_unlock(&ring->lock);
+}
+
+/**
+ * Static function - wakes the other side of the ring after this side changed its position, if
+ * the other side sleeps. The other side sleeps only while the ring is empty or full, so it is
+ * woken only when the ring stops being empty or full - in the common case this is a single check.
+ *
+ * @param ring Pointer to the ring.
+ */
+static void wake_other_side(SpscRing *ring) {
+    if (LOAD_SEQ_CST(ring->sleepers) == 0) return;
+
+    pthread_mutex_lock(&ring->lock);
+    pthread_cond_broadcast(&ring->changed);
+    pthread_mutex_unlock(&ring->lock);
+}
@@ -0,0 +1,121 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#include "../headers/stats.h"
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static void print_json_string(FILE *output, const char *str);
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Resets the times and counters of the specified statistics to zero.
+ *
+ * @param stats Pointer to the statistics to be reset.
+ */
+void reset_stats(AsmStats *stats) {
+    int i; /* Variable to iterate through the stages */
+
+    for (i = 0; i < STAGE_COUNT; i++) stats->seconds[i] = 0;
+    stats->lines_read = 0;
+    stats->macros_defined = 0;
+    stats->macros_expanded = 0;
+    stats->macro_line_nodes = 0;
+    stats->labels = 0;
+    stats->unresolved_operands = 0;
+    stats->bytes_written = 0;
+    stats->cache_hits = 0;
+    stats->cache_misses = 0;
+}
+
+/**
+ * Returns the current time of a monotonic clock, to measure the wall time of a stage.
+ *
+ * @return The current time in seconds, from an arbitrary starting point.
+ */
+double stats_clock(void) {
+    struct timespec now; /* The current time */
+
+    if (clock_gettime(CLOCK_MONOTONIC, &now) != 0) return 0;
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+/**
+ * Adds the time that passed since the specified start to the wall time of a stage.
+ *
+ * @param stats Pointer to the statistics.
+ * @param stage The timed stage.
+ * @param start The time the stage started, returned by `stats_clock`.
+ */
+void add_stage_time(AsmStats *stats, AsmStage stage, double start) {
+    stats->seconds[stage] += stats_clock() - start;
+}
+
+/**
+ * Prints the statistics of a file as a single line JSON object, so the statistics of a batch
+ * can be aggregated by other tools. The times are printed in seconds.
+ *
+ * @param output The stream to print to.
+ * @param file_name The base name of the file.
+ * @param status The final status of the file.
+ * @param stats Pointer to the statistics of the file.
+ */
+void print_stats(FILE *output, const char *file_name, Status status, const AsmStats *stats) {
+    fputs("{\"file\":", output);
+    print_json_string(output, file_name);
+    fprintf(output, ",\"status\":\"%s\"", status_name(status));
+    fprintf(output, ",\"seconds\":{\"preprocessor\":%.6f,\"first_phase\":%.6f,"
+                    "\"second_phase\":%.6f,\"output\":%.6f}",
+            stats->seconds[STAGE_PREPROCESSOR], stats->seconds[STAGE_FIRST_PHASE],
+            stats->seconds[STAGE_SECOND_PHASE], stats->seconds[STAGE_OUTPUT]);
+    fprintf(output, ",\"lines_read\":%ld,\"macros_defined\":%ld,\"macros_expanded\":%ld"
+                    ",\"macro_line_nodes\":%ld,\"labels\":%ld,\"unresolved_operands\":%ld"
+                    ",\"bytes_written\":%ld,\"cache_hits\":%ld,\"cache_misses\":%ld}\n",
+            stats->lines_read, stats->macros_defined, stats->macros_expanded,
+            stats->macro_line_nodes, stats->labels, stats->unresolved_operands,
+            stats->bytes_written, stats->cache_hits, stats->cache_misses);
+}
+
+/**
+ * Returns the name of a status, as printed in the statistics and in the replies of the server.
+ *
+ * @param status The status.
+ * @return The name of the status.
+ */
+const char *status_name(Status status) {
+    switch (status) {
+        case ERROR_FREE_FILE:
+            return "ok";
+        case ERROR_IN_FILE:
+            return "error";
+        default:
+            return "fatal";
+    }
+}
+
+/**
+ * Static function - prints a string as a JSON string, escaping the quotes, the backslashes
+ * and the control characters.
+ *
+ * @param output The stream to print to.
+ * @param str The string to print.
+ */
+static void print_json_string(FILE *output, const char *str) {
+    const unsigned char *c; /* The current character */
+
+    fputc('"', output);
+    for (c = (const unsigned char *)str; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', output);
+            fputc(*c, output);
+        } else if (*c < 0x20) {
+            fprintf(output, "\\u%04x", *c);
+        } else {
+            fputc(*c, output);
+        }
+    }
+    fputc('"', output);
+}
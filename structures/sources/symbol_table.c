@@ -0,0 +1,327 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include "../headers/symbol_table.h"
+#include "../../utils/headers/char_class.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Number of buckets of an empty table - must be a power of two */
+#define INITIAL_BUCKETS 64
+/* Number of symbols the array holds after its first growth */
+#define INITIAL_SYMBOLS 16
+/* Number of bytes the string arena holds after its first growth */
+#define INITIAL_NAMES 256
+/* Index of an empty bucket */
+#define EMPTY_BUCKET (-1)
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static unsigned long hash_name(const char *name, size_t length);
+static int find_bucket(const SymbolTable *table, const char *name, size_t length, unsigned long hash);
+static Boolean grow_buckets(SymbolTable *table);
+static Boolean reserve(SymbolTable *table, size_t name_length);
+static int add_symbol(SymbolTable *table, const char *name, size_t length, unsigned long hash, void *data);
+/* ---------------------------------------------------------------------------------------
+ *                                          Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Function to initialize an empty symbol table.
+ *
+ * @param table A pointer to the symbol table to be initialized.
+ * @return Boolean TRUE if the table is successfully initialized; FALSE otherwise.
+ */
+Boolean init_symbol_table(SymbolTable *table) {
+    int i; /* Variable to iterate through loop */
+
+    table->symbols = NULL;
+    table->count = 0;
+    table->capacity = 0;
+    table->names = NULL;
+    table->names_size = 0;
+    table->names_capacity = 0;
+    table->bucket_count = INITIAL_BUCKETS;
+    table->buckets = (int *)malloc(INITIAL_BUCKETS * sizeof(int));
+
+    /* Memory allocation failure */
+    if (!table->buckets) return FALSE;
+
+    for (i = 0; i < INITIAL_BUCKETS; i++) table->buckets[i] = EMPTY_BUCKET;
+    return TRUE;
+}
+
+/**
+ * Function to insert a name into the symbol table with generic data.
+ * A name may contain only letters, digits and the characters '-', '_' and '.'.
+ *
+ * @param table A pointer to the symbol table in which the name will be inserted.
+ * @param name The name to be inserted into the table.
+ * @param data A pointer to the generic data to be stored with the name.
+ * @return ErrorCode - INVALID_CHAR if the name contains an invalid character, DUPLICATE if the
+ *         name already exists, MEMORY_ALLOCATION_ERROR or NO_ERROR if the process executed successfully.
+ */
+ErrorCode insert_symbol(SymbolTable *table, const char *name, void *data) {
+    size_t length = strlen(name);                  /* Length of the name */
+    unsigned long hash = hash_name(name, length);  /* Hash of the name */
+
+    /* Char not found */
+    if (valid_symbol_name(name) == FALSE) return INVALID_CHAR;
+
+    /* If name already exists */
+    if (table->buckets[find_bucket(table, name, length, hash)] != EMPTY_BUCKET) return DUPLICATE;
+
+    /* Add the symbol */
+    return (add_symbol(table, name, length, hash, data) == -1) ? MEMORY_ALLOCATION_ERROR : NO_ERROR;
+}
+
+/**
+ * Function to retrieve the index of a name in the symbol table, inserting the name without data
+ * if it does not exist. The characters of the name are not checked. The index of a symbol
+ * never changes, and the indexes are dense - from 0 to the number of symbols.
+ *
+ * @param table A pointer to the symbol table.
+ * @param name The name - does not have to be null-terminated.
+ * @param length The number of characters in the name.
+ * @return The index of the symbol with this name, or -1 if memory allocation failed.
+ */
+int intern_symbol(SymbolTable *table, const char *name, size_t length) {
+    unsigned long hash = hash_name(name, length);  /* Hash of the name */
+    int index = table->buckets[find_bucket(table, name, length, hash)];
+
+    /* The name already exists */
+    if (index != EMPTY_BUCKET) return index;
+
+    return add_symbol(table, name, length, hash, NULL);
+}
+
+/**
+ * Function to check that a name contains only the characters that are allowed in a symbol
+ * name: letters, digits and the characters '-', '_' and '.'.
+ *
+ * @param name The name to check.
+ * @return TRUE if all the characters of the name are valid, FALSE otherwise.
+ */
+Boolean valid_symbol_name(const char *name) {
+    for (; *name; name++) {
+        if (!IS_CHAR(*name, CHAR_NAME)) return FALSE;
+    }
+    return TRUE;
+}
+
+/**
+ * Function to search for a symbol in the table.
+ * The name does not have to be null-terminated, so a span of a line can be searched as is.
+ * The returned pointer is valid until the next insertion to the table.
+ *
+ * @param table A pointer to the symbol table in which to search for the name.
+ * @param name The name to be searched in the table.
+ * @param length The number of characters in the name.
+ * @return Symbol* A pointer to the found symbol if the name exists; otherwise, NULL.
+ */
+Symbol* search_symbol(const SymbolTable *table, const char *name, size_t length) {
+    int index = table->buckets[find_bucket(table, name, length, hash_name(name, length))];
+    return (index == EMPTY_BUCKET) ? NULL : &table->symbols[index];
+}
+
+/**
+ * Function to retrieve the name of a symbol.
+ *
+ * @param table A pointer to the symbol table containing the symbol.
+ * @param symbol The symbol.
+ * @return The name of the symbol, stored in the string arena of the table.
+ */
+const char *symbol_name(const SymbolTable *table, const Symbol *symbol) {
+    return table->names + symbol->name;
+}
+
+/**
+ * Function to calculate the memory held by the symbol table itself - the symbol array,
+ * the buckets and the string arena. The data of the symbols is not included.
+ *
+ * @param table A pointer to the symbol table.
+ * @return The number of allocated bytes.
+ */
+size_t symbol_table_memory(const SymbolTable *table) {
+    return (size_t)table->capacity * sizeof(Symbol) +
+           (size_t)table->bucket_count * sizeof(int) +
+           table->names_capacity;
+}
+
+/**
+ * Function to empty the symbol table, keeping its memory for reuse.
+ * Only the buckets of the symbols are cleared, so the cost depends on the number of symbols
+ * and not on the size of the table. The data of the symbols belongs to the caller.
+ *
+ * @param table A pointer to the symbol table to be emptied.
+ */
+void reset_symbol_table(SymbolTable *table) {
+    int mask = table->bucket_count - 1;  /* Mask of a bucket index */
+    int i, bucket;
+
+    for (i = 0; i < table->count; i++) {
+        /* The symbol is found forward from its home bucket, even if cleared buckets precede it */
+        bucket = (int)(table->symbols[i].hash & (unsigned long)mask);
+        while (table->buckets[bucket] != i) bucket = (bucket + 1) & mask;
+        table->buckets[bucket] = EMPTY_BUCKET;
+    }
+    table->count = 0;
+    table->names_size = 0;
+}
+
+/**
+ * Function to free the symbol table.
+ * It frees the table's memory - the data of the symbols belongs to the caller.
+ *
+ * @param table A pointer to the symbol table to be freed.
+ */
+void free_symbol_table(SymbolTable *table) {
+    free(table->symbols);
+    free(table->buckets);
+    free(table->names);
+
+    /* Reset to an empty table without buckets */
+    table->symbols = NULL;
+    table->buckets = NULL;
+    table->names = NULL;
+    table->count = table->capacity = table->bucket_count = 0;
+    table->names_size = table->names_capacity = 0;
+}
+
+/**
+ * Static function - calculates the hash of a name (FNV-1a).
+ *
+ * @param name The name.
+ * @param length The number of characters in the name.
+ * @return The hash of the name.
+ */
+static unsigned long hash_name(const char *name, size_t length) {
+    unsigned long hash = 2166136261UL;
+    size_t i;
+
+    for (i = 0; i < length; i++) {
+        hash ^= (unsigned char)name[i];
+        hash = (hash * 16777619UL) & 0xFFFFFFFFUL;
+    }
+    return hash;
+}
+
+/**
+ * Static function - finds the bucket of a name: the bucket holding the symbol with this name,
+ * or the empty bucket the name should be inserted to.
+ *
+ * @param table A pointer to the symbol table.
+ * @param name The name.
+ * @param length The number of characters in the name.
+ * @param hash The hash of the name.
+ * @return The index of the bucket.
+ */
+static int find_bucket(const SymbolTable *table, const char *name, size_t length, unsigned long hash) {
+    int mask = table->bucket_count - 1;  /* Mask of a bucket index */
+    int bucket = (int)(hash & (unsigned long)mask);
+    const Symbol *symbol;
+    const char *stored;   /* The name of the symbol in the bucket */
+
+    /* Linear probing - the table is never more than half full */
+    while (table->buckets[bucket] != EMPTY_BUCKET) {
+        symbol = &table->symbols[table->buckets[bucket]];
+        stored = table->names + symbol->name;
+        if (symbol->hash == hash && strncmp(stored, name, length) == 0 && stored[length] == '\0') break;
+        bucket = (bucket + 1) & mask;
+    }
+    return bucket;
+}
+
+/**
+ * Static function - doubles the number of buckets and places the symbols in the new buckets.
+ *
+ * @param table A pointer to the symbol table.
+ * @return TRUE if the buckets were grown successfully, FALSE if memory allocation failed.
+ */
+static Boolean grow_buckets(SymbolTable *table) {
+    int new_count = table->bucket_count * 2;  /* The new number of buckets */
+    int *new_buckets = (int *)malloc(new_count * sizeof(int));
+    int mask = new_count - 1;
+    int i, bucket;
+
+    if (!new_buckets) return FALSE;
+
+    for (i = 0; i < new_count; i++) new_buckets[i] = EMPTY_BUCKET;
+    for (i = 0; i < table->count; i++) {
+        bucket = (int)(table->symbols[i].hash & (unsigned long)mask);
+        while (new_buckets[bucket] != EMPTY_BUCKET) bucket = (bucket + 1) & mask;
+        new_buckets[bucket] = i;
+    }
+
+    free(table->buckets);
+    table->buckets = new_buckets;
+    table->bucket_count = new_count;
+    return TRUE;
+}
+
+/**
+ * Static function - makes room for one more symbol with a name of the specified length.
+ *
+ * @param table A pointer to the symbol table.
+ * @param name_length The length of the name, without the null-terminator.
+ * @return TRUE if there is room for the symbol, FALSE if memory allocation failed.
+ */
+static Boolean reserve(SymbolTable *table, size_t name_length) {
+    int new_capacity;           /* The new capacity of the symbol array */
+    size_t new_names_capacity;  /* The new capacity of the string arena */
+    Symbol *new_symbols;
+    char *new_names;
+
+    /* Keep the buckets at most half full */
+    if ((table->count + 1) * 2 > table->bucket_count && grow_buckets(table) == FALSE) return FALSE;
+
+    if (table->count == table->capacity) {
+        new_capacity = table->capacity ? table->capacity * 2 : INITIAL_SYMBOLS;
+        new_symbols = (Symbol *)realloc(table->symbols, new_capacity * sizeof(Symbol));
+        if (!new_symbols) return FALSE;
+        table->symbols = new_symbols;
+        table->capacity = new_capacity;
+    }
+
+    if (table->names_size + name_length + 1 > table->names_capacity) {
+        new_names_capacity = table->names_capacity ? table->names_capacity : INITIAL_NAMES;
+        while (table->names_size + name_length + 1 > new_names_capacity) new_names_capacity *= 2;
+        new_names = (char *)realloc(table->names, new_names_capacity);
+        if (!new_names) return FALSE;
+        table->names = new_names;
+        table->names_capacity = new_names_capacity;
+    }
+    return TRUE;
+}
+
+/**
+ * Static function - adds a symbol that does not exist in the table, copying its name to the
+ * string arena.
+ *
+ * @param table A pointer to the symbol table.
+ * @param name The name - does not have to be null-terminated.
+ * @param length The number of characters in the name.
+ * @param hash The hash of the name.
+ * @param data A pointer to the generic data to be stored with the name.
+ * @return The index of the added symbol, or -1 if memory allocation failed.
+ */
+static int add_symbol(SymbolTable *table, const char *name, size_t length, unsigned long hash, void *data) {
+    Symbol *symbol;  /* The added symbol */
+    int bucket;      /* The bucket of the name */
+
+    /* Make room for the symbol and its name */
+    if (reserve(table, length) == FALSE) return -1;
+
+    /* The buckets may have been rehashed */
+    bucket = find_bucket(table, name, length, hash);
+
+    /* Copy the name to the arena and add the symbol */
+    memcpy(table->names + table->names_size, name, length);
+    table->names[table->names_size + length] = '\0';
+    symbol = &table->symbols[table->count];
+    symbol->name = table->names_size;
+    symbol->hash = hash;
+    symbol->data = data;
+    table->names_size += length + 1;
+    table->buckets[bucket] = table->count;
+    return table->count++;
+}
@@ -0,0 +1,56 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include "../headers/workspace.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Initializes an empty workspace.
+ *
+ * @param workspace Pointer to the workspace to be initialized.
+ * @param output The stream that error messages, warnings and summaries are printed to.
+ * @param memory_words The number of words of the machine memory.
+ * @return TRUE if the initialization was successful, FALSE if memory allocation failed.
+ */
+Boolean init_workspace(AsmWorkspace *workspace, FILE *output, int memory_words) {
+    init_context(&workspace->ctx, output);
+    init_line_buffer(&workspace->am_lines);
+    clear_batch_summary(&workspace->batch);
+
+    if (init_macr_trie(&workspace->macro_trie) == FALSE) {
+        free_context(&workspace->ctx);
+        return FALSE;
+    }
+    if (init_cmp_data(&workspace->cmp_data, memory_words) != NO_ERROR) {
+        free_macr_trie(&workspace->macro_trie);
+        free_context(&workspace->ctx);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/**
+ * Resets the workspace for the assembly of the next file. Only the memory that the last
+ * file used is cleared - the allocated memory and the totals of the batch are kept.
+ *
+ * @param workspace Pointer to the workspace to be reset.
+ */
+void reset_workspace(AsmWorkspace *workspace) {
+    reset_context(&workspace->ctx);
+    reset_macr_trie(&workspace->macro_trie);
+    reset_line_buffer(&workspace->am_lines);
+    reset_cmp_data(&workspace->cmp_data);
+}
+
+/**
+ * Frees all the memory of the workspace.
+ *
+ * @param workspace Pointer to the workspace to be freed.
+ */
+void free_workspace(AsmWorkspace *workspace) {
+    free_cmp_data(&workspace->cmp_data);
+    free_line_buffer(&workspace->am_lines);
+    free_macr_trie(&workspace->macro_trie);
+    free_context(&workspace->ctx);
+}
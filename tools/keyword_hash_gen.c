@@ -0,0 +1,137 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../structures/headers/mapping_tables.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Number of seeds to try before giving up */
+#define MAX_SEEDS 1000000UL
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static int collect_keywords(Keyword keywords[]);
+static Boolean build_table(unsigned long seed, const Keyword keywords[], int count, Keyword table[]);
+static void print_header(unsigned long seed, const Keyword table[]);
+/* ---------------------------------------------------------------------------------------
+ *                                      Main Function
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Generates the keyword hash header (keyword_hash.h) from the mapping tables, and prints it
+ * to the standard output. The generator searches for the first seed of `keyword_hash` with
+ * which every reserved word gets its own entry of the table - a perfect hash.
+ *
+ * @return EXIT_SUCCESS if a perfect hash was found, EXIT_FAILURE otherwise.
+ */
+int main(void) {
+    Keyword keywords[KEYWORD_HASH_SIZE]; /* All the reserved words */
+    Keyword table[KEYWORD_HASH_SIZE];    /* The entries of the hash table */
+    unsigned long seed;                  /* The current seed */
+    int count = collect_keywords(keywords);
+
+    if (count < 0) {
+        fprintf(stderr, "keyword_hash_gen: more keywords than entries (%d)\n", KEYWORD_HASH_SIZE);
+        return EXIT_FAILURE;
+    }
+
+    for (seed = 1; seed <= MAX_SEEDS; seed++) {
+        if (build_table(seed, keywords, count, table) == TRUE) {
+            print_header(seed, table);
+            return EXIT_SUCCESS;
+        }
+    }
+
+    fprintf(stderr, "keyword_hash_gen: no perfect hash found, increase KEYWORD_HASH_SIZE\n");
+    return EXIT_FAILURE;
+}
+
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Collects all the reserved words of the mapping tables.
+ *
+ * @param keywords The array to store the words in.
+ * @return The number of words, or -1 if there are more words than entries in the hash table.
+ */
+static int collect_keywords(Keyword keywords[]) {
+    int count = 0;
+    short i;
+
+    for (i = 0; instruct_table[i].command_str[0] != '\0'; i++, count++) {
+        if (count >= KEYWORD_HASH_SIZE) return -1;
+        keywords[count].type = KEYWORD_INSTRUCTION;
+        keywords[count].index = i;
+    }
+    for (i = 0; directive_table[i].command_str[0] != '\0'; i++, count++) {
+        if (count >= KEYWORD_HASH_SIZE) return -1;
+        keywords[count].type = KEYWORD_DIRECTIVE;
+        keywords[count].index = i;
+    }
+    for (i = 0; registers[i] != NULL; i++, count++) {
+        if (count >= KEYWORD_HASH_SIZE) return -1;
+        keywords[count].type = KEYWORD_REGISTER;
+        keywords[count].index = i;
+    }
+    for (i = 0; macr_reserved_table[i].command_str[0] != '\0'; i++, count++) {
+        if (count >= KEYWORD_HASH_SIZE) return -1;
+        keywords[count].type = KEYWORD_MACRO;
+        keywords[count].index = i;
+    }
+    return count;
+}
+
+/**
+ * Places the reserved words in the hash table with the specified seed.
+ *
+ * @param seed The seed of the hash.
+ * @param keywords The reserved words.
+ * @param count The number of reserved words.
+ * @param table The entries of the hash table to fill.
+ * @return TRUE if every word got its own entry, FALSE if two words collided.
+ */
+static Boolean build_table(unsigned long seed, const Keyword keywords[], int count, Keyword table[]) {
+    const char *name;
+    int i, entry;
+
+    for (i = 0; i < KEYWORD_HASH_SIZE; i++) {
+        table[i].type = KEYWORD_NONE;
+        table[i].index = -1;
+    }
+
+    for (i = 0; i < count; i++) {
+        name = keyword_name(keywords[i]);
+        entry = keyword_hash(seed, name, strlen(name));
+        if (table[entry].type != KEYWORD_NONE) return FALSE; /* Collision */
+        table[entry] = keywords[i];
+    }
+    return TRUE;
+}
+
+/**
+ * Prints the keyword hash header.
+ *
+ * @param seed The seed of the perfect hash.
+ * @param table The entries of the hash table.
+ */
+static void print_header(unsigned long seed, const Keyword table[]) {
+    static const char *type_names[] = {
+            "KEYWORD_NONE", "KEYWORD_INSTRUCTION", "KEYWORD_DIRECTIVE", "KEYWORD_REGISTER", "KEYWORD_MACRO"
+    };
+    int i;
+
+    printf("/* Generated by tools/keyword_hash_gen from structures/sources/mapping_tables.c - do not edit */\n");
+    printf("#ifndef KEYWORD_HASH_H\n#define KEYWORD_HASH_H\n\n");
+    printf("/* Seed of keyword_hash with which every reserved word has its own entry */\n");
+    printf("#define KEYWORD_HASH_SEED %luUL\n\n", seed);
+    printf("/* The reserved word of every entry of the hash table */\n");
+    printf("static const Keyword keyword_hash_table[KEYWORD_HASH_SIZE] = {\n");
+    for (i = 0; i < KEYWORD_HASH_SIZE; i++) {
+        printf("        {%s, %d}%s /* %s */\n", type_names[table[i].type], table[i].index,
+               i < KEYWORD_HASH_SIZE - 1 ? "," : " ", keyword_name(table[i]));
+    }
+    printf("};\n\n#endif /* KEYWORD_HASH_H */\n");
+}
@@ -0,0 +1,25 @@
+#ifndef CHAR_CLASS_H
+#define CHAR_CLASS_H
+/* ------------------------------------------ Defines ------------------------------------------*/
+/* Number of entries in the character class table - one for every value of a char */
+#define CHAR_COUNT 256
+
+/* Character classes - the bits of an entry in the character class table */
+#define CHAR_SPACE 0x01 /* Whitespace: space, tab, newline, carriage return, form feed, vertical tab */
+#define CHAR_COMMA 0x02 /* The operand separator ',' */
+#define CHAR_COLON 0x04 /* The label terminator ':' */
+#define CHAR_ALPHA 0x08 /* Uppercase and lowercase letters */
+#define CHAR_DIGIT 0x10 /* Decimal digits */
+#define CHAR_NAME  0x20 /* Characters of a symbol name: letters, digits, '-', '_' and '.' */
+#define CHAR_SIGN  0x40 /* Sign of an integer: '+' and '-' */
+#define CHAR_END   0x80 /* The null terminator */
+
+/* The classes of a character */
+#define CHAR_CLASS(c) (char_class[(unsigned char)(c)])
+/* Checks if a character belongs to any of the specified classes */
+#define IS_CHAR(c, classes) ((CHAR_CLASS(c) & (classes)) != 0)
+/* ----------------------------------------- Variables -----------------------------------------*/
+/* The classes of every character, indexed by the character as an unsigned char */
+extern const unsigned char char_class[CHAR_COUNT];
+
+#endif /* CHAR_CLASS_H */
@@ -0,0 +1,20 @@
+#ifndef CONTENT_HASH_H
+#define CONTENT_HASH_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include <stddef.h>
+/* ----------------------------------------- Defines ------------------------------------------*/
+/* Length of a digest - 32 hexadecimal digits (128 bits) and the null-terminator */
+#define CONTENT_HASH_LENGTH 33
+/* ----------------------------------- Functions Prototypes ---------------------------------- */
+/**
+ * Calculates the 128-bit hash of a content (MurmurHash3, x86 128-bit variant), and writes it
+ * as hexadecimal digits. The hash is not cryptographic - it tells contents apart, fast.
+ *
+ * @param data The content.
+ * @param size The size of the content in bytes.
+ * @param seed The seed of the hash - different seeds give unrelated hashes of the same content.
+ * @param digest Buffer to store the hexadecimal digest, terminated by '\0'.
+ */
+void hash_content(const char *data, size_t size, unsigned long seed, char digest[CONTENT_HASH_LENGTH]);
+
+#endif /* CONTENT_HASH_H */
@@ -0,0 +1,80 @@
+#ifndef FILE_LIST_H
+#define FILE_LIST_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include <stddef.h>
+#include "../../structures/headers/errors.h"
+/* ---------------------------------------- Structures ----------------------------------------*/
+/*
+ * FileList struct
+ * A growing list of the base names of the files to assemble, collected from the command line,
+ * a manifest file and source directories. Every name is a copy owned by the list.
+ */
+typedef struct FileList {
+    char **names;  /* The base names of the files, without the .as extension */
+    int count;     /* Number of names */
+    int capacity;  /* Number of allocated names */
+} FileList;
+
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Initializes an empty file list.
+ *
+ * @param list Pointer to the list to be initialized.
+ */
+void init_file_list(FileList *list);
+
+/**
+ * Adds a copy of a base name to the list.
+ *
+ * @param list Pointer to the list.
+ * @param name The base name - not necessarily null-terminated.
+ * @param length The number of characters of the name.
+ * @return TRUE if the name was added, FALSE if memory allocation failed.
+ */
+Boolean add_file_name(FileList *list, const char *name, size_t length);
+
+/**
+ * Adds the base names of a manifest file - one name per line. Spaces around a name and empty
+ * lines are ignored.
+ *
+ * @param list Pointer to the list.
+ * @param manifest The name of the manifest file.
+ * @return NO_ERROR if the names were added, FAILED_OPEN_FILE or MEMORY_ALLOCATION_ERROR otherwise.
+ */
+ErrorCode read_manifest(FileList *list, const char *manifest);
+
+/**
+ * Adds the base names of all the source files (.as) under a directory, and its subdirectories.
+ * Symbolic links to directories are not followed.
+ *
+ * @param list Pointer to the list.
+ * @param directory The path of the directory.
+ * @return NO_ERROR if the names were added, FAILED_OPEN_FILE or MEMORY_ALLOCATION_ERROR otherwise.
+ */
+ErrorCode scan_directory(FileList *list, const char *directory);
+
+/**
+ * Sorts the list from the largest source file (.as) to the smallest, so one big file is not
+ * left alone at the end of a batch. Files of the same size are sorted by name.
+ *
+ * @param list Pointer to the list.
+ * @return TRUE if the list was sorted, FALSE if memory allocation failed (the list is unchanged).
+ */
+Boolean sort_by_size(FileList *list);
+
+/**
+ * Retrieves the size of the source file (.as) of the specified file.
+ *
+ * @param file_name The base name of the file.
+ * @return The size of the source file in bytes, or 0 if the size is not available.
+ */
+long source_size(const char *file_name);
+
+/**
+ * Frees the names of the list, leaving it empty.
+ *
+ * @param list Pointer to the list to be freed.
+ */
+void free_file_list(FileList *list);
+
+#endif /* FILE_LIST_H */
@@ -0,0 +1,37 @@
+#ifndef FRAMES_H
+#define FRAMES_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include <stdio.h>
+#include <stddef.h>
+#include "boolean.h"
+/* ----------------------------------------- Defines ------------------------------------------*/
+/* Maximal length of the tag of a frame, including the null-terminator */
+#define FRAME_TAG_LENGTH 16
+/* ----------------------------------- Functions Prototypes ---------------------------------- */
+/**
+ * Writes a frame to the specified stream. A frame is a header line of a tag and the size
+ * of the data in bytes ("TAG SIZE\n"), followed by the data itself - so any content, including
+ * new lines and null characters, can be sent.
+ *
+ * @param stream The stream to write to.
+ * @param tag The tag of the frame - a single word.
+ * @param data The data of the frame (may be NULL if the size is 0).
+ * @param size The size of the data in bytes.
+ * @return TRUE if the frame was written, FALSE otherwise.
+ */
+Boolean write_frame(FILE *stream, const char *tag, const char *data, size_t size);
+
+/**
+ * Reads a frame from the specified stream.
+ *
+ * @param stream The stream to read from.
+ * @param tag Buffer to store the tag of the frame.
+ * @param data Pointer to store the data of the frame, terminated by '\0' (should be freed).
+ * @param size Pointer to store the size of the data in bytes.
+ * @param max_size The largest size of data that is accepted.
+ * @return TRUE if a frame was read, FALSE at the end of the stream, or if the frame is invalid,
+ *         too large or memory allocation failed.
+ */
+Boolean read_frame(FILE *stream, char tag[FRAME_TAG_LENGTH], char **data, size_t *size, size_t max_size);
+
+#endif /* FRAMES_H */
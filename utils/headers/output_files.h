@@ -5,26 +5,68 @@
 #include "../../structures/headers/cmp_data.h"
 /* ----------------------------------- Functions Prototypes ---------------------------------- */
 /**
- * Write a label and its associated address to the specified file in fixed positions.
- * The label is left-justified and can be up to 31 characters.
- * The address is right-justified and always 4 digits.
+ * Creates the entry or extern file with the specified name and writes the lines to it with a
+ * single `write` call. No file is created if there are no lines.
  *
- * @param label The label to be written (maximum 30 characters).
- * @param address The address associated with the label (4 digits).
- * @param file The file to which the label and address should be written.
+ * @param file_name The name of the file.
+ * @param records The entry or extern lines.
+ * @return NO_ERROR if the file was written or not needed, an error code of `write_content` otherwise.
  */
-void write_label(const char* label, int address, FILE* file);
+ErrorCode write_records(const char *file_name, const RecordBuffer *records);
 
 /**
  * Print the memory images to the specified output file in octal format.
  * This function prints the counts of code and data images, followed by each line
  * of the code and data images formatted in octal. The addresses are incremented from
- * a starting point, and each line is converted from its original format to octal for
- * output.
+ * a starting point. The content is formatted into one buffer and written with a single call.
  *
  * @param output_file The file to which the memory images should be written.
  * @param data A pointer to the CmpData structure containing the image and data images.
+ * @return TRUE if the memory images were written, FALSE if memory allocation failed.
  */
-void print_memory_images(FILE *output_file, CmpData *data);
+Boolean print_memory_images(FILE *output_file, CmpData *data);
 
-#endif /* OUTPUT_FILES_H */
+/**
+ * Creates the object file with the specified name and writes the memory images to it,
+ * in the same format as `print_memory_images`, with a single `write` call.
+ *
+ * @param file_name The name of the object file.
+ * @param data A pointer to the CmpData structure containing the image and data images.
+ * @param size Pointer to store the size of the file in bytes.
+ * @return NO_ERROR if the file was written, MEMORY_ALLOCATION_ERROR or an error code of
+ *         `write_content` otherwise.
+ */
+ErrorCode write_memory_images(const char *file_name, CmpData *data, size_t *size);
+
+/**
+ * Creates the file with the specified name and writes the content to it, with as few `write`
+ * calls as the system allows (a single one in practice).
+ *
+ * @param file_name The name of the file.
+ * @param content The content of the file.
+ * @param size The size of the content in bytes.
+ * @return NO_ERROR if the file was written, FAILED_OPEN_FILE, FAILED_WRITE_FILE or
+ *         FAILED_CLOSE_FILE otherwise - a file that was not written whole is removed.
+ */
+ErrorCode write_content(const char *file_name, const char *content, size_t size);
+
+/**
+ * Removes the output file with the specified name, if it exists - so an output that the current
+ * assembly does not create is not left from a previous one.
+ *
+ * @param file_name The name of the file.
+ * @return NO_ERROR if the file was removed or does not exist, FAILED_DELETE_FILE otherwise.
+ */
+ErrorCode remove_output_file(const char *file_name);
+
+/**
+ * Formats the memory images in octal format into a newly allocated buffer - the content of
+ * the object file. The digits are taken from lookup tables, as every word line has a fixed width.
+ *
+ * @param data A pointer to the CmpData structure containing the image and data images.
+ * @param size Pointer to store the size of the content in bytes.
+ * @return The formatted content (should be freed), or NULL if memory allocation failed.
+ */
+char *format_memory_images(CmpData *data, size_t *size);
+
+#endif /* OUTPUT_FILES_H */
\ No newline at end of file
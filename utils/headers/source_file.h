@@ -0,0 +1,51 @@
+#ifndef SOURCE_FILE_H
+#define SOURCE_FILE_H
+/* ----------------------------------------- Includes -----------------------------------------*/
+#include <stddef.h>
+#include "../../structures/headers/errors.h"
+/* ---------------------------------------- Structures ----------------------------------------*/
+/*
+ * SourceFile struct
+ * The whole content of a source file, read with a single call. The content is mapped into
+ * memory when possible, and read into one allocated block otherwise. It is read-only, and
+ * its lines are handed out as spans of it.
+ */
+typedef struct SourceFile {
+    const char *text;  /* The content of the file - not null-terminated */
+    size_t size;       /* The number of characters in the content */
+    void *mapping;     /* The mapped content, or NULL if the content was not mapped */
+    char *buffer;      /* The allocated content, or NULL if the content was mapped */
+} SourceFile;
+
+/* ----------------------------------- Functions Prototypes ------------------------------------*/
+/**
+ * Reads the whole content of the specified file. The content of a regular file is mapped into
+ * memory, or read into a single block if the file cannot be mapped. Other files - pipes and
+ * devices - are read into a block until their end.
+ *
+ * @param file_name The name of the file to read.
+ * @param source Pointer to the structure that receives the content.
+ * @return NO_ERROR if the file was read, FAILED_OPEN_FILE or MEMORY_ALLOCATION_ERROR otherwise.
+ */
+ErrorCode open_source_file(const char *file_name, SourceFile *source);
+
+/**
+ * Retrieves the next line of a content, as a span of it. The line ends after its '\n', or at
+ * the end of the content. Start with a position of 0 to iterate the lines from the first one.
+ *
+ * @param text The content.
+ * @param size The number of characters in the content.
+ * @param pos Pointer to the position of the next line, updated by the function.
+ * @param length Pointer to store the number of characters in the line, including its '\n'.
+ * @return The first character of the line, or NULL if there are no more lines.
+ */
+const char *next_source_line(const char *text, size_t size, size_t *pos, size_t *length);
+
+/**
+ * Releases the content of a source file, leaving it empty.
+ *
+ * @param source Pointer to the source file.
+ */
+void close_source_file(SourceFile *source);
+
+#endif /* SOURCE_FILE_H */
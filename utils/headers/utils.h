@@ -77,6 +77,17 @@ Boolean create_new_file_name(const char* original_filename, char** new_filename
  */
 Boolean is_valid_integer(const char *str);
 
+/**
+ * Converts a span of characters to an integer. The span is valid by the rules of `is_valid_integer`:
+ * it is not empty, and it is made of digits with an optional leading '+' or '-' sign.
+ *
+ * @param str The start of the span.
+ * @param length The number of characters in the span.
+ * @param value Pointer to store the integer, if the span is valid.
+ * @return TRUE if the span is a valid integer, FALSE otherwise.
+ */
+Boolean span_to_integer(const char *str, size_t length, int *value);
+
 /**
  * Validates if a given integer is within the allowed range in the program.
  *
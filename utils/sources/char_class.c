@@ -0,0 +1,39 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include "../headers/char_class.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Short names of the classes, for the layout of the table */
+#define E  CHAR_END
+#define S  CHAR_SPACE
+#define C  CHAR_COMMA
+#define L  CHAR_COLON
+#define N  CHAR_NAME
+#define G  CHAR_SIGN
+#define AN (CHAR_ALPHA | CHAR_NAME)
+#define DN (CHAR_DIGIT | CHAR_NAME)
+#define NG (CHAR_NAME | CHAR_SIGN)
+/* ---------------------------------------------------------------------------------------
+ *                                     Character Classes
+ * --------------------------------------------------------------------------------------- */
+/* The classes of every character, 16 characters in a row */
+const unsigned char char_class[CHAR_COUNT] = {
+         E,  0,  0,  0,  0,  0,  0,  0,  0,  S,  S,  S,  S,  S,  0,  0, /* 0x00 - 0x0F */
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0x10 - 0x1F */
+         S,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  G,  C, NG,  N,  0, /* 0x20 - 0x2F */
+        DN, DN, DN, DN, DN, DN, DN, DN, DN, DN,  L,  0,  0,  0,  0,  0, /* 0x30 - 0x3F */
+         0, AN, AN, AN, AN, AN, AN, AN, AN, AN, AN, AN, AN, AN, AN, AN, /* 0x40 - 0x4F */
+        AN, AN, AN, AN, AN, AN, AN, AN, AN, AN, AN,  0,  0,  0,  0,  N, /* 0x50 - 0x5F */
+         0, AN, AN, AN, AN, AN, AN, AN, AN, AN, AN, AN, AN, AN, AN, AN, /* 0x60 - 0x6F */
+        AN, AN, AN, AN, AN, AN, AN, AN, AN, AN, AN,  0,  0,  0,  0,  0, /* 0x70 - 0x7F */
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0x80 - 0x8F */
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0x90 - 0x9F */
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0xA0 - 0xAF */
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0xB0 - 0xBF */
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0xC0 - 0xCF */
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0xD0 - 0xDF */
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0xE0 - 0xEF */
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0  /* 0xF0 - 0xFF */
+};
@@ -0,0 +1,134 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include <stdio.h>
+#include "../headers/content_hash.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* The hash works on 32-bit words - every result is reduced to 32 bits */
+#define MASK_32 0xFFFFFFFFUL
+/* Number of bytes of a block - four 32-bit lanes */
+#define BLOCK_SIZE 16
+/* ---------------------------------------------------------------------------------------
+ *                                         Variables
+ * --------------------------------------------------------------------------------------- */
+/* The multipliers of the lanes */
+static const unsigned long lane_constants[4] = {0x239b961bUL, 0xab0e9789UL, 0x38b34ae5UL, 0xa1e38b93UL};
+/* The rotations of the lane inputs */
+static const int key_rotations[4] = {15, 16, 17, 18};
+/* The rotations and additions of the lane states */
+static const int state_rotations[4] = {19, 17, 15, 13};
+static const unsigned long state_additions[4] = {0x561ccd1bUL, 0x0bcaa747UL, 0x96cd1c35UL, 0x32ac3b17UL};
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static unsigned long rotate_left(unsigned long value, int bits);
+static unsigned long mix_key(unsigned long key, int lane);
+static unsigned long final_mix(unsigned long value);
+static unsigned long read_word(const unsigned char *bytes);
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Calculates the 128-bit hash of a content (MurmurHash3, x86 128-bit variant), and writes it
+ * as hexadecimal digits. The words of the content are read as little-endian, so the digest is
+ * the same on every machine.
+ *
+ * @param data The content.
+ * @param size The size of the content in bytes.
+ * @param seed The seed of the hash - different seeds give unrelated hashes of the same content.
+ * @param digest Buffer to store the hexadecimal digest, terminated by '\0'.
+ */
+void hash_content(const char *data, size_t size, unsigned long seed, char digest[CONTENT_HASH_LENGTH]) {
+    const unsigned char *bytes = (const unsigned char *)data; /* The content as bytes */
+    size_t blocks = size / BLOCK_SIZE;                        /* Number of whole blocks */
+    size_t tail = size % BLOCK_SIZE;                          /* Number of bytes after the blocks */
+    unsigned long state[4];                                   /* The state of the lanes */
+    unsigned long keys[4];                                    /* The words of the last bytes */
+    size_t block;
+    int lane;
+
+    for (lane = 0; lane < 4; lane++) state[lane] = seed & MASK_32;
+
+    /* ---------------------------------- The whole blocks ---------------------------------- */
+    for (block = 0; block < blocks; block++, bytes += BLOCK_SIZE) {
+        for (lane = 0; lane < 4; lane++) {
+            state[lane] ^= mix_key(read_word(bytes + 4 * lane), lane);
+            state[lane] = rotate_left(state[lane], state_rotations[lane]);
+            state[lane] = (state[lane] + state[(lane + 1) % 4]) & MASK_32;
+            state[lane] = (state[lane] * 5 + state_additions[lane]) & MASK_32;
+        }
+    }
+
+    /* ------------------------------------ The last bytes ----------------------------------- */
+    for (lane = 0; lane < 4; lane++) keys[lane] = 0;
+    while (tail > 0) {
+        tail--;
+        keys[tail / 4] |= (unsigned long)bytes[tail] << (8 * (tail % 4));
+    }
+    for (lane = 0; lane < 4; lane++) {
+        if (size % BLOCK_SIZE > (size_t)(4 * lane)) state[lane] ^= mix_key(keys[lane], lane);
+    }
+
+    /* ------------------------------------- Finalization ------------------------------------ */
+    for (lane = 0; lane < 4; lane++) state[lane] ^= (unsigned long)size & MASK_32;
+    state[0] = (state[0] + state[1] + state[2] + state[3]) & MASK_32;
+    for (lane = 1; lane < 4; lane++) state[lane] = (state[lane] + state[0]) & MASK_32;
+    for (lane = 0; lane < 4; lane++) state[lane] = final_mix(state[lane]);
+    state[0] = (state[0] + state[1] + state[2] + state[3]) & MASK_32;
+    for (lane = 1; lane < 4; lane++) state[lane] = (state[lane] + state[0]) & MASK_32;
+
+    sprintf(digest, "%08lx%08lx%08lx%08lx", state[3], state[2], state[1], state[0]);
+}
+
+/**
+ * Static function - rotates a 32-bit word to the left.
+ *
+ * @param value The word.
+ * @param bits The number of bits to rotate by (1 to 31).
+ * @return The rotated word.
+ */
+static unsigned long rotate_left(unsigned long value, int bits) {
+    value &= MASK_32;
+    return ((value << bits) | (value >> (32 - bits))) & MASK_32;
+}
+
+/**
+ * Static function - mixes a word of the content before it enters the state of its lane.
+ *
+ * @param key The word of the content.
+ * @param lane The lane of the word (0 to 3).
+ * @return The mixed word.
+ */
+static unsigned long mix_key(unsigned long key, int lane) {
+    key = (key * lane_constants[lane]) & MASK_32;
+    key = rotate_left(key, key_rotations[lane]);
+    return (key * lane_constants[(lane + 1) % 4]) & MASK_32;
+}
+
+/**
+ * Static function - the final avalanche of a lane, so every bit of the input affects every bit
+ * of the lane.
+ *
+ * @param value The state of the lane.
+ * @return The mixed state.
+ */
+static unsigned long final_mix(unsigned long value) {
+    value ^= value >> 16;
+    value = (value * 0x85ebca6bUL) & MASK_32;
+    value ^= value >> 13;
+    value = (value * 0xc2b2ae35UL) & MASK_32;
+    return value ^ (value >> 16);
+}
+
+/**
+ * Static function - reads a little-endian 32-bit word.
+ *
+ * @param bytes The four bytes of the word.
+ * @return The word.
+ */
+static unsigned long read_word(const unsigned char *bytes) {
+    return (unsigned long)bytes[0] | ((unsigned long)bytes[1] << 8) | ((unsigned long)bytes[2] << 16) |
+           ((unsigned long)bytes[3] << 24);
+}
@@ -0,0 +1,245 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "../headers/file_list.h"
+#include "../headers/source_file.h"
+#include "../headers/utils.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Number of names of a new list */
+#define INITIAL_LIST_CAPACITY 16
+/* The extension of a source file */
+#define SOURCE_EXTENSION ".as"
+#define SOURCE_EXTENSION_LENGTH 3
+/* ---------------------------------------------------------------------------------------
+ *                                         Structures
+ * --------------------------------------------------------------------------------------- */
+/* Structure representing a name of the list while it is sorted */
+typedef struct {
+    char *name;  /* The base name */
+    long size;   /* The size of its source file */
+    int index;   /* Its position in the list before sorting */
+} SortedName;
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static Boolean is_source_name(const char *name);
+static int compare_names(const void *first, const void *second);
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Initializes an empty file list.
+ *
+ * @param list Pointer to the list to be initialized.
+ */
+void init_file_list(FileList *list) {
+    list->names = NULL;
+    list->count = 0;
+    list->capacity = 0;
+}
+
+/**
+ * Adds a copy of a base name to the list, growing the list when it is full.
+ *
+ * @param list Pointer to the list.
+ * @param name The base name - not necessarily null-terminated.
+ * @param length The number of characters of the name.
+ * @return TRUE if the name was added, FALSE if memory allocation failed.
+ */
+Boolean add_file_name(FileList *list, const char *name, size_t length) {
+    char **names;  /* The grown list of names */
+    char *copy;    /* The copy of the name */
+    int capacity;  /* The new capacity */
+
+    if (list->count == list->capacity) {
+        capacity = list->capacity ? list->capacity * 2 : INITIAL_LIST_CAPACITY;
+        if (!(names = (char **)realloc(list->names, capacity * sizeof(char *)))) return FALSE;
+        list->names = names;
+        list->capacity = capacity;
+    }
+    if (!(copy = my_strndup(name, length))) return FALSE;
+    list->names[list->count++] = copy;
+    return TRUE;
+}
+
+/**
+ * Adds the base names of a manifest file - one name per line. Spaces around a name and empty
+ * lines are ignored.
+ *
+ * @param list Pointer to the list.
+ * @param manifest The name of the manifest file.
+ * @return NO_ERROR if the names were added, FAILED_OPEN_FILE or MEMORY_ALLOCATION_ERROR otherwise.
+ */
+ErrorCode read_manifest(FileList *list, const char *manifest) {
+    SourceFile source;  /* The content of the manifest */
+    const char *line;   /* The current line */
+    size_t pos = 0;     /* The position of the next line */
+    size_t length;      /* The length of the current line */
+    ErrorCode result;
+
+    if ((result = open_source_file(manifest, &source)) != NO_ERROR) return result;
+
+    while ((line = next_source_line(source.text, source.size, &pos, &length)) != NULL) {
+        /* Trim the spaces and the line ending */
+        while (length > 0 && is_space(*line)) {
+            line++;
+            length--;
+        }
+        while (length > 0 && (is_space(line[length - 1]) || line[length - 1] == '\n' ||
+                              line[length - 1] == '\r')) {
+            length--;
+        }
+        if (length > 0 && add_file_name(list, line, length) == FALSE) {
+            result = MEMORY_ALLOCATION_ERROR;
+            break;
+        }
+    }
+
+    close_source_file(&source);
+    return result;
+}
+
+/**
+ * Adds the base names of all the source files (.as) under a directory, and its subdirectories.
+ * Every name is the path of the source file without its extension.
+ *
+ * @param list Pointer to the list.
+ * @param directory The path of the directory.
+ * @return NO_ERROR if the names were added, FAILED_OPEN_FILE or MEMORY_ALLOCATION_ERROR otherwise.
+ */
+ErrorCode scan_directory(FileList *list, const char *directory) {
+    DIR *dir;                   /* The open directory */
+    struct dirent *entry;       /* The current entry */
+    struct stat info;           /* The attributes of the entry - lstat, so links are not followed */
+    size_t dir_length = strlen(directory);
+    char *path;                 /* The path of the entry */
+    ErrorCode result = NO_ERROR;
+
+    if (!(dir = opendir(directory))) return FAILED_OPEN_FILE;
+
+    /* The separator is not doubled when the directory already ends with one */
+    while (dir_length > 1 && directory[dir_length - 1] == '/') dir_length--;
+
+    while (result == NO_ERROR && (entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+
+        if (!(path = (char *)malloc(dir_length + strlen(entry->d_name) + 2))) {
+            result = MEMORY_ALLOCATION_ERROR;
+            break;
+        }
+        sprintf(path, "%.*s/%s", (int)dir_length, directory, entry->d_name);
+
+        if (lstat(path, &info) == 0) {
+            if (S_ISDIR(info.st_mode)) {
+                /* A subdirectory that cannot be opened is skipped, like an unreadable entry */
+                if (scan_directory(list, path) == MEMORY_ALLOCATION_ERROR) result = MEMORY_ALLOCATION_ERROR;
+            } else if (S_ISREG(info.st_mode) && is_source_name(entry->d_name) == TRUE) {
+                if (add_file_name(list, path, strlen(path) - SOURCE_EXTENSION_LENGTH) == FALSE) {
+                    result = MEMORY_ALLOCATION_ERROR;
+                }
+            }
+        }
+        free(path);
+    }
+
+    closedir(dir);
+    return result;
+}
+
+/**
+ * Sorts the list from the largest source file (.as) to the smallest. Files of the same size
+ * are sorted by name, so the order does not depend on the order of a directory.
+ *
+ * @param list Pointer to the list.
+ * @return TRUE if the list was sorted, FALSE if memory allocation failed (the list is unchanged).
+ */
+Boolean sort_by_size(FileList *list) {
+    SortedName *sorted; /* The names with their sizes */
+    int i;
+
+    if (list->count < 2) return TRUE;
+    if (!(sorted = (SortedName *)malloc(list->count * sizeof(SortedName)))) return FALSE;
+
+    for (i = 0; i < list->count; i++) {
+        sorted[i].name = list->names[i];
+        sorted[i].size = source_size(list->names[i]);
+        sorted[i].index = i;
+    }
+    qsort(sorted, list->count, sizeof(SortedName), compare_names);
+    for (i = 0; i < list->count; i++) list->names[i] = sorted[i].name;
+
+    free(sorted);
+    return TRUE;
+}
+
+/**
+ * Retrieves the size of the source file (.as) of the specified file.
+ *
+ * @param file_name The base name of the file.
+ * @return The size of the source file in bytes, or 0 if the size is not available.
+ */
+long source_size(const char *file_name) {
+    char *source_filename = NULL; /* The source file name */
+    struct stat file_stat;        /* The source file attributes */
+    long size = 0;
+
+    if (create_new_file_name(file_name, &source_filename, SOURCE_EXTENSION)) {
+        if (stat(source_filename, &file_stat) == 0) size = (long)file_stat.st_size;
+        free(source_filename);
+    }
+    return size;
+}
+
+/**
+ * Frees the names of the list, leaving it empty.
+ *
+ * @param list Pointer to the list to be freed.
+ */
+void free_file_list(FileList *list) {
+    int i;
+
+    for (i = 0; i < list->count; i++) free(list->names[i]);
+    free(list->names);
+    init_file_list(list);
+}
+
+/**
+ * Static function - checks if the name of a directory entry is the name of a source file -
+ * a base name followed by the .as extension.
+ *
+ * @param name The name of the entry.
+ * @return TRUE if the name ends with the source extension, FALSE otherwise.
+ */
+static Boolean is_source_name(const char *name) {
+    size_t length = strlen(name);
+
+    return (length > SOURCE_EXTENSION_LENGTH &&
+            strcmp(name + length - SOURCE_EXTENSION_LENGTH, SOURCE_EXTENSION) == 0) ? TRUE : FALSE;
+}
+
+/**
+ * Static function - compares two names for sorting - larger source files first, ties are broken
+ * by the name, and then by the position in the list.
+ *
+ * @param first Pointer to the first name.
+ * @param second Pointer to the second name.
+ * @return Negative if the first name should come before the second, positive otherwise.
+ */
+static int compare_names(const void *first, const void *second) {
+    const SortedName *name1 = (const SortedName *)first;
+    const SortedName *name2 = (const SortedName *)second;
+    int order;
+
+    if (name1->size != name2->size) return name1->size > name2->size ? -1 : 1;
+    if ((order = strcmp(name1->name, name2->name)) != 0) return order;
+    return name1->index - name2->index;
+}
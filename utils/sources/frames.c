@@ -0,0 +1,64 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/frames.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Maximal length of the header line of a frame */
+#define FRAME_HEADER_LENGTH 64
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Writes a frame to the specified stream. A frame is a header line of a tag and the size
+ * of the data in bytes ("TAG SIZE\n"), followed by the data itself - so any content, including
+ * new lines and null characters, can be sent.
+ *
+ * @param stream The stream to write to.
+ * @param tag The tag of the frame - a single word.
+ * @param data The data of the frame (may be NULL if the size is 0).
+ * @param size The size of the data in bytes.
+ * @return TRUE if the frame was written, FALSE otherwise.
+ */
+Boolean write_frame(FILE *stream, const char *tag, const char *data, size_t size) {
+    if (fprintf(stream, "%s %lu\n", tag, (unsigned long)size) < 0) return FALSE;
+    if (size > 0 && fwrite(data, 1, size, stream) != size) return FALSE;
+    return TRUE;
+}
+
+/**
+ * Reads a frame from the specified stream. The header line is validated before the data is
+ * allocated, so a broken stream cannot request an unbounded allocation.
+ *
+ * @param stream The stream to read from.
+ * @param tag Buffer to store the tag of the frame.
+ * @param data Pointer to store the data of the frame, terminated by '\0' (should be freed).
+ * @param size Pointer to store the size of the data in bytes.
+ * @param max_size The largest size of data that is accepted.
+ * @return TRUE if a frame was read, FALSE at the end of the stream, or if the frame is invalid,
+ *         too large or memory allocation failed.
+ */
+Boolean read_frame(FILE *stream, char tag[FRAME_TAG_LENGTH], char **data, size_t *size, size_t max_size) {
+    char header[FRAME_HEADER_LENGTH];   /* The header line */
+    unsigned long length;               /* The size of the data */
+    char end;                           /* The character after the size - must be the new line */
+
+    *data = NULL;
+    if (!fgets(header, sizeof(header), stream)) return FALSE;
+    if (sscanf(header, "%15s %lu%c", tag, &length, &end) != 3 || end != '\n' || length > max_size) {
+        return FALSE;
+    }
+
+    if (!(*data = (char *)malloc((size_t)length + 1))) return FALSE;
+    if (length > 0 && fread(*data, 1, (size_t)length, stream) != (size_t)length) {
+        free(*data);
+        *data = NULL;
+        return FALSE;
+    }
+    (*data)[length] = '\0';
+    *size = (size_t)length;
+    return TRUE;
+}
@@ -1,50 +1,221 @@
 /* ---------------------------------------------------------------------------------------
  *                                          Includes
  * --------------------------------------------------------------------------------------- */
+#define _POSIX_C_SOURCE 200112L
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 #include "../headers/output_files.h"
 #include "../../assembler/headers/code_convert.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Length of a word line in the object file: "AAAA   OOOOO\n" */
+#define WORD_LINE_LENGTH 13
+/* First address that is printed with 5 digits */
+#define WIDE_ADDRESS 10000
+/* Maximum length of the counts line in the object file */
+#define HEADER_LINE_LENGTH 32
+
+/* All the pairs of decimal digits, "00" to "99" */
+#define DECIMAL_PAIRS \
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839" \
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879" \
+    "8081828384858687888990919293949596979899"
+
+/* All the pairs of octal digits, "00" to "77" */
+#define OCTAL_PAIRS \
+    "0001020304050607101112131415161720212223242526273031323334353637" \
+    "4041424344454647505152535455565760616263646566677071727374757677"
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static char *format_word_line(char *pos, int address, Word word);
 /* ---------------------------------------------------------------------------------------
  *                                       Functions
  * --------------------------------------------------------------------------------------- */
 /**
- * Write a label and its associated address to the specified file in fixed positions.
- * The label is left-justified and can be up to 31 characters.
- * The address is right-justified and always 4 digits.
+ * Creates the entry or extern file with the specified name and writes the lines to it with a
+ * single `write` call. No file is created if there are no lines.
  *
- * @param label The label to be written (maximum 30 characters).
- * @param address The address associated with the label (4 digits).
- * @param file The file to which the label and address should be written.
+ * @param file_name The name of the file.
+ * @param records The entry or extern lines.
+ * @return NO_ERROR if the file was written or not needed, an error code of `write_content` otherwise.
  */
-void write_label(const char* label, int address, FILE* file) {
-    fprintf(file, "%-31s %04d\n", label, address);
+ErrorCode write_records(const char *file_name, const RecordBuffer *records) {
+    if (records->size == 0) return NO_ERROR;
+    return write_content(file_name, records->text, records->size);
 }
 
 /**
  * Print the memory images to the specified output file in octal format.
- * This function prints the counts of code and data images, followed by each line
- * of the code and data images formatted in octal. The addresses are incremented from
- * a starting point, and each line is converted from its original format to octal for
- * output.
+ * The whole content is formatted into one buffer with the method 'format_memory_images'
+ * and written with a single call.
  *
  * @param output_file The file to which the memory images should be written.
  * @param data A pointer to the CmpData structure containing the image and data images.
+ * @return TRUE if the memory images were written, FALSE if memory allocation failed.
+ */
+Boolean print_memory_images(FILE *output_file, CmpData *data) {
+    size_t size;                                   /* Size of the formatted content */
+    char *content = format_memory_images(data, &size); /* The formatted content */
+
+    if (!content) return FALSE;
+
+    fwrite(content, 1, size, output_file);
+    free(content);
+    return TRUE;
+}
+
+/**
+ * Creates the object file with the specified name and writes the memory images to it.
+ * The whole content is formatted into one buffer and written with a single `write` call
+ * (repeated only if the system writes part of it).
+ *
+ * @param file_name The name of the object file.
+ * @param data A pointer to the CmpData structure containing the image and data images.
+ * @param size Pointer to store the size of the file in bytes.
+ * @return NO_ERROR if the file was written, MEMORY_ALLOCATION_ERROR or an error code of
+ *         `write_content` otherwise.
+ */
+ErrorCode write_memory_images(const char *file_name, CmpData *data, size_t *size) {
+    char *content;                  /* The formatted content */
+    ErrorCode status;               /* Status of writing the file */
+
+    /* Format first - no empty file is left behind if memory allocation fails */
+    if (!(content = format_memory_images(data, size))) return MEMORY_ALLOCATION_ERROR;
+
+    status = write_content(file_name, content, *size);
+    free(content);
+    return status;
+}
+
+/**
+ * Creates the file with the specified name and writes the content to it, with as few `write`
+ * calls as the system allows (a single one in practice).
+ *
+ * @param file_name The name of the file.
+ * @param content The content of the file.
+ * @param size The size of the content in bytes.
+ * @return NO_ERROR if the file was written, FAILED_OPEN_FILE, FAILED_WRITE_FILE or
+ *         FAILED_CLOSE_FILE otherwise - a file that was not written whole is removed.
+ */
+ErrorCode write_content(const char *file_name, const char *content, size_t size) {
+    size_t written = 0;             /* Number of bytes written so far */
+    ssize_t bytes;                  /* Number of bytes written by a single call */
+    int fd;                         /* Descriptor of the file */
+    struct stat info;               /* The type of the file */
+    ErrorCode status = NO_ERROR;    /* Status of writing the file */
+
+    if ((fd = open(file_name, O_WRONLY | O_CREAT | O_TRUNC, 0666)) == -1) return FAILED_OPEN_FILE;
+
+    while (written < size) {
+        bytes = write(fd, content + written, size - written);
+        if (bytes == -1 && errno == EINTR) continue;
+        if (bytes <= 0) break;
+        written += (size_t)bytes;
+    }
+    if (written < size) status = FAILED_WRITE_FILE;
+    if (close(fd) != 0 && status == NO_ERROR) status = FAILED_CLOSE_FILE;
+
+    /* A truncated file must not pass for an output - only a regular file is removed */
+    if (status != NO_ERROR && stat(file_name, &info) == 0 && S_ISREG(info.st_mode)) unlink(file_name);
+    return status;
+}
+
+/**
+ * Removes the output file with the specified name, if it exists - so an output that the current
+ * assembly does not create is not left from a previous one.
+ *
+ * @param file_name The name of the file.
+ * @return NO_ERROR if the file was removed or does not exist, FAILED_DELETE_FILE otherwise.
+ */
+ErrorCode remove_output_file(const char *file_name) {
+    if (unlink(file_name) == 0 || errno == ENOENT) return NO_ERROR;
+    return FAILED_DELETE_FILE;
+}
+
+/**
+ * Formats the memory images in octal format into a newly allocated buffer.
+ * The buffer holds the counts of code and data images, followed by each word of the code
+ * and data images with its address. Every word line has a fixed width (one more character for
+ * 5-digit addresses), so the buffer is allocated once and the digits are taken from lookup tables.
+ *
+ * @param data A pointer to the CmpData structure containing the image and data images.
+ * @param size Pointer to store the size of the content in bytes.
+ * @return The formatted content (should be freed), or NULL if memory allocation failed.
  */
-void print_memory_images(FILE *output_file, CmpData *data) {
-    int i; /* Variable to iterate through the memory images */
-    int data_addres = data->image.code_count+IC_START;
+char *format_memory_images(CmpData *data, size_t *size) {
+    int i;                                            /* Variable to iterate through loops */
+    int address = IC_START;                            /* Address of the current word */
+    int header_length;                                         /* Length of the counts line */
+    char *content, *pos;                        /* The content and the current writing position */
+    int words = data->image.code_count + data->image.data_count; /* Number of words to write */
+    size_t line_length = WORD_LINE_LENGTH + (IC_START + words > WIDE_ADDRESS ? 1 : 0); /* Longest line */
 
-    /* Print the data and code images counts */
-    fprintf(output_file,"%4d   %-5d\n", data->image.code_count, data->image.data_count);
+    if (!(content = (char *)malloc(HEADER_LINE_LENGTH + (size_t)words * line_length + 1))) {
+        return NULL;
+    }
+
+    /* The counts line is written once - no need for the tables */
+    header_length = sprintf(content, "%4d   %-5d\n", data->image.code_count, data->image.data_count);
+    pos = content + header_length;
 
-    /* Print code image */
+    /* Code image */
     for (i = 0; i < data->image.code_count; i++) {
-        fprintf(output_file, "%04d   %05o\n", IC_START + i, convert_to_octal(data->image.lines[i]));
+        pos = format_word_line(pos, address++, data->image.code[i]);
     }
 
-    /* Print data image */
-    for (i = MEMORY_CAPACITY-1 ; i >= MEMORY_CAPACITY-data->image.data_count; i--) {
-        fprintf(output_file, "%04d   %05o\n", data_addres, convert_to_octal(data->image.lines[i]));
-        data_addres++;
+    /* Data image */
+    for (i = 0; i < data->image.data_count; i++) {
+        pos = format_word_line(pos, address++, data->image.data[i]);
     }
+
+    *pos = '\0';
+    *size = (size_t)(pos - content);
+    return content;
 }
 
+/**
+ * Static function - formats one word line - a 4-digit address, 3 spaces, the 5 octal digits
+ * of the word and a newline. Equivalent to `"%04d   %05o\n"` - addresses from 10000 up get
+ * a fifth digit.
+ *
+ * @param pos The position to write the line at.
+ * @param address The address of the word.
+ * @param word The word to write.
+ * @return The position after the written line.
+ */
+static char *format_word_line(char *pos, int address, Word word) {
+    const char *digits; /* The digits of the current pair */
+
+    /* Fifth digit of a large memory */
+    if (address >= WIDE_ADDRESS) {
+        *pos++ = (char)('0' + address / WIDE_ADDRESS);
+        address %= WIDE_ADDRESS;
+    }
+
+    /* Address - two pairs of decimal digits */
+    digits = DECIMAL_PAIRS + 2 * ((address / 100) % 100);
+    pos[0] = digits[0];
+    pos[1] = digits[1];
+    digits = DECIMAL_PAIRS + 2 * (address % 100);
+    pos[2] = digits[0];
+    pos[3] = digits[1];
+    pos[4] = pos[5] = pos[6] = ' ';
+
+    /* Word - one octal digit of the 3 highest bits and two pairs of the 12 lowest bits */
+    pos[7] = (char)('0' + ((word >> 12) & 07));
+    digits = OCTAL_PAIRS + 2 * ((word >> 6) & 077);
+    pos[8] = digits[0];
+    pos[9] = digits[1];
+    digits = OCTAL_PAIRS + 2 * (word & 077);
+    pos[10] = digits[0];
+    pos[11] = digits[1];
+    pos[12] = '\n';
+
+    return pos + WORD_LINE_LENGTH;
+}
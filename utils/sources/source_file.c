@@ -0,0 +1,146 @@
+/* ---------------------------------------------------------------------------------------
+ *                                          Includes
+ * --------------------------------------------------------------------------------------- */
+#define _POSIX_C_SOURCE 200112L
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "../headers/source_file.h"
+/* ---------------------------------------------------------------------------------------
+ *                                          Defines
+ * --------------------------------------------------------------------------------------- */
+/* Number of characters read at first from a file whose size is not known - a pipe or a device */
+#define STREAM_INITIAL_SIZE 4096
+/* ---------------------------------------------------------------------------------------
+ *                               Static Functions Prototypes
+ * --------------------------------------------------------------------------------------- */
+static ErrorCode read_source(int fd, size_t size, SourceFile *source);
+/* ---------------------------------------------------------------------------------------
+ *                                         Functions
+ * --------------------------------------------------------------------------------------- */
+/**
+ * Reads the whole content of the specified file. The content of a regular file is mapped into
+ * memory, or read into a single block if the file cannot be mapped. Other files - pipes and
+ * devices - have no size to map, and are read into a block until their end.
+ *
+ * @param file_name The name of the file to read.
+ * @param source Pointer to the structure that receives the content.
+ * @return NO_ERROR if the file was read, FAILED_OPEN_FILE or MEMORY_ALLOCATION_ERROR otherwise.
+ */
+ErrorCode open_source_file(const char *file_name, SourceFile *source) {
+    struct stat info;         /* The status of the file - its size */
+    ErrorCode result = NO_ERROR;
+    void *mapping;
+    int fd;
+
+    source->text = "";
+    source->size = 0;
+    source->mapping = NULL;
+    source->buffer = NULL;
+
+    if ((fd = open(file_name, O_RDONLY)) == -1) return FAILED_OPEN_FILE;
+    if (fstat(fd, &info) == -1) {
+        close(fd);
+        return FAILED_OPEN_FILE;
+    }
+
+    if (!S_ISREG(info.st_mode)) {
+        /* The size of the content is known only at its end */
+        result = read_source(fd, STREAM_INITIAL_SIZE, source);
+    } else if (info.st_size > 0) { /* An empty file has no content to map */
+        mapping = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            /* The lines are scanned once, from the first to the last */
+            posix_madvise(mapping, (size_t)info.st_size, POSIX_MADV_SEQUENTIAL);
+            source->mapping = mapping;
+            source->text = (const char *)mapping;
+            source->size = (size_t)info.st_size;
+        } else { /* The file cannot be mapped - read it */
+            result = read_source(fd, (size_t)info.st_size + 1, source); /* Room to see the end */
+        }
+    }
+
+    close(fd);
+    return result;
+}
+
+/**
+ * Retrieves the next line of a content, as a span of it. The line ends after its '\n', or at
+ * the end of the content. Start with a position of 0 to iterate the lines from the first one.
+ * The end of the line is found with `memchr`, which scans many characters at a time.
+ *
+ * @param text The content.
+ * @param size The number of characters in the content.
+ * @param pos Pointer to the position of the next line, updated by the function.
+ * @param length Pointer to store the number of characters in the line, including its '\n'.
+ * @return The first character of the line, or NULL if there are no more lines.
+ */
+const char *next_source_line(const char *text, size_t size, size_t *pos, size_t *length) {
+    const char *line = text + *pos; /* The first character of the line */
+    const char *newline;            /* The end of the line */
+
+    if (*pos >= size) return NULL; /* No more lines */
+
+    newline = (const char *)memchr(line, '\n', size - *pos);
+    *length = newline ? (size_t)(newline - line) + 1 : size - *pos;
+    *pos += *length;
+    return line;
+}
+
+/**
+ * Releases the content of a source file, leaving it empty.
+ *
+ * @param source Pointer to the source file.
+ */
+void close_source_file(SourceFile *source) {
+    if (source->mapping) munmap(source->mapping, source->size);
+    free(source->buffer);
+    source->text = "";
+    source->size = 0;
+    source->mapping = NULL;
+    source->buffer = NULL;
+}
+
+/**
+ * Static function - reads the content of an opened file into a single allocated block, until
+ * the end of the file. The block grows by doubling if the file is larger than expected.
+ *
+ * @param fd The descriptor of the file, opened for reading.
+ * @param size The expected size of the file.
+ * @param source Pointer to the structure that receives the content.
+ * @return NO_ERROR if the file was read, FAILED_OPEN_FILE or MEMORY_ALLOCATION_ERROR otherwise.
+ */
+static ErrorCode read_source(int fd, size_t size, SourceFile *source) {
+    char *buffer = (char *)malloc(size);
+    char *grown;
+    size_t total = 0;  /* Number of characters read so far */
+    ssize_t count;
+
+    if (!buffer) return MEMORY_ALLOCATION_ERROR;
+
+    /* A read may return less than requested - continue until the end of the file */
+    while ((count = read(fd, buffer + total, size - total)) > 0) {
+        total += (size_t)count;
+        if (total == size) {
+            if (!(grown = (char *)realloc(buffer, size * 2))) {
+                free(buffer);
+                return MEMORY_ALLOCATION_ERROR;
+            }
+            buffer = grown;
+            size *= 2;
+        }
+    }
+    if (count == -1) {
+        free(buffer);
+        return FAILED_OPEN_FILE;
+    }
+
+    source->buffer = buffer;
+    source->text = buffer;
+    source->size = total;
+    return NO_ERROR;
+}
@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include "../headers/boolean.h"
+#include "../headers/char_class.h"
 #include "../../assembler/headers/defines.h"
 /* ---------------------------------------------------------------------------------------
  *                                          Functions
@@ -20,7 +21,7 @@
  * @return Non-zero if the character is a whitespace character, zero otherwise.
  */
 int is_space(char c) {
-    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+    return IS_CHAR(c, CHAR_SPACE);
 }
 
 /**
@@ -175,6 +176,39 @@ Boolean is_valid_integer(const char *str) {
     return TRUE;
 }
 
+/**
+ * Converts a span of characters to an integer. The span is valid by the rules of `is_valid_integer`:
+ * it is not empty, and it is made of digits with an optional leading '+' or '-' sign.
+ *
+ * @param str The start of the span.
+ * @param length The number of characters in the span.
+ * @param value Pointer to store the integer, if the span is valid.
+ * @return TRUE if the span is a valid integer, FALSE otherwise.
+ */
+Boolean span_to_integer(const char *str, size_t length, int *value) {
+    int result = 0;
+    int sign = 1;
+    size_t i = 0;
+
+    if (length == 0) return FALSE; /* Empty span */
+
+    /* Handle optional sign */
+    if (IS_CHAR(str[0], CHAR_SIGN)) {
+        if (str[0] == '-') sign = -1;
+        i++;
+    }
+
+    /* Convert digits to integer */
+    for (; i < length; i++) {
+        if (!IS_CHAR(str[i], CHAR_DIGIT)) return FALSE;
+        result = result * 10 + (str[i] - '0');
+    }
+
+    /* Save the integer according to the specified sign */
+    *value = sign * result;
+    return TRUE;
+}
+
 /**
  * Validates if a given integer is within the allowed range in the program.
  *